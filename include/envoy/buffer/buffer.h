@@ -4,6 +4,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/api/os_sys_calls.h"
 #include "envoy/common/exception.h"
@@ -55,6 +56,107 @@ public:
   virtual void done() PURE;
 };
 
+/**
+ * An account charged for the bytes held by the buffers bound to it, such as the buffers of one
+ * connection.
+ */
+class BufferMemoryAccount;
+using BufferMemoryAccountSharedPtr = std::shared_ptr<BufferMemoryAccount>;
+
+class BufferMemoryAccount {
+public:
+  virtual ~BufferMemoryAccount() = default;
+
+  /**
+   * Charge the account for bytes added to a buffer bound to it.
+   * @param amount supplies the number of bytes.
+   */
+  virtual void charge(uint64_t amount) PURE;
+
+  /**
+   * Credit the account for bytes removed from a buffer bound to it.
+   * @param amount supplies the number of bytes.
+   */
+  virtual void credit(uint64_t amount) PURE;
+
+  /**
+   * @return uint64_t the number of bytes currently held by the buffers bound to the account.
+   */
+  virtual uint64_t balance() const PURE;
+
+  /**
+   * Stop resetting the account, e.g. once the owner of its buffers is closed. Buffers still bound
+   * to the account keep charging it until they are released.
+   */
+  virtual void clearResetCallback() PURE;
+
+  /**
+   * Create an account for a part of the buffers charged to this account, e.g. those of one stream
+   * of a connection. Bytes charged to the child account are charged to this account as well, so
+   * the child is only used to attribute this account's balance. Child accounts are never reset.
+   * @param description supplies a description of the owner of the child account's buffers.
+   * @return BufferMemoryAccountSharedPtr the new account.
+   */
+  virtual BufferMemoryAccountSharedPtr createChildAccount(std::string description) PURE;
+};
+
+/**
+ * The balance of an account at some point in time, for reporting.
+ */
+struct BufferMemoryAccountBalance {
+  std::string description_;
+  uint64_t balance_;
+  // The child accounts with the largest balances, largest first.
+  std::vector<BufferMemoryAccountBalance> children_;
+};
+
+/**
+ * Keeps track of the memory accounts of one thread, so that the buffered bytes of the thread can be
+ * attributed to their holders and the largest holders can be reset under memory pressure. Not
+ * thread safe: accounts must be created, charged and reset on the tracker's thread.
+ */
+class BufferMemoryTracker {
+public:
+  virtual ~BufferMemoryTracker() = default;
+
+  /**
+   * Create a new account.
+   * @param description supplies a description of the owner of the account's buffers, e.g. a
+   *        connection.
+   * @param reset_callback supplies the function called to release the memory charged to the
+   *        account, e.g. by closing the connection owning the buffers bound to it.
+   * @return BufferMemoryAccountSharedPtr the new account.
+   */
+  virtual BufferMemoryAccountSharedPtr createAccount(std::string description,
+                                                     std::function<void()> reset_callback) PURE;
+
+  /**
+   * @return uint64_t the number of bytes currently charged to all the accounts of the tracker.
+   */
+  virtual uint64_t balance() const PURE;
+
+  /**
+   * @param count supplies the maximum number of accounts to return.
+   * @return the balances of the accounts with the largest balances, largest first.
+   */
+  virtual std::vector<uint64_t> largestBalances(uint32_t count) const PURE;
+
+  /**
+   * @param count supplies the maximum number of accounts to return, and of child accounts to
+   *        return for each of them.
+   * @return the accounts with the largest balances and their largest children, largest first.
+   */
+  virtual std::vector<BufferMemoryAccountBalance> largestAccounts(uint32_t count) const PURE;
+
+  /**
+   * Call the reset callbacks of the accounts with the largest balances, largest first. Accounts
+   * with an empty balance or without a reset callback are not reset.
+   * @param count supplies the maximum number of accounts to reset.
+   * @return uint32_t the number of accounts reset.
+   */
+  virtual uint32_t resetLargestAccounts(uint32_t count) PURE;
+};
+
 /**
  * A basic buffer abstraction.
  */
@@ -207,6 +309,14 @@ public:
    */
   virtual Api::IoCallUint64Result write(Network::IoHandle& io_handle) PURE;
 
+  /**
+   * Bind the buffer to a memory account. The account is charged for the bytes currently in the
+   * buffer and from then on for every byte added to it, and credited as bytes leave the buffer.
+   * A previously bound account is credited with the bytes currently in the buffer.
+   * @param account supplies the account to bind to, or nullptr to unbind the buffer.
+   */
+  virtual void bindAccount(BufferMemoryAccountSharedPtr account) PURE;
+
   /**
    * Copy an integer out of the buffer.
    * @param start supplies the buffer index to start copying from.
@@ -212,6 +212,13 @@ public:
    */
   virtual Buffer::WatermarkFactory& getWatermarkFactory() PURE;
 
+  /**
+   * Returns the tracker of the memory accounts of the buffers used on this dispatcher, to which
+   * connections charge the bytes they buffer.
+   * @return the buffer memory tracker for this dispatcher.
+   */
+  virtual Buffer::BufferMemoryTracker& bufferMemoryTracker() PURE;
+
   /**
    * Sets a tracked object, which is currently operating in this Dispatcher.
    * This should be cleared with another call to setTrackedObject() when the object is done doing
@@ -272,6 +272,13 @@ public:
    */
   virtual bool aboveHighWatermark() const PURE;
 
+  /**
+   * @return the memory account charged for the data buffered by the connection, to which the
+   *         buffers of the streams carried by the connection can also be bound. Resetting the
+   *         account closes the connection. May be nullptr if the connection is not accounted.
+   */
+  virtual Buffer::BufferMemoryAccountSharedPtr bufferMemoryAccount() const PURE;
+
   /**
    * Get the socket options set on this connection.
    */
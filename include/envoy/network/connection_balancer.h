@@ -32,6 +32,17 @@ public:
    * transfer during the balancing process.
    */
   virtual void post(Network::ConnectionSocketPtr&& socket) PURE;
+
+  /**
+   * Store the index a connection balancer assigned to this handler when registering it. This lets
+   * the balancer find its state for the handler on the accept path without a lookup.
+   */
+  virtual void setBalancerIndex(uint32_t index) PURE;
+
+  /**
+   * @return the index last stored by setBalancerIndex().
+   */
+  virtual uint32_t balancerIndex() const PURE;
 };
 
 /**
@@ -13,6 +13,8 @@
 #include "envoy/network/listen_socket.h"
 #include "envoy/stats/scope.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Network {
 
@@ -29,10 +31,12 @@ public:
 
   /**
    * Called during actual listener creation.
+   * @param worker_index supplies the index of the worker thread creating the listener, or nullopt
+   * for listeners not owned by a worker, which never get the socket of a worker.
    * @return the socket to be used for a certain listener, which might be shared
    * with other listeners of the same config on other worker threads.
    */
-  virtual SocketSharedPtr getListenSocket() PURE;
+  virtual SocketSharedPtr getListenSocket(absl::optional<uint32_t> worker_index) PURE;
 
   /**
    * @return the type of the socket getListenSocket() returns.
@@ -49,6 +53,13 @@ public:
    * @return the socket shared by worker threads if any; otherwise return null.
    */
   virtual SocketOptRef sharedSocket() const PURE;
+
+  /**
+   * @param worker_index supplies the index of a worker.
+   * @return the socket of the worker when the sockets of the SO_REUSEPORT group are steered by
+   * worker index; otherwise return null.
+   */
+  virtual SocketSharedPtr workerSocket(uint32_t worker_index) const PURE;
 };
 
 using ListenSocketFactorySharedPtr = std::shared_ptr<ListenSocketFactory>;
@@ -66,6 +66,30 @@ public:
 
 using RandomGeneratorPtr = std::unique_ptr<RandomGenerator>;
 
+/**
+ * A runtime key registered ahead of time, typically when the configuration referencing it is
+ * loaded. Snapshots index the values of the registered keys, so that looking a key up on the
+ * request path through its handle is an array read rather than a hash map lookup.
+ */
+class KeyHandle {
+public:
+  KeyHandle(std::string key, uint32_t index) : key_(std::move(key)), index_(index) {}
+
+  /**
+   * @return const std::string& the runtime key.
+   */
+  const std::string& key() const { return key_; }
+
+  /**
+   * @return uint32_t the index of the key in the snapshots.
+   */
+  uint32_t index() const { return index_; }
+
+private:
+  std::string key_;
+  uint32_t index_;
+};
+
 /**
  * A snapshot of runtime data.
  */
@@ -247,6 +271,28 @@ public:
    */
   virtual bool getBoolean(absl::string_view key, bool default_value) const PURE;
 
+  // The variants below of the lookups above take a registered key. Snapshots which do not index
+  // the registered keys look them up by name.
+
+  virtual bool featureEnabled(const KeyHandle& key,
+                              const envoy::type::v3::FractionalPercent& default_value) const {
+    return featureEnabled(key.key(), default_value);
+  }
+  virtual bool featureEnabled(const KeyHandle& key,
+                              const envoy::type::v3::FractionalPercent& default_value,
+                              uint64_t random_value) const {
+    return featureEnabled(key.key(), default_value, random_value);
+  }
+  virtual uint64_t getInteger(const KeyHandle& key, uint64_t default_value) const {
+    return getInteger(key.key(), default_value);
+  }
+  virtual double getDouble(const KeyHandle& key, double default_value) const {
+    return getDouble(key.key(), default_value);
+  }
+  virtual bool getBoolean(const KeyHandle& key, bool default_value) const {
+    return getBoolean(key.key(), default_value);
+  }
+
   /**
    * Fetch the OverrideLayers that provide values in this snapshot. Layers are ordered from bottom
    * to top; for instance, the second layer's entries override the first layer's entries, and so on.
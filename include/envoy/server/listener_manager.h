@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "envoy/admin/v3/config_dump.pb.h"
+#include "envoy/buffer/buffer.h"
 #include "envoy/config/core/v3/config_source.pb.h"
 #include "envoy/config/listener/v3/listener.pb.h"
 #include "envoy/config/listener/v3/listener_components.pb.h"
@@ -16,6 +17,8 @@
 
 #include "common/protobuf/protobuf.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -35,8 +38,10 @@ public:
 using LdsApiPtr = std::unique_ptr<LdsApi>;
 
 struct ListenSocketCreationParams {
-  ListenSocketCreationParams(bool bind_to_port, bool duplicate_parent_socket = true)
-      : bind_to_port(bind_to_port), duplicate_parent_socket(duplicate_parent_socket) {}
+  ListenSocketCreationParams(bool bind_to_port, bool duplicate_parent_socket = true,
+                             absl::optional<uint32_t> worker_index = absl::nullopt)
+      : bind_to_port(bind_to_port), duplicate_parent_socket(duplicate_parent_socket),
+        worker_index(worker_index) {}
 
   // For testing.
   bool operator==(const ListenSocketCreationParams& rhs) const;
@@ -46,6 +51,10 @@ struct ListenSocketCreationParams {
   bool bind_to_port;
   // whether to duplicate socket from hot restart parent.
   bool duplicate_parent_socket;
+  // the index of the worker owning the socket when the sockets of an SO_REUSEPORT group are
+  // steered by worker index. Such a socket is duplicated from the hot restart parent's socket of
+  // the same worker.
+  absl::optional<uint32_t> worker_index;
 };
 
 /**
@@ -172,6 +181,13 @@ public:
    */
   virtual uint64_t numConnections() const PURE;
 
+  /**
+   * @return the memory accounts holding the most buffered bytes on each worker, in the order of
+   *         the workers. @see Worker::largestBufferMemoryAccounts().
+   */
+  virtual std::vector<std::vector<Buffer::BufferMemoryAccountBalance>>
+  largestBufferMemoryAccounts() const PURE;
+
   /**
    * Remove a listener by name.
    * @param name supplies the listener name to remove.
@@ -70,6 +70,10 @@ public:
 
   // Overload action to try to shrink the heap by releasing free memory.
   const std::string ShrinkHeap = "envoy.overload_actions.shrink_heap";
+
+  // Overload action to close the connections holding the most buffered data.
+  const std::string ResetHighMemoryConnections =
+      "envoy.overload_actions.reset_high_memory_connections";
 };
 
 using OverloadActionNames = ConstSingleton<OverloadActionNameValues>;
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <functional>
+#include <vector>
 
+#include "envoy/buffer/buffer.h"
 #include "envoy/server/guarddog.h"
 #include "envoy/server/overload_manager.h"
 
@@ -41,6 +43,12 @@ public:
    */
   virtual uint64_t numConnections() const PURE;
 
+  /**
+   * @return the memory accounts of the worker holding the most buffered bytes, and their largest
+   *         child accounts, as of the last refresh of the worker's buffer memory stats.
+   */
+  virtual std::vector<Buffer::BufferMemoryAccountBalance> largestBufferMemoryAccounts() const PURE;
+
   /**
    * Start the worker thread.
    * @param guard_dog supplies the guard dog to use for thread watching.
@@ -100,11 +108,12 @@ public:
   virtual ~WorkerFactory() = default;
 
   /**
+   * @param index supplies the index of the worker, starting at 0.
    * @param overload_manager supplies the server's overload manager.
    * @param worker_name supplies the name of the worker, used for per-worker stats.
    * @return WorkerPtr a new worker.
    */
-  virtual WorkerPtr createWorker(OverloadManager& overload_manager,
+  virtual WorkerPtr createWorker(uint32_t index, OverloadManager& overload_manager,
                                  const std::string& worker_name) PURE;
 };
 
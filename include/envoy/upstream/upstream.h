@@ -706,6 +706,11 @@ public:
    */
   virtual const absl::optional<std::chrono::milliseconds> idleTimeout() const PURE;
 
+  /**
+   * @return the interval after which unused per worker connection pools are destroyed, if any.
+   */
+  virtual const absl::optional<std::chrono::milliseconds> connectionPoolIdleTimeout() const PURE;
+
   /**
    * @return soft limit on size of the cluster's connections read and write buffers.
    */
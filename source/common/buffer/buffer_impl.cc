@@ -1,11 +1,15 @@
 #include "common/buffer/buffer_impl.h"
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 
 #include "common/common/assert.h"
+#include "common/common/macros.h"
 
 #include "absl/container/fixed_array.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
 #include "event2/buffer.h"
 
 namespace Envoy {
@@ -16,8 +20,197 @@ namespace {
 // TODO(yanavlasov): This may not be optimal for all hardware configurations or traffic patterns and
 // may need to be configurable in the future.
 constexpr uint64_t CopyThreshold = 512;
+
+#ifndef ENVOY_DISABLE_SLICE_BLOCK_CACHE
+// Largest OwnedSlice block, in pages, kept for reuse. Five pages covers the 16 KiB reads done by
+// the transport sockets.
+constexpr uint64_t MaxCachedSlicePages = 5;
+// Number of released blocks of each size kept per thread.
+constexpr uint64_t MaxCachedSlicesPerSize = 8;
+
+class SliceBlockCache {
+public:
+  ~SliceBlockCache();
+
+  void* get(uint64_t pages) {
+    Bin& bin = bins_[pages - 1];
+    return bin.size_ > 0 ? bin.blocks_[--bin.size_] : nullptr;
+  }
+
+  bool put(void* block, uint64_t pages) {
+    Bin& bin = bins_[pages - 1];
+    if (bin.size_ == MaxCachedSlicesPerSize) {
+      return false;
+    }
+    bin.blocks_[bin.size_++] = block;
+    return true;
+  }
+
+private:
+  struct Bin {
+    void* blocks_[MaxCachedSlicesPerSize];
+    uint64_t size_{};
+  };
+
+  Bin bins_[MaxCachedSlicePages];
+};
+
+thread_local SliceBlockCache slice_block_cache;
+// Set when this thread's cache has been destroyed, so that slices released later during thread
+// exit go straight back to the allocator.
+thread_local bool slice_block_cache_destroyed = false;
+
+SliceBlockCache::~SliceBlockCache() {
+  slice_block_cache_destroyed = true;
+  for (Bin& bin : bins_) {
+    while (bin.size_ > 0) {
+      ::operator delete(bin.blocks_[--bin.size_]);
+    }
+  }
+}
+#endif
+
+// Number of slices created from a cached block and from a newly allocated block by one thread.
+// Only the owning thread updates them, which needs no atomic read-modify-write, while the totals
+// over all threads are read when flushing stats.
+struct SliceAllocationCounts {
+  std::atomic<uint64_t> recycled_{};
+  std::atomic<uint64_t> fresh_{};
+};
+
+class SliceAllocationRegistry {
+public:
+  void add(const SliceAllocationCounts& counts) {
+    absl::MutexLock lock(&mutex_);
+    threads_.insert(&counts);
+  }
+
+  // Keeps the counts of a thread that is exiting.
+  void remove(const SliceAllocationCounts& counts) {
+    absl::MutexLock lock(&mutex_);
+    threads_.erase(&counts);
+    retired_recycled_ += counts.recycled_.load(std::memory_order_relaxed);
+    retired_fresh_ += counts.fresh_.load(std::memory_order_relaxed);
+  }
+
+  // Counts a slice created during thread exit, after the thread's counts were destroyed.
+  void addRetired(bool recycled) {
+    absl::MutexLock lock(&mutex_);
+    (recycled ? retired_recycled_ : retired_fresh_)++;
+  }
+
+  uint64_t recycled() {
+    absl::MutexLock lock(&mutex_);
+    uint64_t total = retired_recycled_;
+    for (const SliceAllocationCounts* counts : threads_) {
+      total += counts->recycled_.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  uint64_t fresh() {
+    absl::MutexLock lock(&mutex_);
+    uint64_t total = retired_fresh_;
+    for (const SliceAllocationCounts* counts : threads_) {
+      total += counts->fresh_.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+private:
+  absl::Mutex mutex_;
+  absl::flat_hash_set<const SliceAllocationCounts*> threads_ ABSL_GUARDED_BY(mutex_);
+  uint64_t retired_recycled_ ABSL_GUARDED_BY(mutex_){};
+  uint64_t retired_fresh_ ABSL_GUARDED_BY(mutex_){};
+};
+
+SliceAllocationRegistry& sliceAllocationRegistry() {
+  MUTABLE_CONSTRUCT_ON_FIRST_USE(SliceAllocationRegistry);
+}
+
+thread_local bool slice_allocation_counts_destroyed = false;
+
+class ThreadSliceAllocationCounts : public SliceAllocationCounts {
+public:
+  ThreadSliceAllocationCounts() { sliceAllocationRegistry().add(*this); }
+  ~ThreadSliceAllocationCounts() {
+    slice_allocation_counts_destroyed = true;
+    sliceAllocationRegistry().remove(*this);
+  }
+};
+
+thread_local ThreadSliceAllocationCounts slice_allocation_counts;
+
+void countSliceAllocation(bool recycled) {
+  if (slice_allocation_counts_destroyed) {
+    sliceAllocationRegistry().addRetired(recycled);
+    return;
+  }
+  std::atomic<uint64_t>& count =
+      recycled ? slice_allocation_counts.recycled_ : slice_allocation_counts.fresh_;
+  count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
 } // namespace
 
+bool SliceView::worthSplitting(const Slice& slice, uint64_t size) {
+  // A view keeps the whole storage of the slice alive, and buffer limits only count the bytes of
+  // the view, so only parts which are a sizable fraction of the storage are split off.
+  const auto* view = dynamic_cast<const SliceView*>(&slice);
+  const uint64_t capacity = view != nullptr ? view->storage_->capacity_ : slice.capacity_;
+  return size >= capacity / MinSplitFraction;
+}
+
+SlicePtr SliceView::split(SlicePtr& slice, uint64_t size) {
+  ASSERT(size < slice->dataSize());
+  uint8_t* data = slice->data();
+  const uint64_t remaining = slice->dataSize() - size;
+  // Views of a view share the underlying slice directly.
+  auto* view = dynamic_cast<SliceView*>(slice.get());
+  std::shared_ptr<Slice> storage =
+      view != nullptr ? view->storage_ : std::shared_ptr<Slice>(std::move(slice));
+  SlicePtr front(new SliceView(storage, data, size));
+  slice.reset(new SliceView(std::move(storage), data + size, remaining));
+  return front;
+}
+
+static_assert(alignof(OwnedSlice) <= OwnedSlice::BlockHeaderSize,
+              "the block header must keep OwnedSlice aligned");
+
+void* OwnedSlice::operator new(size_t object_size, size_t data_size_bytes) {
+  const uint64_t block_size = BlockHeaderSize + object_size + data_size_bytes;
+  ASSERT(block_size % PageSize == 0);
+  const uint64_t pages = block_size / PageSize;
+  void* block = nullptr;
+#ifndef ENVOY_DISABLE_SLICE_BLOCK_CACHE
+  if (pages <= MaxCachedSlicePages && !slice_block_cache_destroyed) {
+    block = slice_block_cache.get(pages);
+  }
+#endif
+  countSliceAllocation(block != nullptr);
+  if (block == nullptr) {
+    block = ::operator new(block_size);
+  }
+  // The size of the block is kept in front of the slice for operator delete().
+  *static_cast<uint64_t*>(block) = pages;
+  return static_cast<uint8_t*>(block) + BlockHeaderSize;
+}
+
+void OwnedSlice::operator delete(void* address) {
+  void* block = static_cast<uint8_t*>(address) - BlockHeaderSize;
+#ifndef ENVOY_DISABLE_SLICE_BLOCK_CACHE
+  const uint64_t pages = *static_cast<uint64_t*>(block);
+  if (pages <= MaxCachedSlicePages && !slice_block_cache_destroyed &&
+      slice_block_cache.put(block, pages)) {
+    return;
+  }
+#endif
+  ::operator delete(block);
+}
+
+uint64_t OwnedSlice::recycledAllocations() { return sliceAllocationRegistry().recycled(); }
+
+uint64_t OwnedSlice::freshAllocations() { return sliceAllocationRegistry().fresh(); }
+
 void OwnedImpl::addImpl(const void* data, uint64_t size) {
   const char* src = static_cast<const char*>(data);
   bool new_slice_needed = slices_.empty();
@@ -278,7 +471,13 @@ void OwnedImpl::move(Instance& rhs) {
   other.postProcess();
 }
 
-void OwnedImpl::move(Instance& rhs, uint64_t length) {
+void OwnedImpl::move(Instance& rhs, uint64_t length) { moveImpl(rhs, length, false); }
+
+void OwnedImpl::moveSharingSlices(Instance& rhs, uint64_t length) {
+  moveImpl(rhs, length, true);
+}
+
+void OwnedImpl::moveImpl(Instance& rhs, uint64_t length, bool share_slices) {
   ASSERT(&rhs != this);
   // See move() above for why we do the static cast.
   OwnedImpl& other = static_cast<OwnedImpl&>(rhs);
@@ -288,10 +487,14 @@ void OwnedImpl::move(Instance& rhs, uint64_t length) {
     if (copy_size == 0) {
       other.slices_.pop_front();
     } else if (copy_size < slice_size) {
-      // TODO(brian-pane) add reference-counting to allow slices to share their storage
-      // and eliminate the copy for this partial-slice case?
-      add(other.slices_.front()->data(), copy_size);
-      other.slices_.front()->drain(copy_size);
+      if (share_slices && copy_size >= CopyThreshold &&
+          SliceView::worthSplitting(*other.slices_.front(), copy_size)) {
+        // Share the slice's storage between the two buffers rather than copying the data.
+        coalesceOrAddSlice(SliceView::split(other.slices_.front(), copy_size));
+      } else {
+        add(other.slices_.front()->data(), copy_size);
+        other.slices_.front()->drain(copy_size);
+      }
       other.length_ -= copy_size;
     } else {
       coalesceOrAddSlice(std::move(other.slices_.front()));
@@ -502,6 +705,10 @@ std::string OwnedImpl::toString() const {
   return output;
 }
 
+void OwnedImpl::bindAccount(BufferMemoryAccountSharedPtr account) {
+  length_.bindAccount(std::move(account));
+}
+
 void OwnedImpl::postProcess() {}
 
 void OwnedImpl::appendSliceForTest(const void* data, uint64_t size) {
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <string>
 
 #include "envoy/buffer/buffer.h"
@@ -194,6 +195,8 @@ public:
   }
 
 protected:
+  friend class SliceView;
+
   Slice(uint64_t data, uint64_t reservable, uint64_t capacity)
       : data_(data), reservable_(reservable), capacity_(capacity) {}
 
@@ -212,9 +215,43 @@ protected:
 
 using SlicePtr = std::unique_ptr<Slice>;
 
+// Recycling the blocks of released slices would hide use-after-free of buffer memory from ASAN and
+// the fuzzers, so the block cache is compiled out of those builds.
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define ENVOY_DISABLE_SLICE_BLOCK_CACHE
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) || defined(FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION)
+#define ENVOY_DISABLE_SLICE_BLOCK_CACHE
+#endif
+
 // OwnedSlice can not be derived from as it has variable sized array as member.
 class OwnedSlice final : public Slice, public InlineStorage {
 public:
+  // The blocks backing OwnedSlices are a whole number of pages, starting with a header that holds
+  // the number of pages. Released blocks of up to five pages are kept in a small per-thread cache
+  // and handed out again by the next create() of the same size on that thread, instead of going
+  // back to the allocator. Slices may be released on a different thread than the one that created
+  // them.
+  static void* operator new(size_t object_size, size_t data_size_bytes);
+  static void operator delete(void* address);
+
+  /**
+   * Size of the header in front of each slice, which holds the number of pages of its block.
+   */
+  static constexpr uint64_t BlockHeaderSize = 8;
+
+  /**
+   * @return the number of slices created from a cached block, over all threads.
+   */
+  static uint64_t recycledAllocations();
+
+  /**
+   * @return the number of slices created from a newly allocated block, over all threads.
+   */
+  static uint64_t freshAllocations();
+
   /**
    * Create an empty OwnedSlice.
    * @param capacity number of bytes of space the slice should have.
@@ -241,6 +278,8 @@ public:
   }
 
 private:
+  static constexpr uint64_t PageSize = 4096;
+
   OwnedSlice(uint64_t size) : Slice(0, 0, size) { base_ = storage_; }
 
   /**
@@ -249,9 +288,9 @@ private:
    * @return a recommended slice size, in bytes.
    */
   static uint64_t sliceSize(uint64_t data_size) {
-    static constexpr uint64_t PageSize = 4096;
-    const uint64_t num_pages = (sizeof(OwnedSlice) + data_size + PageSize - 1) / PageSize;
-    return num_pages * PageSize - sizeof(OwnedSlice);
+    const uint64_t num_pages =
+        (BlockHeaderSize + sizeof(OwnedSlice) + data_size + PageSize - 1) / PageSize;
+    return num_pages * PageSize - sizeof(OwnedSlice) - BlockHeaderSize;
   }
 
   uint8_t storage_[];
@@ -431,6 +470,44 @@ private:
   BufferFragment& fragment_;
 };
 
+/**
+ * A read-only view of part of the data of another slice. Views allow a slice to be split between
+ * buffers without copying: the underlying slice is released once all views of it are released.
+ */
+class SliceView : public Slice {
+public:
+  /**
+   * Split the first `size` bytes of data off a slice without copying them.
+   * @param slice supplies the slice to split, which must hold more than `size` bytes of data. It is
+   *        replaced by a view of the data following the first `size` bytes.
+   * @param size supplies the number of bytes to split off.
+   * @return a view of the first `size` bytes of data.
+   */
+  static SlicePtr split(SlicePtr& slice, uint64_t size);
+
+  /**
+   * @param slice supplies a slice holding more than `size` bytes of data.
+   * @param size supplies the number of bytes to split off.
+   * @return whether the part is large enough compared to the storage of the slice to be split off
+   *         rather than copied, as a view pins the whole storage.
+   */
+  static bool worthSplitting(const Slice& slice, uint64_t size);
+
+  bool canCoalesce() const override { return storage_->canCoalesce(); }
+
+private:
+  SliceView(std::shared_ptr<Slice> storage, uint8_t* data, uint64_t size)
+      : Slice(0, size, size), storage_(std::move(storage)) {
+    base_ = data;
+  }
+
+  // Parts smaller than this fraction of the storage of a slice are copied rather than split off.
+  // This bounds the memory a view can pin to this many times its size.
+  static constexpr uint64_t MinSplitFraction = 4;
+
+  const std::shared_ptr<Slice> storage_;
+};
+
 /**
  * An implementation of BufferFragment where a releasor callback is called when the data is
  * no longer needed.
@@ -496,6 +573,59 @@ private:
   uint64_t value_{0};
 };
 
+/**
+ * The length of an OwnedImpl, which also charges and credits the memory account the buffer is
+ * bound to, if any, as it changes.
+ */
+class AccountedLength {
+public:
+  AccountedLength() = default;
+  AccountedLength(AccountedLength&& rhs) noexcept
+      : value_(rhs.value_), account_(std::move(rhs.account_)) {
+    rhs.value_ = OverflowDetectingUInt64();
+  }
+  AccountedLength& operator=(AccountedLength&& rhs) noexcept {
+    bindAccount(nullptr);
+    value_ = rhs.value_;
+    account_ = std::move(rhs.account_);
+    rhs.value_ = OverflowDetectingUInt64();
+    return *this;
+  }
+  ~AccountedLength() { bindAccount(nullptr); }
+
+  operator uint64_t() const { return value_; }
+
+  AccountedLength& operator+=(uint64_t size) {
+    value_ += size;
+    if (account_ != nullptr) {
+      account_->charge(size);
+    }
+    return *this;
+  }
+
+  AccountedLength& operator-=(uint64_t size) {
+    value_ -= size;
+    if (account_ != nullptr) {
+      account_->credit(size);
+    }
+    return *this;
+  }
+
+  void bindAccount(BufferMemoryAccountSharedPtr account) {
+    if (account_ != nullptr) {
+      account_->credit(value_);
+    }
+    account_ = std::move(account);
+    if (account_ != nullptr) {
+      account_->charge(value_);
+    }
+  }
+
+private:
+  OverflowDetectingUInt64 value_;
+  BufferMemoryAccountSharedPtr account_;
+};
+
 /**
  * Wraps an allocated and owned buffer.
  *
@@ -530,10 +660,23 @@ public:
   bool startsWith(absl::string_view data) const override;
   Api::IoCallUint64Result write(Network::IoHandle& io_handle) override;
   std::string toString() const override;
+  void bindAccount(BufferMemoryAccountSharedPtr account) override;
 
   // LibEventInstance
   void postProcess() override;
 
+  /**
+   * Move the first `length` bytes of `rhs` like move(), except that a slice split by the move is
+   * shared with `rhs` instead of being copied, when the moved part is at least CopyThreshold bytes
+   * and a sizable fraction of the slice's storage.
+   * NOTE: a shared slice is only freed once every part of it is released, while each buffer only
+   * counts the bytes of its own part, so the memory held can be up to four times what the buffer
+   * limits allow.
+   * @param rhs supplies the buffer to move data from.
+   * @param length supplies the number of bytes to move.
+   */
+  virtual void moveSharingSlices(Instance& rhs, uint64_t length);
+
   /**
    * Create a new slice at the end of the buffer, and copy the supplied content into it.
    * @param data start of the content to copy.
@@ -563,6 +706,7 @@ private:
   bool isSameBufferImpl(const Instance& rhs) const;
 
   void addImpl(const void* data, uint64_t size);
+  void moveImpl(Instance& rhs, uint64_t length, bool share_slices);
 
   /**
    * Moves contents of the `other_slice` by either taking its ownership or coalescing it
@@ -575,7 +719,7 @@ private:
   SliceDeque slices_;
 
   /** Sum of the dataSize of all slices. */
-  OverflowDetectingUInt64 length_;
+  AccountedLength length_;
 };
 
 using BufferFragmentPtr = std::unique_ptr<BufferFragment>;
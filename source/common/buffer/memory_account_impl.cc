@@ -0,0 +1,105 @@
+#include "common/buffer/memory_account_impl.h"
+
+#include <algorithm>
+
+#include "common/common/assert.h"
+
+namespace Envoy {
+namespace Buffer {
+
+BufferMemoryAccountImpl::BufferMemoryAccountImpl(BufferMemoryAccountListSharedPtr list,
+                                                 std::string description,
+                                                 std::function<void()> reset_callback)
+    : list_(std::move(list)), description_(std::move(description)),
+      reset_callback_(std::move(reset_callback)),
+      entry_(list_->accounts_.insert(list_->accounts_.end(), this)) {}
+
+BufferMemoryAccountImpl::BufferMemoryAccountImpl(BufferMemoryAccountImplSharedPtr parent,
+                                                 std::string description)
+    : list_(parent->list_), parent_(std::move(parent)), description_(std::move(description)),
+      entry_(parent_->children_.insert(parent_->children_.end(), this)) {}
+
+BufferMemoryAccountImpl::~BufferMemoryAccountImpl() {
+  // Buffers hold a reference to the account they are bound to, so all of them have been credited.
+  // Child accounts hold a reference to their parent, so there are none left either.
+  ASSERT(balance_ == 0);
+  ASSERT(children_.empty());
+  if (parent_ != nullptr) {
+    parent_->children_.erase(entry_);
+  } else {
+    list_->accounts_.erase(entry_);
+  }
+}
+
+BufferMemoryAccountSharedPtr BufferMemoryAccountImpl::createChildAccount(std::string description) {
+  return std::make_shared<BufferMemoryAccountImpl>(shared_from_this(), std::move(description));
+}
+
+BufferMemoryAccountSharedPtr
+BufferMemoryTrackerImpl::createAccount(std::string description,
+                                       std::function<void()> reset_callback) {
+  return std::make_shared<BufferMemoryAccountImpl>(list_, std::move(description),
+                                                   std::move(reset_callback));
+}
+
+std::vector<BufferMemoryAccountImpl*>
+BufferMemoryTrackerImpl::largestOf(const std::list<BufferMemoryAccountImpl*>& candidates,
+                                   uint32_t count, bool resettable_only) {
+  std::vector<BufferMemoryAccountImpl*> accounts;
+  accounts.reserve(candidates.size());
+  for (BufferMemoryAccountImpl* account : candidates) {
+    if (account->balance() > 0 && (account->resettable() || !resettable_only)) {
+      accounts.push_back(account);
+    }
+  }
+
+  const auto middle = accounts.begin() + std::min<size_t>(count, accounts.size());
+  std::partial_sort(accounts.begin(), middle, accounts.end(),
+                    [](const BufferMemoryAccountImpl* lhs, const BufferMemoryAccountImpl* rhs) {
+                      return lhs->balance() > rhs->balance();
+                    });
+  accounts.erase(middle, accounts.end());
+  return accounts;
+}
+
+std::vector<uint64_t> BufferMemoryTrackerImpl::largestBalances(uint32_t count) const {
+  std::vector<uint64_t> balances;
+  for (const BufferMemoryAccountImpl* account : largestOf(list_->accounts_, count, false)) {
+    balances.push_back(account->balance());
+  }
+  return balances;
+}
+
+std::vector<BufferMemoryAccountBalance>
+BufferMemoryTrackerImpl::largestAccounts(uint32_t count) const {
+  std::vector<BufferMemoryAccountBalance> balances;
+  for (const BufferMemoryAccountImpl* account : largestOf(list_->accounts_, count, false)) {
+    balances.push_back({account->description(), account->balance(), {}});
+    BufferMemoryAccountBalance& balance = balances.back();
+    for (const BufferMemoryAccountImpl* child : largestOf(account->children(), count, false)) {
+      balance.children_.push_back({child->description(), child->balance(), {}});
+    }
+  }
+  return balances;
+}
+
+uint32_t BufferMemoryTrackerImpl::resetLargestAccounts(uint32_t count) {
+  // Resetting an account may release the buffers of other accounts, e.g. when closing a downstream
+  // connection closes its upstream connection, so hold on to all of them until the resets are done
+  // and skip those which no longer have a balance: their owner may be gone.
+  std::vector<std::shared_ptr<BufferMemoryAccountImpl>> accounts;
+  for (BufferMemoryAccountImpl* account : largestOf(list_->accounts_, count, true)) {
+    accounts.push_back(account->shared_from_this());
+  }
+  uint32_t reset = 0;
+  for (const auto& account : accounts) {
+    if (account->balance() > 0 && account->resettable()) {
+      account->reset();
+      ++reset;
+    }
+  }
+  return reset;
+}
+
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/buffer/buffer.h"
+
+#include "common/common/assert.h"
+#include "common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Buffer {
+
+class BufferMemoryAccountImpl;
+
+/**
+ * The accounts of a tracker and their total balance. Shared by the tracker and its accounts, so
+ * that accounts outliving their tracker, e.g. connections destroyed after their dispatcher in
+ * tests, do not reference freed memory.
+ */
+struct BufferMemoryAccountList {
+  std::list<BufferMemoryAccountImpl*> accounts_;
+  uint64_t balance_{};
+};
+
+using BufferMemoryAccountListSharedPtr = std::shared_ptr<BufferMemoryAccountList>;
+
+using BufferMemoryAccountImplSharedPtr = std::shared_ptr<BufferMemoryAccountImpl>;
+
+/**
+ * An account which also keeps the total balance of its tracker, or of its parent account, up to
+ * date. Top level accounts are listed by the tracker, child accounts by their parent.
+ */
+class BufferMemoryAccountImpl final : public BufferMemoryAccount,
+                                      public std::enable_shared_from_this<BufferMemoryAccountImpl>,
+                                      NonCopyable {
+public:
+  BufferMemoryAccountImpl(BufferMemoryAccountListSharedPtr list, std::string description,
+                          std::function<void()> reset_callback);
+  BufferMemoryAccountImpl(BufferMemoryAccountImplSharedPtr parent, std::string description);
+  ~BufferMemoryAccountImpl() override;
+
+  // Buffer::BufferMemoryAccount
+  void charge(uint64_t amount) override {
+    balance_ += amount;
+    if (parent_ != nullptr) {
+      parent_->charge(amount);
+    } else {
+      list_->balance_ += amount;
+    }
+  }
+  void credit(uint64_t amount) override {
+    ASSERT(balance_ >= amount);
+    balance_ -= amount;
+    if (parent_ != nullptr) {
+      parent_->credit(amount);
+    } else {
+      list_->balance_ -= amount;
+    }
+  }
+  uint64_t balance() const override { return balance_; }
+  void clearResetCallback() override { reset_callback_ = nullptr; }
+  BufferMemoryAccountSharedPtr createChildAccount(std::string description) override;
+
+  bool resettable() const { return reset_callback_ != nullptr; }
+  void reset() { reset_callback_(); }
+  const std::string& description() const { return description_; }
+  const std::list<BufferMemoryAccountImpl*>& children() const { return children_; }
+
+private:
+  const BufferMemoryAccountListSharedPtr list_;
+  // Child accounts keep their parent alive, as buffers bound to them credit the parent too.
+  const BufferMemoryAccountImplSharedPtr parent_;
+  const std::string description_;
+  std::function<void()> reset_callback_;
+  std::list<BufferMemoryAccountImpl*> children_;
+  // The entry of the account in the list of its tracker or of its parent.
+  std::list<BufferMemoryAccountImpl*>::iterator entry_;
+  uint64_t balance_{};
+};
+
+/**
+ * Tracks the memory accounts of one dispatcher.
+ */
+class BufferMemoryTrackerImpl : public BufferMemoryTracker, NonCopyable {
+public:
+  BufferMemoryTrackerImpl() : list_(std::make_shared<BufferMemoryAccountList>()) {}
+
+  // Buffer::BufferMemoryTracker
+  BufferMemoryAccountSharedPtr createAccount(std::string description,
+                                             std::function<void()> reset_callback) override;
+  uint64_t balance() const override { return list_->balance_; }
+  std::vector<uint64_t> largestBalances(uint32_t count) const override;
+  std::vector<BufferMemoryAccountBalance> largestAccounts(uint32_t count) const override;
+  uint32_t resetLargestAccounts(uint32_t count) override;
+
+private:
+  static std::vector<BufferMemoryAccountImpl*>
+  largestOf(const std::list<BufferMemoryAccountImpl*>& accounts, uint32_t count,
+            bool resettable_only);
+
+  const BufferMemoryAccountListSharedPtr list_;
+};
+
+} // namespace Buffer
+} // namespace Envoy
@@ -51,6 +51,11 @@ void WatermarkBuffer::move(Instance& rhs, uint64_t length) {
   checkHighAndOverflowWatermarks();
 }
 
+void WatermarkBuffer::moveSharingSlices(Instance& rhs, uint64_t length) {
+  OwnedImpl::moveSharingSlices(rhs, length);
+  checkHighAndOverflowWatermarks();
+}
+
 Api::IoCallUint64Result WatermarkBuffer::read(Network::IoHandle& io_handle, uint64_t max_length) {
   Api::IoCallUint64Result result = OwnedImpl::read(io_handle, max_length);
   checkHighAndOverflowWatermarks();
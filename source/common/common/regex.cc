@@ -1,10 +1,13 @@
 #include "common/common/regex.h"
 
+#include <algorithm>
+
 #include "envoy/common/exception.h"
 #include "envoy/type/matcher/v3/regex.pb.h"
 
 #include "common/common/assert.h"
 #include "common/common/fmt.h"
+#include "common/common/macros.h"
 #include "common/protobuf/utility.h"
 
 #include "re2/re2.h"
@@ -13,6 +16,12 @@ namespace Envoy {
 namespace Regex {
 namespace {
 
+re2::RE2::Options quietOptions() {
+  re2::RE2::Options options;
+  options.set_log_errors(false);
+  return options;
+}
+
 class CompiledStdMatcher : public CompiledMatcher {
 public:
   CompiledStdMatcher(std::regex&& regex) : regex_(std::move(regex)) {}
@@ -42,39 +51,133 @@ private:
 class CompiledGoogleReMatcher : public CompiledMatcher {
 public:
   CompiledGoogleReMatcher(const envoy::type::matcher::v3::RegexMatcher& config)
-      : regex_(config.regex(), re2::RE2::Quiet) {
-    if (!regex_.ok()) {
-      throw EnvoyException(regex_.error());
-    }
-
+      : regex_(CompiledRegexCache::get().getOrCompile(config.regex())) {
     const uint32_t max_program_size =
         PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.google_re2(), max_program_size, 100);
-    if (static_cast<uint32_t>(regex_.ProgramSize()) > max_program_size) {
+    if (static_cast<uint32_t>(regex_->ProgramSize()) > max_program_size) {
       throw EnvoyException(fmt::format("regex '{}' RE2 program size of {} > max program size of "
                                        "{}. Increase configured max program size if necessary.",
-                                       config.regex(), regex_.ProgramSize(), max_program_size));
+                                       config.regex(), regex_->ProgramSize(), max_program_size));
     }
   }
 
   // CompiledMatcher
   bool match(absl::string_view value) const override {
-    return re2::RE2::FullMatch(re2::StringPiece(value.data(), value.size()), regex_);
+    return re2::RE2::FullMatch(re2::StringPiece(value.data(), value.size()), *regex_);
   }
 
   // CompiledMatcher
   std::string replaceAll(absl::string_view value, absl::string_view substitution) const override {
     std::string result = std::string(value);
-    re2::RE2::GlobalReplace(&result, regex_,
+    re2::RE2::GlobalReplace(&result, *regex_,
                             re2::StringPiece(substitution.data(), substitution.size()));
     return result;
   }
 
 private:
-  const re2::RE2 regex_;
+  const std::shared_ptr<const re2::RE2> regex_;
 };
 
 } // namespace
 
+CompiledRegexCache& CompiledRegexCache::get() {
+  MUTABLE_CONSTRUCT_ON_FIRST_USE(CompiledRegexCache);
+}
+
+std::shared_ptr<const re2::RE2> CompiledRegexCache::getOrCompile(const std::string& regex) {
+  absl::MutexLock lock(&mutex_);
+  auto it = regexes_.find(regex);
+  if (it != regexes_.end()) {
+    std::shared_ptr<const re2::RE2> compiled = it->second.program_.lock();
+    if (compiled != nullptr) {
+      return compiled;
+    }
+  }
+
+  auto compiled = std::make_unique<const re2::RE2>(regex, re2::RE2::Quiet);
+  if (!compiled->ok()) {
+    throw EnvoyException(compiled->error());
+  }
+  // Forget the pattern with its last user, unless it has been compiled again in the meantime.
+  std::shared_ptr<const re2::RE2> shared(compiled.release(), [this](const re2::RE2* compiled) {
+    const std::string regex = compiled->pattern();
+    delete compiled;
+    absl::MutexLock lock(&mutex_);
+    auto it = regexes_.find(regex);
+    if (it != regexes_.end() && it->second.program_.expired()) {
+      regexes_.erase(it);
+    }
+  });
+  regexes_[regex] = {shared, shared->ProgramSize()};
+  return shared;
+}
+
+std::vector<CompiledRegexCache::Entry> CompiledRegexCache::entries() {
+  // The programs are released once the lock is released, as the deleter of a program takes it.
+  std::vector<std::shared_ptr<const re2::RE2>> compiled_regexes;
+  {
+    absl::MutexLock lock(&mutex_);
+    compiled_regexes.reserve(regexes_.size());
+    for (const auto& regex : regexes_) {
+      std::shared_ptr<const re2::RE2> compiled = regex.second.program_.lock();
+      if (compiled != nullptr) {
+        compiled_regexes.push_back(std::move(compiled));
+      }
+    }
+  }
+
+  std::vector<Entry> entries;
+  entries.reserve(compiled_regexes.size());
+  for (const auto& compiled : compiled_regexes) {
+    // Less the reference held here.
+    entries.push_back({compiled->pattern(), compiled->ProgramSize(), compiled.use_count() - 1});
+  }
+  std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+    return lhs.program_size_ > rhs.program_size_ ||
+           (lhs.program_size_ == rhs.program_size_ && lhs.regex_ < rhs.regex_);
+  });
+  return entries;
+}
+
+uint64_t CompiledRegexCache::size() {
+  absl::MutexLock lock(&mutex_);
+  return regexes_.size();
+}
+
+int CompiledRegexCache::maxProgramSize() {
+  absl::MutexLock lock(&mutex_);
+  int max_program_size = 0;
+  for (const auto& regex : regexes_) {
+    max_program_size = std::max(max_program_size, regex.second.program_size_);
+  }
+  return max_program_size;
+}
+
+CompiledMatcherSet::CompiledMatcherSet(const std::vector<std::string>& regexes)
+    : set_(quietOptions(), re2::RE2::ANCHOR_BOTH) {
+  for (const std::string& regex : regexes) {
+    std::string error;
+    if (set_.Add(regex, &error) < 0) {
+      throw EnvoyException(fmt::format("invalid regex '{}': {}", regex, error));
+    }
+  }
+  if (!set_.Compile()) {
+    throw EnvoyException("regex set exceeds the RE2 memory budget");
+  }
+}
+
+std::vector<int> CompiledMatcherSet::match(absl::string_view value) const {
+  std::vector<int> matches;
+  set_.Match(re2::StringPiece(value.data(), value.size()), &matches);
+  // RE2 does not return the matches in any particular order.
+  std::sort(matches.begin(), matches.end());
+  return matches;
+}
+
+bool CompiledMatcherSet::matchAny(absl::string_view value) const {
+  return set_.Match(re2::StringPiece(value.data(), value.size()), nullptr);
+}
+
 CompiledMatcherPtr Utility::parseRegex(const envoy::type::matcher::v3::RegexMatcher& matcher) {
   // Google Re is the only currently supported engine.
   ASSERT(matcher.has_google_re2());
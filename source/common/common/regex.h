@@ -2,13 +2,106 @@
 
 #include <memory>
 #include <regex>
+#include <string>
+#include <vector>
 
 #include "envoy/common/regex.h"
 #include "envoy/type/matcher/v3/regex.pb.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "re2/re2.h"
+#include "re2/set.h"
+
 namespace Envoy {
 namespace Regex {
 
+/**
+ * A process wide cache of the RE2 programs compiled for config regexes. The same patterns tend to
+ * be repeated across many routes, RBAC policies and header matchers, so each distinct pattern is
+ * compiled and held in memory once, and freed when the last matcher using it is destroyed.
+ * Thread safe.
+ */
+class CompiledRegexCache {
+public:
+  struct Entry {
+    std::string regex_;
+    int program_size_;
+    // The number of matchers sharing the program.
+    long references_;
+  };
+
+  /**
+   * @return CompiledRegexCache& the cache used by Utility::parseRegex().
+   */
+  static CompiledRegexCache& get();
+
+  /**
+   * @param regex supplies the pattern.
+   * @return std::shared_ptr<const re2::RE2> the program compiled for the pattern, which is shared
+   *         with the other users of the pattern.
+   * @throw EnvoyException if the pattern is invalid.
+   */
+  std::shared_ptr<const re2::RE2> getOrCompile(const std::string& regex);
+
+  /**
+   * @return std::vector<Entry> the programs in use, the largest first.
+   */
+  std::vector<Entry> entries();
+
+  /**
+   * @return uint64_t the number of programs in use. Cheaper than entries().
+   */
+  uint64_t size();
+
+  /**
+   * @return int the size of the largest program in use, or 0 if there is none. Cheaper than
+   *         entries().
+   */
+  int maxProgramSize();
+
+private:
+  struct CachedProgram {
+    std::weak_ptr<const re2::RE2> program_;
+    // Kept here so that it can be read without taking a reference to the program.
+    int program_size_;
+  };
+
+  absl::Mutex mutex_;
+  // Programs are removed by the deleter of their last reference, so the programs found here are
+  // still in use, unless their deleter is about to take the lock.
+  absl::flat_hash_map<std::string, CachedProgram> regexes_ ABSL_GUARDED_BY(mutex_);
+};
+
+/**
+ * Matches a value against a batch of RE2 patterns in a single pass, rather than trying each
+ * pattern in turn. Like the matchers built by Utility::parseRegex(), the patterns must match the
+ * whole value.
+ */
+class CompiledMatcherSet {
+public:
+  /**
+   * @param regexes supplies the patterns.
+   * @throw EnvoyException if a pattern is invalid or the set does not fit in the RE2 memory budget.
+   */
+  explicit CompiledMatcherSet(const std::vector<std::string>& regexes);
+
+  /**
+   * @param value supplies the value to match.
+   * @return std::vector<int> the indices of the patterns matching the value, in ascending order.
+   */
+  std::vector<int> match(absl::string_view value) const;
+
+  /**
+   * @param value supplies the value to match.
+   * @return bool whether any of the patterns matches the value. Cheaper than match().
+   */
+  bool matchAny(absl::string_view value) const;
+
+private:
+  re2::RE2::Set set_;
+};
+
 /**
  * Utilities for constructing regular expressions.
  */
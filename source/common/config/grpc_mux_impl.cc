@@ -1,5 +1,6 @@
 #include "common/config/grpc_mux_impl.h"
 
+#include <algorithm>
 #include <unordered_set>
 
 #include "envoy/service/discovery/v3/discovery.pb.h"
@@ -163,14 +164,22 @@ void GrpcMuxImpl::onDiscoveryResponse(
     // ensure we deliver empty config updates when a resource is dropped.
     std::unordered_map<std::string, ProtobufWkt::Any> resources;
     SubscriptionCallbacks& callbacks = api_state_[type_url].watches_.front()->callbacks_;
+    // Finding out the name of a resource requires decoding it, which is only worth it when a
+    // watch is interested in specific resources: wildcard watches, such as those of CDS and LDS,
+    // are given all of them.
+    const bool any_named_watch =
+        std::any_of(api_state_[type_url].watches_.begin(), api_state_[type_url].watches_.end(),
+                    [](const GrpcMuxWatchImpl* watch) { return !watch->resources_.empty(); });
     for (const auto& resource : message->resources()) {
       if (type_url != resource.type_url()) {
         throw EnvoyException(
             fmt::format("{} does not match the message-wide type URL {} in DiscoveryResponse {}",
                         resource.type_url(), type_url, message->DebugString()));
       }
-      const std::string resource_name = callbacks.resourceName(resource);
-      resources.emplace(resource_name, resource);
+      if (any_named_watch) {
+        const std::string resource_name = callbacks.resourceName(resource);
+        resources.emplace(resource_name, resource);
+      }
     }
     for (auto watch : api_state_[type_url].watches_) {
       // onConfigUpdate should be called in all cases for single watch xDS (Cluster and
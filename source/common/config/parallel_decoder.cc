@@ -0,0 +1,97 @@
+#include "common/config/parallel_decoder.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "common/common/lock_guard.h"
+#include "common/runtime/runtime_features.h"
+
+namespace Envoy {
+namespace Config {
+
+ParallelDecoder::ParallelDecoder(Thread::ThreadFactory& thread_factory, uint32_t concurrency)
+    : thread_factory_(thread_factory), concurrency_(std::max(concurrency, 1U)) {}
+
+ParallelDecoder::~ParallelDecoder() {
+  {
+    Thread::LockGuard lock(mutex_);
+    shutdown_ = true;
+    job_posted_.notifyAll();
+  }
+  for (const Thread::ThreadPtr& helper : helpers_) {
+    helper->join();
+  }
+}
+
+void ParallelDecoder::forEach(int count, const std::function<void(int)>& work) {
+  const int threads = std::min<int>(concurrency_, count / MinResourcesPerThread);
+  if (threads <= 1 ||
+      !Runtime::runtimeFeatureEnabled("envoy.reloadable_features.parallel_xds_decoding")) {
+    for (int i = 0; i < count; ++i) {
+      work(i);
+    }
+    return;
+  }
+
+  // Hand out the resources in small batches, so that threads which are done early take over some
+  // of the work of the others.
+  std::atomic<int> next{0};
+  const auto run = [&next, count, &work]() {
+    for (int begin = next.fetch_add(BatchSize); begin < count; begin = next.fetch_add(BatchSize)) {
+      const int end = std::min(begin + BatchSize, count);
+      for (int i = begin; i < end; ++i) {
+        work(i);
+      }
+    }
+  };
+  const std::function<void()> job = run;
+  // The pool is started by the first large update, with enough helpers for the largest ones.
+  while (helpers_.size() < concurrency_ - 1) {
+    helpers_.push_back(
+        thread_factory_.createThread([this]() { helperLoop(); }, Thread::Options{"XdsDecoder"}));
+  }
+  {
+    Thread::LockGuard lock(mutex_);
+    job_ = &job;
+    job_id_++;
+    helpers_wanted_ = threads - 1;
+    job_posted_.notifyAll();
+  }
+  run();
+  // Every resource has been handed out, so helpers which did not pick the job up yet are not
+  // needed anymore. Wait for the ones still decoding their last batch.
+  Thread::LockGuard lock(mutex_);
+  helpers_wanted_ = 0;
+  job_ = nullptr;
+  while (helpers_running_ > 0) {
+    job_done_.wait(mutex_);
+  }
+}
+
+void ParallelDecoder::helperLoop() {
+  uint64_t last_job_id = 0;
+  while (true) {
+    const std::function<void()>* job;
+    {
+      Thread::LockGuard lock(mutex_);
+      while (!shutdown_ && (job_id_ == last_job_id || helpers_wanted_ == 0)) {
+        job_posted_.wait(mutex_);
+      }
+      if (shutdown_) {
+        return;
+      }
+      last_job_id = job_id_;
+      helpers_wanted_--;
+      helpers_running_++;
+      job = job_;
+    }
+    (*job)();
+    Thread::LockGuard lock(mutex_);
+    if (--helpers_running_ == 0) {
+      job_done_.notifyAll();
+    }
+  }
+}
+
+} // namespace Config
+} // namespace Envoy
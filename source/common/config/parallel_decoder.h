@@ -0,0 +1,163 @@
+#pragma once
+
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "envoy/service/discovery/v3/discovery.pb.h"
+#include "envoy/thread/thread.h"
+
+#include "common/common/thread.h"
+#include "common/protobuf/protobuf.h"
+#include "common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Config {
+
+class ParallelDecoder;
+
+/**
+ * An xDS resource unpacked from its google.protobuf.Any and checked against the constraints of its
+ * type, possibly on another thread than the one applying it.
+ */
+template <class MessageType> class DecodedResource {
+public:
+  /**
+   * @return const MessageType& the decoded message, which may not be valid.
+   * @throw the exception, usually an EnvoyException, which failed the unpacking of the resource.
+   */
+  const MessageType& message() const {
+    if (unpack_error_ != nullptr) {
+      std::rethrow_exception(unpack_error_);
+    }
+    return message_;
+  }
+
+  /**
+   * Complete the validation of the resource with the checks which must run on the main thread, as
+   * MessageUtil::anyConvertAndValidate() would.
+   * @param validation_visitor supplies the visitor of unknown fields.
+   * @return const MessageType& the decoded message.
+   * @throw EnvoyException if the resource is not valid, or the exception which failed the
+   *        unpacking of the resource.
+   */
+  const MessageType& validate(ProtobufMessage::ValidationVisitor& validation_visitor) const {
+    const MessageType& message = this->message();
+    if (!validation_visitor.skipValidation()) {
+      MessageUtil::checkForUnexpectedFields(message, validation_visitor);
+    }
+    if (!validation_error_.empty()) {
+      throw ProtoValidationException(validation_error_, API_RECOVER_ORIGINAL(message));
+    }
+    return message;
+  }
+
+private:
+  friend class ParallelDecoder;
+
+  MessageType message_;
+  std::exception_ptr unpack_error_;
+  std::string validation_error_;
+};
+
+/**
+ * Unpacks and validates the resources of large xDS updates over several threads. The results are
+ * returned in the order of the resources, so that they can be applied in order by the caller. The
+ * helper threads are started by the first update large enough to use them and are kept until the
+ * decoder is destroyed. Updates must be decoded from a single thread at a time.
+ */
+class ParallelDecoder {
+public:
+  /**
+   * @param thread_factory supplies the factory of the decoding threads.
+   * @param concurrency supplies the maximum number of threads decoding an update, including the
+   *        calling thread.
+   */
+  ParallelDecoder(Thread::ThreadFactory& thread_factory, uint32_t concurrency);
+  ~ParallelDecoder();
+
+  /**
+   * Decode resources of a state of the world update.
+   */
+  template <class MessageType>
+  std::vector<DecodedResource<MessageType>>
+  decode(const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources) {
+    return decode<MessageType>(
+        resources.size(), [&resources](int i) -> const ProtobufWkt::Any& { return resources[i]; });
+  }
+
+  /**
+   * Decode the added resources of a delta update.
+   */
+  template <class MessageType>
+  std::vector<DecodedResource<MessageType>> decode(
+      const Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource>& resources) {
+    return decode<MessageType>(resources.size(), [&resources](int i) -> const ProtobufWkt::Any& {
+      return resources[i].resource();
+    });
+  }
+
+  /**
+   * Decode a subset of the resources of an update, e.g. the ones which changed since the previous
+   * update. The resources must outlive the call.
+   */
+  template <class MessageType>
+  std::vector<DecodedResource<MessageType>>
+  decode(const std::vector<const ProtobufWkt::Any*>& resources) {
+    return decode<MessageType>(
+        resources.size(), [&resources](int i) -> const ProtobufWkt::Any& { return *resources[i]; });
+  }
+
+  // Updates with fewer resources per thread are not worth starting threads for.
+  static constexpr int MinResourcesPerThread = 64;
+  // The number of resources a thread takes at a time.
+  static constexpr int BatchSize = 16;
+
+private:
+  template <class MessageType>
+  std::vector<DecodedResource<MessageType>>
+  decode(int count, const std::function<const ProtobufWkt::Any&(int)>& resource) {
+    std::vector<DecodedResource<MessageType>> decoded(count);
+    forEach(count, [&decoded, &resource](int i) {
+      DecodedResource<MessageType>& result = decoded[i];
+      // Nothing may escape a helper thread, so any failure is kept for the caller to rethrow.
+      try {
+        MessageUtil::unpackTo(resource(i), result.message_);
+        // Unknown and deprecated fields are reported to a validation visitor which is not thread
+        // safe, so only the type constraints are checked here.
+        std::string error;
+        if (!Validate(result.message_, &error)) {
+          result.validation_error_ = std::move(error);
+        }
+      } catch (const std::exception&) {
+        result.unpack_error_ = std::current_exception();
+      }
+    });
+    return decoded;
+  }
+
+  // Calls work for every index in [0, count), spread over the calling thread and up to
+  // concurrency_ - 1 other threads. Returns once all calls are done.
+  void forEach(int count, const std::function<void(int)>& work);
+  // Runs jobs published by forEach() until the decoder is destroyed.
+  void helperLoop();
+
+  Thread::ThreadFactory& thread_factory_;
+  const uint32_t concurrency_;
+  std::vector<Thread::ThreadPtr> helpers_;
+
+  Thread::MutexBasicLockable mutex_;
+  Thread::CondVar job_posted_;
+  Thread::CondVar job_done_;
+  // The job of the update being decoded, run by up to helpers_wanted_ helpers.
+  const std::function<void()>* job_ ABSL_GUARDED_BY(mutex_){};
+  uint64_t job_id_ ABSL_GUARDED_BY(mutex_){};
+  uint32_t helpers_wanted_ ABSL_GUARDED_BY(mutex_){};
+  // The number of helpers running job_.
+  uint32_t helpers_running_ ABSL_GUARDED_BY(mutex_){};
+  bool shutdown_ ABSL_GUARDED_BY(mutex_){};
+};
+
+} // namespace Config
+} // namespace Envoy
@@ -14,6 +14,7 @@
 #include "envoy/network/connection_handler.h"
 #include "envoy/stats/scope.h"
 
+#include "common/buffer/memory_account_impl.h"
 #include "common/common/logger.h"
 #include "common/common/thread.h"
 #include "common/event/libevent.h"
@@ -70,6 +71,7 @@ public:
   void post(std::function<void()> callback) override;
   void run(RunType type) override;
   Buffer::WatermarkFactory& getWatermarkFactory() override { return *buffer_factory_; }
+  Buffer::BufferMemoryTracker& bufferMemoryTracker() override { return buffer_memory_tracker_; }
   const ScopeTrackedObject* setTrackedObject(const ScopeTrackedObject* object) override {
     const ScopeTrackedObject* return_object = current_object_;
     current_object_ = object;
@@ -107,6 +109,7 @@ private:
   std::unique_ptr<DispatcherStats> stats_;
   Thread::ThreadId run_tid_;
   Buffer::WatermarkFactoryPtr buffer_factory_;
+  Buffer::BufferMemoryTrackerImpl buffer_memory_tracker_;
   LibeventScheduler base_scheduler_;
   SchedulerPtr scheduler_;
   TimerPtr deferred_delete_timer_;
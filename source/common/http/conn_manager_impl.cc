@@ -545,6 +545,13 @@ ConnectionManagerImpl::ActiveStream::ActiveStream(ConnectionManagerImpl& connect
 
   stream_info_.setRequestIDExtension(connection_manager.config_.requestIDExtension());
 
+  const Buffer::BufferMemoryAccountSharedPtr connection_account =
+      connection_manager_.read_callbacks_->connection().bufferMemoryAccount();
+  if (connection_account != nullptr) {
+    buffer_memory_account_ =
+        connection_account->createChildAccount(absl::StrCat("stream ", stream_id_));
+  }
+
   if (connection_manager_.config_.isRoutable() &&
       connection_manager.config_.routeConfigProvider() != nullptr) {
     route_config_update_requester_ =
@@ -2322,6 +2329,9 @@ Buffer::WatermarkBufferPtr ConnectionManagerImpl::ActiveStreamDecoderFilter::cre
       [this]() -> void { this->requestDataTooLarge(); },
       []() -> void { /* TODO(adisuissa): Handle overflow watermark */ });
   buffer->setWatermarks(parent_.buffer_limit_);
+  // Charge the buffered body to the stream, and with it to the downstream connection, so that
+  // resetting the connections holding the most memory accounts for it.
+  buffer->bindAccount(parent_.buffer_memory_account_);
   return buffer;
 }
 
@@ -2496,6 +2506,7 @@ Buffer::WatermarkBufferPtr ConnectionManagerImpl::ActiveStreamEncoderFilter::cre
       [this]() -> void { this->responseDataTooLarge(); },
       []() -> void { /* TODO(adisuissa): Handle overflow watermark */ });
   buffer->setWatermarks(parent_.buffer_limit_);
+  buffer->bindAccount(parent_.buffer_memory_account_);
   return Buffer::WatermarkBufferPtr{buffer};
 }
 
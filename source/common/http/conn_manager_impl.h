@@ -708,6 +708,9 @@ private:
     Router::ScopedConfigConstSharedPtr snapped_scoped_routes_config_;
     Tracing::SpanPtr active_span_;
     const uint64_t stream_id_;
+    // Charged for the buffers of the stream's filters, as a part of the downstream connection's
+    // account. Null when the connection has no account.
+    Buffer::BufferMemoryAccountSharedPtr buffer_memory_account_;
     ResponseEncoder* response_encoder_{};
     ResponseHeaderMapPtr continue_headers_;
     ResponseHeaderMapPtr response_headers_;
@@ -19,6 +19,7 @@
 #include "common/http/header_utility.h"
 #include "common/http/headers.h"
 #include "common/http/utility.h"
+#include "common/runtime/runtime_features.h"
 
 #include "absl/container/fixed_array.h"
 
@@ -98,6 +99,22 @@ ConnectionImpl::StreamImpl::StreamImpl(ConnectionImpl& parent, uint32_t buffer_l
   if (buffer_limit > 0) {
     setWriteBufferWatermarks(buffer_limit / 2, buffer_limit);
   }
+  // The data the stream holds on to is charged to the connection carrying it.
+  const Buffer::BufferMemoryAccountSharedPtr account = parent_.connection_.bufferMemoryAccount();
+  pending_recv_data_.bindAccount(account);
+  pending_send_data_.bindAccount(account);
+}
+
+// Strings from the HPACK static table live as long as the process, so they are referenced rather
+// than copied. This covers the names of the most common headers, and values such as GET or 200.
+static void setHeaderString(HeaderString& string, nghttp2_rcbuf* buf) {
+  const nghttp2_vec vec = nghttp2_rcbuf_get_buf(buf);
+  const absl::string_view view(reinterpret_cast<const char*>(vec.base), vec.len);
+  if (nghttp2_rcbuf_is_static(buf)) {
+    string.setReference(view);
+  } else {
+    string.setCopy(view);
+  }
 }
 
 static void insertHeader(std::vector<nghttp2_nv>& headers, const HeaderEntry& header) {
@@ -357,7 +374,8 @@ int ConnectionImpl::StreamImpl::onDataSourceSend(const uint8_t* framehd, size_t
 
   parent_.outbound_data_frames_++;
 
-  Buffer::OwnedImpl output;
+  Buffer::OwnedImpl buffer;
+  Buffer::OwnedImpl& output = parent_.coalesce_writes_ ? parent_.pending_output_ : buffer;
   if (!parent_.addOutboundFrameFragment(output, framehd, FRAME_HEADER_SIZE)) {
     ENVOY_CONN_LOG(debug, "error sending data frame: Too many frames in the outbound queue",
                    parent_.connection_);
@@ -365,7 +383,9 @@ int ConnectionImpl::StreamImpl::onDataSourceSend(const uint8_t* framehd, size_t
   }
 
   output.move(pending_send_data_, length);
-  parent_.connection_.write(output, false);
+  if (!parent_.coalesce_writes_) {
+    parent_.connection_.write(output, false);
+  }
   return 0;
 }
 
@@ -471,6 +491,10 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
           http2_options.max_inbound_priority_frames_per_stream().value()),
       max_inbound_window_update_frames_per_data_frame_sent_(
           http2_options.max_inbound_window_update_frames_per_data_frame_sent().value()),
+      dispatch_without_copy_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http2_dispatch_without_copy")),
+      coalesce_writes_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http2_coalesce_writes")),
       dispatching_(false), raised_goaway_(false), pending_deferred_reset_(false) {}
 
 ConnectionImpl::~ConnectionImpl() { nghttp2_session_del(session_); }
@@ -484,13 +508,22 @@ Http::Status ConnectionImpl::dispatch(Buffer::Instance& data) {
 }
 
 Http::Status ConnectionImpl::innerDispatch(Buffer::Instance& data) {
-  ENVOY_CONN_LOG(trace, "dispatching {} bytes", connection_, data.length());
+  const uint64_t length = data.length();
+  ENVOY_CONN_LOG(trace, "dispatching {} bytes", connection_, length);
   // Make sure that dispatching_ is set to false after dispatching, even when
   // ConnectionImpl::dispatch returns early or throws an exception (consider removing if there is a
   // single return after exception removal (#10878)).
-  Cleanup cleanup([this]() { dispatching_ = false; });
+  Cleanup cleanup([this]() {
+    dispatching_ = false;
+    dispatch_data_ = nullptr;
+  });
   for (const Buffer::RawSlice& slice : data.getRawSlices()) {
     dispatching_ = true;
+    if (dispatch_without_copy_) {
+      dispatch_data_ = &data;
+      dispatch_position_ = static_cast<const uint8_t*>(slice.mem_);
+      dispatch_slice_end_ = dispatch_position_ + slice.len_;
+    }
     ssize_t rc =
         nghttp2_session_mem_recv(session_, static_cast<const uint8_t*>(slice.mem_), slice.len_);
     if (rc == NGHTTP2_ERR_FLOODED || flood_detected_) {
@@ -500,11 +533,15 @@ Http::Status ConnectionImpl::innerDispatch(Buffer::Instance& data) {
     if (rc != static_cast<ssize_t>(slice.len_)) {
       throw CodecProtocolException(fmt::format("{}", nghttp2_strerror(rc)));
     }
+    if (dispatch_data_ != nullptr) {
+      // Drop what is left of the slice so that the next slice is at the front of the buffer.
+      data.drain(dispatch_slice_end_ - dispatch_position_);
+    }
 
     dispatching_ = false;
   }
 
-  ENVOY_CONN_LOG(trace, "dispatched {} bytes", connection_, data.length());
+  ENVOY_CONN_LOG(trace, "dispatched {} bytes", connection_, length);
   data.drain(data.length());
 
   // Decoding incoming frames can generate outbound frames so flush pending.
@@ -520,7 +557,15 @@ int ConnectionImpl::onData(int32_t stream_id, const uint8_t* data, size_t len) {
   StreamImpl* stream = getStream(stream_id);
   // If this results in buffering too much data, the watermark buffer will call
   // pendingRecvBufferHighWatermark, resulting in ++read_disable_count_
-  stream->pending_recv_data_.add(data, len);
+  if (dispatch_data_ != nullptr && data >= dispatch_position_ &&
+      data + len <= dispatch_slice_end_) {
+    // The payload points into the buffer being dispatched: move it instead of copying it.
+    dispatch_data_->drain(data - dispatch_position_);
+    stream->pending_recv_data_.moveSharingSlices(*dispatch_data_, len);
+    dispatch_position_ = data + len;
+  } else {
+    stream->pending_recv_data_.add(data, len);
+  }
   // Update the window to the peer unless some consumer of this stream's data has hit a flow control
   // limit and disabled reads on this stream
   if (!stream->buffers_overrun()) {
@@ -762,6 +807,16 @@ bool ConnectionImpl::addOutboundFrameFragment(Buffer::OwnedImpl& output, const u
     return false;
   }
 
+  if (coalesce_writes_) {
+    // The frame is released along with the rest of pending_output_, see writePendingOutput().
+    ++pending_output_frames_;
+    if (is_outbound_flood_monitored_control_frame) {
+      ++pending_output_control_frames_;
+    }
+    output.add(data, length);
+    return true;
+  }
+
   auto fragment = Buffer::OwnedBufferFragmentImpl::create(
       absl::string_view(reinterpret_cast<const char*>(data), length),
       is_outbound_flood_monitored_control_frame ? control_frame_buffer_releasor_
@@ -785,14 +840,43 @@ void ConnectionImpl::releaseOutboundControlFrame(const Buffer::OwnedBufferFragme
   releaseOutboundFrame(fragment);
 }
 
+void ConnectionImpl::writePendingOutput() {
+  if (pending_output_frames_ == 0) {
+    ASSERT(pending_output_.length() == 0);
+    return;
+  }
+
+  // A trailing empty fragment is released once everything before it has been written, at which
+  // point all the frames of this write leave the outbound queue.
+  const uint32_t frames = pending_output_frames_;
+  const uint32_t control_frames = pending_output_control_frames_;
+  pending_output_frames_ = 0;
+  pending_output_control_frames_ = 0;
+  auto fragment = Buffer::OwnedBufferFragmentImpl::create(
+      absl::string_view(),
+      [this, frames, control_frames](const Buffer::OwnedBufferFragmentImpl* fragment) {
+        ASSERT(outbound_frames_ >= frames && outbound_control_frames_ >= control_frames);
+        outbound_frames_ -= frames;
+        outbound_control_frames_ -= control_frames;
+        delete fragment;
+      });
+  pending_output_.addBufferFragment(*fragment.release());
+  connection_.write(pending_output_, false);
+}
+
 ssize_t ConnectionImpl::onSend(const uint8_t* data, size_t length) {
   ENVOY_CONN_LOG(trace, "send data: bytes={}", connection_, length);
   Buffer::OwnedImpl buffer;
-  if (!addOutboundFrameFragment(buffer, data, length)) {
+  Buffer::OwnedImpl& output = coalesce_writes_ ? pending_output_ : buffer;
+  if (!addOutboundFrameFragment(output, data, length)) {
     ENVOY_CONN_LOG(debug, "error sending frame: Too many frames in the outbound queue.",
                    connection_);
     return NGHTTP2_ERR_FLOODED;
   }
+  if (coalesce_writes_) {
+    // Written by sendPendingFrames() once nghttp2 has emitted all pending frames.
+    return length;
+  }
 
   // While the buffer is transient the fragment it contains will be moved into the
   // write_buffer_ of the underlying connection_ by the write method below.
@@ -916,6 +1000,9 @@ void ConnectionImpl::sendPendingFrames() {
   }
 
   const int rc = nghttp2_session_send(session_);
+  if (coalesce_writes_) {
+    writePendingOutput();
+  }
   if (rc != 0) {
     ASSERT(rc == NGHTTP2_ERR_CALLBACK_FAILURE);
     // For errors caused by the pending outbound frame flood the FrameFloodException has
@@ -1037,15 +1124,15 @@ ConnectionImpl::Http2Callbacks::Http2Callbacks() {
         return static_cast<ConnectionImpl*>(user_data)->onBeginHeaders(frame);
       });
 
-  nghttp2_session_callbacks_set_on_header_callback(
+  nghttp2_session_callbacks_set_on_header_callback2(
       callbacks_,
-      [](nghttp2_session*, const nghttp2_frame* frame, const uint8_t* raw_name, size_t name_length,
-         const uint8_t* raw_value, size_t value_length, uint8_t, void* user_data) -> int {
-        // TODO PERF: Can reference count here to avoid copies.
+      [](nghttp2_session*, const nghttp2_frame* frame, nghttp2_rcbuf* raw_name,
+         nghttp2_rcbuf* raw_value, uint8_t, void* user_data) -> int {
+        // TODO PERF: Can reference count dynamic table strings here to avoid copies.
         HeaderString name;
-        name.setCopy(reinterpret_cast<const char*>(raw_name), name_length);
+        setHeaderString(name, raw_name);
         HeaderString value;
-        value.setCopy(reinterpret_cast<const char*>(raw_value), value_length);
+        setHeaderString(value, raw_value);
         return static_cast<ConnectionImpl*>(user_data)->onHeader(frame, std::move(name),
                                                                  std::move(value));
       });
@@ -482,6 +482,23 @@ protected:
   // from corresponding http2_protocol_options. Default value is 10.
   const uint32_t max_inbound_window_update_frames_per_data_frame_sent_;
 
+  // Whether received DATA payloads are moved out of the buffer being dispatched rather than copied.
+  const bool dispatch_without_copy_;
+  // Whether the frames emitted by one nghttp2_session_send() call are copied into pending_output_
+  // and written to the connection together, rather than written one buffer fragment per frame.
+  // The frames of such a write are released from the outbound frame counts once all of it has been
+  // written.
+  const bool coalesce_writes_;
+  Buffer::OwnedImpl pending_output_;
+  uint32_t pending_output_frames_ = 0;
+  uint32_t pending_output_control_frames_ = 0;
+  // While dispatching, the buffer being dispatched, the start of its data and the end of the slice
+  // handed to nghttp2. DATA payloads within the slice are moved out of the buffer after draining
+  // the bytes preceding them.
+  Buffer::Instance* dispatch_data_{};
+  const uint8_t* dispatch_position_{};
+  const uint8_t* dispatch_slice_end_{};
+
   // For the flood mitigation to work the onSend callback must be called once for each outbound
   // frame. This is what the nghttp2 library is doing, however this is not documented. The
   // Http2FloodMitigationTest.* tests in test/integration/http2_integration_test.cc will break if
@@ -515,6 +532,7 @@ private:
 
   void releaseOutboundFrame(const Buffer::OwnedBufferFragmentImpl* fragment);
   void releaseOutboundControlFrame(const Buffer::OwnedBufferFragmentImpl* fragment);
+  void writePendingOutput();
 
   bool dispatching_ : 1;
   bool raised_goaway_ : 1;
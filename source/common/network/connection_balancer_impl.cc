@@ -1,5 +1,10 @@
 #include "common/network/connection_balancer_impl.h"
 
+#include <algorithm>
+#include <thread>
+
+#include "common/common/assert.h"
+
 namespace Envoy {
 namespace Network {
 
@@ -34,5 +39,110 @@ ExactConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler&) {
   return *min_connection_handler;
 }
 
+TwoChoiceConnectionBalancerImpl::TwoChoiceConnectionBalancerImpl(Runtime::RandomGenerator& random,
+                                                                 uint32_t max_handlers)
+    : random_(random), max_handlers_(max_handlers),
+      entries_(std::make_unique<HandlerEntry[]>(max_handlers)) {
+  // Hand out the lowest index first.
+  free_indices_.reserve(max_handlers);
+  for (uint32_t index = max_handlers; index > 0; index--) {
+    free_indices_.push_back(index - 1);
+  }
+}
+
+void TwoChoiceConnectionBalancerImpl::registerHandler(BalancedConnectionHandler& handler) {
+  uint64_t generation;
+  {
+    absl::MutexLock lock(&lock_);
+    RELEASE_ASSERT(!free_indices_.empty(), "too many handlers registered with connection balancer");
+    handler.setBalancerIndex(free_indices_.back());
+    free_indices_.pop_back();
+    auto new_handlers = current_list_ != nullptr ? std::make_unique<HandlerList>(*current_list_)
+                                                 : std::make_unique<HandlerList>();
+    new_handlers->push_back(&handler);
+    generation = publish(std::move(new_handlers));
+  }
+  retire(generation, absl::nullopt);
+}
+
+void TwoChoiceConnectionBalancerImpl::unregisterHandler(BalancedConnectionHandler& handler) {
+  uint64_t generation;
+  {
+    absl::MutexLock lock(&lock_);
+    if (current_list_ == nullptr) {
+      return;
+    }
+    auto new_handlers = std::make_unique<HandlerList>();
+    for (BalancedConnectionHandler* registered_handler : *current_list_) {
+      if (registered_handler != &handler) {
+        new_handlers->push_back(registered_handler);
+      }
+    }
+    ASSERT(new_handlers->size() + 1 == current_list_->size());
+    generation = publish(std::move(new_handlers));
+  }
+  // The handler may be destroyed once this returns, so this waits for the picks which may still
+  // see it in the previous list.
+  retire(generation, handler.balancerIndex());
+}
+
+uint64_t TwoChoiceConnectionBalancerImpl::publish(std::unique_ptr<const HandlerList>&& handlers) {
+  handlers_.store(handlers.get());
+  generation_++;
+  if (current_list_ != nullptr) {
+    retired_lists_.emplace_back(generation_, std::move(current_list_));
+  }
+  current_list_ = std::move(handlers);
+  return generation_;
+}
+
+void TwoChoiceConnectionBalancerImpl::retire(uint64_t generation,
+                                             absl::optional<uint32_t> removed_index) {
+  // A pick marks the entry of its handler before reading the list it picks from, so any pick which
+  // is not marked here reads the list just published or a newer one. The wait happens without
+  // holding the lock, so accepts are never blocked on it. Entries are never freed, so reading the
+  // entry of a handler unregistered meanwhile is safe. The removed handler itself is not picking,
+  // as handlers are unregistered by their own worker.
+  for (uint32_t index = 0; index < max_handlers_; index++) {
+    const std::atomic<uint64_t>& picks = entries_[index].picks_;
+    const uint64_t marked_picks = picks.load();
+    while (marked_picks % 2 == 1 && picks.load() == marked_picks) {
+      std::this_thread::yield();
+    }
+  }
+
+  absl::MutexLock lock(&lock_);
+  retired_lists_.erase(
+      std::remove_if(retired_lists_.begin(), retired_lists_.end(),
+                     [generation](const auto& retired) { return retired.first <= generation; }),
+      retired_lists_.end());
+  if (removed_index.has_value()) {
+    free_indices_.push_back(removed_index.value());
+  }
+}
+
+BalancedConnectionHandler&
+TwoChoiceConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler& current_handler) {
+  ASSERT(current_handler.balancerIndex() < max_handlers_);
+  std::atomic<uint64_t>& picks = entries_[current_handler.balancerIndex()].picks_;
+  picks.store(picks.load(std::memory_order_relaxed) + 1);
+  const HandlerList* handlers = handlers_.load();
+  ASSERT(handlers != nullptr);
+
+  BalancedConnectionHandler* target_handler = &current_handler;
+  if (handlers->size() > 1) {
+    // The current handler is always one of the two choices. This keeps the connection on the
+    // accepting thread, avoiding a cross-thread transfer, unless the other choice is less loaded.
+    BalancedConnectionHandler* other_handler = (*handlers)[random_.random() % handlers->size()];
+    if (other_handler->numConnections() < current_handler.numConnections()) {
+      target_handler = other_handler;
+    }
+  }
+  target_handler->incNumConnections();
+
+  picks.store(picks.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  return *target_handler;
+}
+
 } // namespace Network
 } // namespace Envoy
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include "envoy/network/connection_balancer.h"
+#include "envoy/runtime/runtime.h"
 
 #include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Network {
@@ -27,6 +33,65 @@ private:
   std::vector<BalancedConnectionHandler*> handlers_ GUARDED_BY(lock_);
 };
 
+/**
+ * Implementation of connection balancer that uses the power of two choices. The connection is
+ * compared between the current handler and one other handler picked at random, and is moved only if
+ * the other handler has fewer connections. Picking reads an immutable list of the handlers without
+ * taking a lock, so accepts on different handlers do not contend the way they do in
+ * ExactConnectionBalancerImpl. Balance is approximate, but converges quickly under connection
+ * churn, which makes this balancer a better fit for busy listeners with many handlers.
+ */
+class TwoChoiceConnectionBalancerImpl : public ConnectionBalancer {
+public:
+  /**
+   * @param random supplies the random generator picking the other choice.
+   * @param max_handlers supplies the largest number of handlers registered at once, typically the
+   *        number of workers.
+   */
+  TwoChoiceConnectionBalancerImpl(Runtime::RandomGenerator& random, uint32_t max_handlers);
+
+  // ConnectionBalancer
+  void registerHandler(BalancedConnectionHandler& handler) override;
+  void unregisterHandler(BalancedConnectionHandler& handler) override;
+  BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler) override;
+
+private:
+  // The state of a registered handler, at the handler's balancer index. picks_ is odd while the
+  // handler's worker is picking a target, and is only written by that worker. Entries are aligned
+  // to cache lines so that accepts on different workers share no written cache line.
+  struct alignas(64) HandlerEntry {
+    std::atomic<uint64_t> picks_{0};
+  };
+  using HandlerList = std::vector<BalancedConnectionHandler*>;
+
+  // Makes the given list the one picks read from, and retires the previous one.
+  // @return the generation of the published list.
+  uint64_t publish(std::unique_ptr<const HandlerList>&& handlers)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Waits for the picks which may have read a list older than the given generation, then frees
+  // those lists and, if given, makes the index of the removed handler available again.
+  void retire(uint64_t generation, absl::optional<uint32_t> removed_index)
+      ABSL_LOCKS_EXCLUDED(lock_);
+
+  Runtime::RandomGenerator& random_;
+  // Entries are never reallocated, so the accept path reaches the entry of the accepting handler
+  // by its index without taking a lock. An index is only reused once no pick can see its previous
+  // handler.
+  const uint32_t max_handlers_;
+  const std::unique_ptr<HandlerEntry[]> entries_;
+  // Handlers only change when a listener is added to or removed from a worker. Each change
+  // publishes a new list, and the accept path reads the current list without taking a lock. A
+  // replaced list is retired, and freed once the picks which may still read it have completed.
+  absl::Mutex lock_;
+  std::vector<uint32_t> free_indices_ GUARDED_BY(lock_);
+  std::unique_ptr<const HandlerList> current_list_ GUARDED_BY(lock_);
+  uint64_t generation_ GUARDED_BY(lock_){};
+  // Retired lists with the generation of the list replacing them.
+  std::vector<std::pair<uint64_t, std::unique_ptr<const HandlerList>>>
+      retired_lists_ GUARDED_BY(lock_);
+  std::atomic<const HandlerList*> handlers_{};
+};
+
 /**
  * A NOP connection balancer implementation that always continues execution after incrementing
  * the handler's connection count.
@@ -18,6 +18,8 @@
 #include "common/network/raw_buffer_socket.h"
 #include "common/network/utility.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Network {
 
@@ -54,6 +56,11 @@ ConnectionImpl::ConnectionImpl(Event::Dispatcher& dispatcher, ConnectionSocketPt
           [this]() -> void { this->onWriteBufferLowWatermark(); },
           [this]() -> void { this->onWriteBufferHighWatermark(); },
           []() -> void { /* TODO(adisuissa): Handle overflow watermark */ })),
+      // Charge the bytes buffered by the connection to an account of the dispatcher, so that the
+      // overload manager can close the connections holding the most memory.
+      buffer_memory_account_(dispatcher.bufferMemoryTracker().createAccount(
+          absl::StrCat("connection ", id()),
+          [this]() -> void { close(ConnectionCloseType::NoFlush); })),
       write_buffer_above_high_watermark_(false), detect_early_close_(true),
       enable_half_close_(false), read_end_stream_raised_(false), read_end_stream_(false),
       write_end_stream_(false), current_write_end_stream_(false), dispatch_buffered_data_(false) {
@@ -61,6 +68,9 @@ ConnectionImpl::ConnectionImpl(Event::Dispatcher& dispatcher, ConnectionSocketPt
   // condition and just crash.
   RELEASE_ASSERT(SOCKET_VALID(ConnectionImpl::ioHandle().fd()), "");
 
+  read_buffer_.bindAccount(buffer_memory_account_);
+  write_buffer_->bindAccount(buffer_memory_account_);
+
   if (!connected) {
     connecting_ = true;
   }
@@ -218,6 +228,14 @@ void ConnectionImpl::closeSocket(ConnectionEvent close_type) {
   // connection outlasting the subscriber.
   write_buffer_->drain(write_buffer_->length());
 
+  // Whatever is left in the read buffer is released along with the connection, stop charging it so
+  // that memory pressure resets pick connections which are still open. The buffers of the streams
+  // carried by the connection may keep charging the account until they are destroyed, possibly
+  // after the connection, so the account must not be reset from now on.
+  read_buffer_.bindAccount(nullptr);
+  write_buffer_->bindAccount(nullptr);
+  buffer_memory_account_->clearResetCallback();
+
   connection_stats_.reset();
 
   file_event_.reset();
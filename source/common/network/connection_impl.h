@@ -83,6 +83,9 @@ public:
   uint32_t bufferLimit() const override { return read_buffer_limit_; }
   bool localAddressRestored() const override { return socket_->localAddressRestored(); }
   bool aboveHighWatermark() const override { return write_buffer_above_high_watermark_; }
+  Buffer::BufferMemoryAccountSharedPtr bufferMemoryAccount() const override {
+    return buffer_memory_account_;
+  }
   const ConnectionSocket::OptionsSharedPtr& socketOptions() const override {
     return socket_->options();
   }
@@ -154,6 +157,7 @@ protected:
   // It MUST be defined after the filter_manager_ as some filters may have callbacks that
   // write_buffer_ invokes during its clean up.
   Buffer::InstancePtr write_buffer_;
+  const Buffer::BufferMemoryAccountSharedPtr buffer_memory_account_;
   uint32_t read_buffer_limit_ = 0;
   bool connecting_{false};
   ConnectionEvent immediate_error_event_{ConnectionEvent::Connected};
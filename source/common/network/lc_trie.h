@@ -190,6 +190,26 @@ public:
     }
   }
 
+  /**
+   * Retrieve the data associated with the CIDR range that contains `ip_address` without copying
+   * it, for lookups on the hot path. This is meant for tries built with `exclusive` set, holding
+   * one datum per CIDR range; when several data match, an arbitrary one of them is returned.
+   * @param  ip_address supplies the IP address.
+   * @return a pointer to the data, which lives as long as the trie, or nullptr if no prefix
+   * contains 'ip_address' or there is no data for the IP version of the ip_address.
+   */
+  const T* getFirstData(const Network::Address::InstanceConstSharedPtr& ip_address) const {
+    const DataSet* data;
+    if (ip_address->ip()->version() == Address::IpVersion::v4) {
+      Ipv4 ip = ntohl(ip_address->ip()->ipv4()->address());
+      data = ipv4_trie_->getDataSet(ip);
+    } else {
+      Ipv6 ip = Utility::Ip6ntohl(ip_address->ip()->ipv6()->address());
+      data = ipv6_trie_->getDataSet(ip);
+    }
+    return data == nullptr || data->empty() ? nullptr : &*data->begin();
+  }
+
 private:
   /**
    * Extract n bits from input starting at position p.
@@ -432,6 +452,14 @@ private:
      */
     std::vector<T> getData(const IpType& ip_address) const;
 
+    /**
+     * Retrieve the data associated with the CIDR range that contains `ip_address`.
+     * @param  ip_address supplies the IP address in host byte order.
+     * @return a pointer to the data of the CIDR range that encompasses the input, or nullptr if
+     * there is no such range.
+     */
+    const DataSet* getDataSet(const IpType& ip_address) const;
+
   private:
     /**
      * Builds the Level Compressed Trie, by first sorting the data, removing duplicated
@@ -709,9 +737,19 @@ template <class T>
 template <class IpType, uint32_t address_size>
 std::vector<T>
 LcTrie<T>::LcTrieInternal<IpType, address_size>::getData(const IpType& ip_address) const {
-  std::vector<T> return_vector;
+  const DataSet* data = getDataSet(ip_address);
+  if (data == nullptr) {
+    return std::vector<T>();
+  }
+  return std::vector<T>(data->begin(), data->end());
+}
+
+template <class T>
+template <class IpType, uint32_t address_size>
+const typename LcTrie<T>::DataSet*
+LcTrie<T>::LcTrieInternal<IpType, address_size>::getDataSet(const IpType& ip_address) const {
   if (trie_.empty()) {
-    return return_vector;
+    return nullptr;
   }
 
   LcNode node = trie_[0];
@@ -735,9 +773,9 @@ LcTrie<T>::LcTrieInternal<IpType, address_size>::getData(const IpType& ip_addres
   // ip_address.
   const auto& prefix = ip_prefixes_[address];
   if (prefix.contains(ip_address)) {
-    return std::vector<T>(prefix.data_.begin(), prefix.data_.end());
+    return &prefix.data_;
   }
-  return std::vector<T>();
+  return nullptr;
 }
 
 } // namespace LcTrie
@@ -1,13 +1,26 @@
 #include "common/network/raw_buffer_socket.h"
 
+#include <algorithm>
+
 #include "common/api/os_sys_calls_impl.h"
 #include "common/common/assert.h"
 #include "common/common/empty_string.h"
 #include "common/http/headers.h"
+#include "common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Network {
 
+RawBufferSocket::RawBufferSocket()
+    : adaptive_read_size_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.raw_buffer_adaptive_read_size")) {
+  if (ZeroCopySender::supported() &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.raw_buffer_zero_copy_send")) {
+    zero_copy_sender_ = std::make_unique<ZeroCopySender>(
+        Runtime::getInteger("envoy.network.zero_copy_send_min_slice_size", 16384));
+  }
+}
+
 void RawBufferSocket::setTransportSocketCallbacks(TransportSocketCallbacks& callbacks) {
   ASSERT(!callbacks_);
   callbacks_ = &callbacks;
@@ -18,8 +31,8 @@ IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
   uint64_t bytes_read = 0;
   bool end_stream = false;
   do {
-    // 16K read is arbitrary. TODO(mattklein123) PERF: Tune the read size.
-    Api::IoCallUint64Result result = buffer.read(callbacks_->ioHandle(), 16384);
+    const uint64_t max_length = nextReadSize(buffer);
+    Api::IoCallUint64Result result = buffer.read(callbacks_->ioHandle(), max_length);
 
     if (result.ok()) {
       ENVOY_CONN_LOG(trace, "read returns: {}", callbacks_->connection(), result.rc_);
@@ -29,6 +42,7 @@ IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
         break;
       }
       bytes_read += result.rc_;
+      growReadSize(result.rc_, max_length);
       if (callbacks_->shouldDrainReadBuffer()) {
         callbacks_->setReadBufferReady();
         break;
@@ -44,15 +58,50 @@ IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
     }
   } while (true);
 
+  shrinkReadSize(bytes_read);
   return {action, bytes_read, end_stream};
 }
 
+uint64_t RawBufferSocket::nextReadSize(const Buffer::Instance& buffer) const {
+  if (!adaptive_read_size_) {
+    return DefaultReadSize;
+  }
+  // The read buffer limit is soft: a read may start as long as the buffer is below the limit. Don't
+  // let a grown read size overshoot it by more than a default sized read would.
+  const uint64_t limit = callbacks_->connection().bufferLimit();
+  if (limit > 0) {
+    const uint64_t room = limit > buffer.length() ? limit - buffer.length() : 0;
+    return std::min(read_size_, std::max(room, DefaultReadSize));
+  }
+  return read_size_;
+}
+
+void RawBufferSocket::growReadSize(uint64_t bytes_read, uint64_t max_length) {
+  // A read filling the whole read size means there was at least as much data queued, so read more
+  // at a time. A read cut short by the buffer limit says nothing about the socket.
+  if (adaptive_read_size_ && max_length == read_size_ && bytes_read == max_length) {
+    read_size_ = std::min(read_size_ * 2, MaxReadSize);
+  }
+}
+
+void RawBufferSocket::shrinkReadSize(uint64_t bytes_read) {
+  // Decided once per read event rather than per read, as the last read before EAGAIN is usually
+  // short even while the peer keeps the socket busy.
+  if (adaptive_read_size_ && bytes_read < read_size_ / 4) {
+    read_size_ = std::max(read_size_ / 2, MinReadSize);
+  }
+}
+
 IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
   PostIoAction action;
   uint64_t bytes_written = 0;
-  ASSERT(!shutdown_ || buffer.length() == 0);
+  if (zero_copy_sender_ != nullptr) {
+    zero_copy_sender_->releaseCompleted(callbacks_->ioHandle(), buffer);
+  }
+  ASSERT(!shutdown_ || buffer.length() == bytesInFlight());
   do {
-    if (buffer.length() == 0) {
+    // Data in flight is already queued on the socket, ahead of any FIN.
+    if (buffer.length() == bytesInFlight()) {
       if (end_stream && !shutdown_) {
         // Ignore the result. This can only fail if the connection failed. In that case, the
         // error will be detected on the next read, and dealt with appropriately.
@@ -62,7 +111,9 @@ IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
       action = PostIoAction::KeepOpen;
       break;
     }
-    Api::IoCallUint64Result result = buffer.write(callbacks_->ioHandle());
+    Api::IoCallUint64Result result = zero_copy_sender_ != nullptr
+                                         ? zero_copy_sender_->write(callbacks_->ioHandle(), buffer)
+                                         : buffer.write(callbacks_->ioHandle());
 
     if (result.ok()) {
       ENVOY_CONN_LOG(trace, "write returns: {}", callbacks_->connection(), result.rc_);
@@ -82,6 +133,17 @@ IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
   return {action, bytes_written, false};
 }
 
+uint64_t RawBufferSocket::bytesInFlight() const {
+  return zero_copy_sender_ != nullptr ? zero_copy_sender_->bytesInFlight() : 0;
+}
+
+void RawBufferSocket::closeSocket(Network::ConnectionEvent) {
+  if (zero_copy_sender_ != nullptr) {
+    // The connection frees the write buffer right after this.
+    zero_copy_sender_->abortInFlight(callbacks_->ioHandle());
+  }
+}
+
 std::string RawBufferSocket::protocol() const { return EMPTY_STRING; }
 absl::string_view RawBufferSocket::failureReason() const { return EMPTY_STRING; }
 
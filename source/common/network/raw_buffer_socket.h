@@ -5,26 +5,44 @@
 #include "envoy/network/transport_socket.h"
 
 #include "common/common/logger.h"
+#include "common/network/zero_copy_sender.h"
 
 namespace Envoy {
 namespace Network {
 
 class RawBufferSocket : public TransportSocket, protected Logger::Loggable<Logger::Id::connection> {
 public:
+  RawBufferSocket();
+
   // Network::TransportSocket
   void setTransportSocketCallbacks(TransportSocketCallbacks& callbacks) override;
   std::string protocol() const override;
   absl::string_view failureReason() const override;
   bool canFlushClose() override { return true; }
-  void closeSocket(Network::ConnectionEvent) override {}
+  void closeSocket(Network::ConnectionEvent) override;
   void onConnected() override;
   IoResult doRead(Buffer::Instance& buffer) override;
   IoResult doWrite(Buffer::Instance& buffer, bool end_stream) override;
   Ssl::ConnectionInfoConstSharedPtr ssl() const override { return nullptr; }
 
 private:
+  // Bounds of the adaptive read size. Reads start at the default size, grow while each read fills
+  // the space it was given and shrink again while read events bring little data.
+  static constexpr uint64_t DefaultReadSize = 16384;
+  static constexpr uint64_t MinReadSize = 4096;
+  static constexpr uint64_t MaxReadSize = 262144;
+
+  uint64_t nextReadSize(const Buffer::Instance& buffer) const;
+  void growReadSize(uint64_t bytes_read, uint64_t max_length);
+  void shrinkReadSize(uint64_t bytes_read);
+  uint64_t bytesInFlight() const;
+
   TransportSocketCallbacks* callbacks_{};
   bool shutdown_{};
+  const bool adaptive_read_size_;
+  uint64_t read_size_{DefaultReadSize};
+  // Set when large slices are sent with MSG_ZEROCOPY.
+  std::unique_ptr<ZeroCopySender> zero_copy_sender_;
 };
 
 class RawBufferSocketFactory : public TransportSocketFactory {
@@ -0,0 +1,72 @@
+#include "common/network/reuse_port_cpu_steering_socket_option_impl.h"
+
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
+#include "envoy/config/core/v3/base.pb.h"
+
+#include "common/common/assert.h"
+
+namespace Envoy {
+namespace Network {
+
+bool ReusePortCpuSteeringSocketOptionImpl::setOption(
+    Socket& socket, envoy::config::core::v3::SocketOption::SocketState state) const {
+  // The SO_REUSEPORT group only exists once the socket is bound.
+  if (state != envoy::config::core::v3::SocketOption::STATE_BOUND) {
+    return true;
+  }
+
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  // The kernel copies the program during setsockopt(), so it can live on the stack. If the
+  // returned index is out of range, e.g. while sockets are being added to the group, the kernel
+  // falls back to hashing the 4-tuple.
+  // SPELLCHECKER(off)
+  sock_filter filter[] = {
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)}, // ld cpu
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0, socket_count_}, // mod #socket_count
+      {BPF_RET | BPF_A, 0, 0, 0},                        // ret a
+  };
+  // SPELLCHECKER(on)
+  sock_fprog prog;
+  prog.len = sizeof(filter) / sizeof(filter[0]);
+  prog.filter = filter;
+
+  const Api::SysCallIntResult result = SocketOptionImpl::setSocketOption(
+      socket, ENVOY_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog));
+  if (result.rc_ != 0) {
+    ENVOY_LOG(warn, "Attaching reuse port CPU steering program on socket failed: {}",
+              strerror(result.errno_));
+    return false;
+  }
+  return true;
+#else
+  UNREFERENCED_PARAMETER(socket);
+  ENVOY_LOG(warn, "Failed to set unsupported reuse port CPU steering option on socket");
+  return false;
+#endif
+}
+
+absl::optional<Socket::Option::Details> ReusePortCpuSteeringSocketOptionImpl::getOptionDetails(
+    const Socket&, envoy::config::core::v3::SocketOption::SocketState state) const {
+  if (state != envoy::config::core::v3::SocketOption::STATE_BOUND || !isSupported()) {
+    return absl::nullopt;
+  }
+
+  Socket::Option::Details info;
+  info.name_ = ENVOY_ATTACH_REUSEPORT_CBPF;
+  info.value_ = std::to_string(socket_count_);
+  return absl::make_optional(std::move(info));
+}
+
+bool ReusePortCpuSteeringSocketOptionImpl::isSupported() {
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace Network
+} // namespace Envoy
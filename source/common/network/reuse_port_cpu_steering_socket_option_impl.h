@@ -0,0 +1,47 @@
+#pragma once
+
+#include "envoy/config/core/v3/base.pb.h"
+#include "envoy/network/listen_socket.h"
+
+#include "common/common/logger.h"
+#include "common/network/socket_option_impl.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * Socket option that attaches a classic BPF program to the SO_REUSEPORT group of a bound listen
+ * socket. The program steers each new connection to the socket at index (cpu % socket_count) of
+ * the group, where cpu is the CPU that processed the incoming SYN. The index is the order in which
+ * sockets joined the group, so the sockets must be created in worker order for it to select a
+ * worker, see ListenSocketFactoryImpl.
+ */
+class ReusePortCpuSteeringSocketOptionImpl : public Socket::Option,
+                                             Logger::Loggable<Logger::Id::connection> {
+public:
+  ReusePortCpuSteeringSocketOptionImpl(uint32_t socket_count) : socket_count_(socket_count) {
+    ASSERT(socket_count_ > 0);
+  }
+
+  // Socket::Option
+  bool setOption(Socket& socket,
+                 envoy::config::core::v3::SocketOption::SocketState state) const override;
+  // The program only depends on the socket count which is the same for every listen socket.
+  void hashKey(std::vector<uint8_t>&) const override {}
+  absl::optional<Details>
+  getOptionDetails(const Socket& socket,
+                   envoy::config::core::v3::SocketOption::SocketState state) const override;
+
+  /**
+   * @return true if attaching a reuse port BPF program is supported on this platform.
+   */
+  static bool isSupported();
+
+private:
+  const uint32_t socket_count_;
+};
+
+} // namespace Network
+} // namespace Envoy
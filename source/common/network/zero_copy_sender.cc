@@ -0,0 +1,204 @@
+#include "common/network/zero_copy_sender.h"
+
+#include <atomic>
+
+#include "envoy/common/platform.h"
+
+#include "common/api/os_sys_calls_impl.h"
+#include "common/common/assert.h"
+#include "common/network/io_socket_error_impl.h"
+
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+#include <linux/errqueue.h>
+#define ENVOY_ZERO_COPY_SEND
+#endif
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+std::atomic<uint64_t> zero_copy_bytes{0};
+std::atomic<uint64_t> zero_copy_copied_bytes{0};
+std::atomic<uint64_t> zero_copy_fallbacks{0};
+
+} // namespace
+
+ZeroCopySender::ZeroCopySender(uint64_t min_slice_size) : min_slice_size_(min_slice_size) {
+  ASSERT(supported());
+}
+
+bool ZeroCopySender::supported() {
+#ifdef ENVOY_ZERO_COPY_SEND
+  return true;
+#else
+  return false;
+#endif
+}
+
+uint64_t ZeroCopySender::totalBytes() { return zero_copy_bytes.load(); }
+uint64_t ZeroCopySender::totalCopiedBytes() { return zero_copy_copied_bytes.load(); }
+uint64_t ZeroCopySender::totalFallbacks() { return zero_copy_fallbacks.load(); }
+
+void ZeroCopySender::releaseCompleted(IoHandle& io_handle, Buffer::Instance& buffer) {
+#ifdef ENVOY_ZERO_COPY_SEND
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+  while (zero_copy_sends_pending_ > 0) {
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    msghdr message{};
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    // Reading the error queue never blocks. It fails with EAGAIN once the queue is empty.
+    if (os_sys_calls.recvmsg(io_handle.fd(), &message, MSG_ERRQUEUE).rc_ < 0) {
+      break;
+    }
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&message, cmsg)) {
+      if (!(cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) &&
+          !(cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+        continue;
+      }
+      const auto* error = reinterpret_cast<const sock_extended_err*>(CMSG_DATA(cmsg));
+      if (error->ee_errno == 0 && error->ee_origin == SO_EE_ORIGIN_ZEROCOPY) {
+        // The kernel coalesces the completions of consecutive sends into one range.
+        onCompletion(error->ee_info, error->ee_data,
+                     (error->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0);
+      }
+    }
+  }
+#else
+  UNREFERENCED_PARAMETER(io_handle);
+#endif
+
+  while (!sends_.empty() && sends_.front().released_) {
+    buffer.drain(sends_.front().length_);
+    bytes_in_flight_ -= sends_.front().length_;
+    sends_.pop_front();
+  }
+}
+
+void ZeroCopySender::onCompletion(uint32_t first_id, uint32_t last_id, bool copied) {
+  for (Send& send : sends_) {
+    // Ids wrap around, so compare distances from the start of the range.
+    if (!send.zero_copy_ || send.released_ ||
+        static_cast<uint32_t>(send.id_ - first_id) > static_cast<uint32_t>(last_id - first_id)) {
+      continue;
+    }
+    send.released_ = true;
+    zero_copy_sends_pending_--;
+    if (copied) {
+      // The kernel copied the data anyway, e.g. for loopback or for devices without scatter-gather
+      // support. Zero copy only adds the cost of the completions on such a socket.
+      zero_copy_copied_bytes += send.length_;
+      enabled_ = false;
+    }
+  }
+}
+
+bool ZeroCopySender::enableOnSocket(IoHandle& io_handle) {
+#ifdef ENVOY_ZERO_COPY_SEND
+  if (!socket_enabled_) {
+    const int enable = 1;
+    socket_enabled_ = Api::OsSysCallsSingleton::get()
+                          .setsockopt(io_handle.fd(), SOL_SOCKET, SO_ZEROCOPY, &enable,
+                                      sizeof(enable))
+                          .rc_ == 0;
+    enabled_ = socket_enabled_;
+  }
+#else
+  UNREFERENCED_PARAMETER(io_handle);
+#endif
+  return socket_enabled_;
+}
+
+Api::IoCallUint64Result ZeroCopySender::write(IoHandle& io_handle, Buffer::Instance& buffer) {
+  // Collect a run of either large or small slices following the data in flight, so that small
+  // slices never wait for zero copy completions to be released.
+  Buffer::RawSlice slices[MaxSlices];
+  uint64_t num_slices = 0;
+  bool zero_copy = false;
+  uint64_t skip = bytes_in_flight_;
+  for (const Buffer::RawSlice& raw_slice : buffer.getRawSlices()) {
+    if (skip >= raw_slice.len_) {
+      skip -= raw_slice.len_;
+      continue;
+    }
+    const Buffer::RawSlice slice{static_cast<uint8_t*>(raw_slice.mem_) + skip,
+                                 raw_slice.len_ - skip};
+    skip = 0;
+    const bool large = enabled_ && slice.len_ >= min_slice_size_;
+    if (num_slices > 0 && large != zero_copy) {
+      break;
+    }
+    zero_copy = large;
+    slices[num_slices++] = slice;
+    if (num_slices == MaxSlices) {
+      break;
+    }
+  }
+  if (num_slices == 0) {
+    return Api::ioCallUint64ResultNoError();
+  }
+
+#ifdef ENVOY_ZERO_COPY_SEND
+  if (zero_copy && enableOnSocket(io_handle)) {
+    iovec iov[MaxSlices];
+    for (uint64_t i = 0; i < num_slices; i++) {
+      iov[i].iov_base = slices[i].mem_;
+      iov[i].iov_len = slices[i].len_;
+    }
+    msghdr message{};
+    message.msg_iov = iov;
+    message.msg_iovlen = num_slices;
+    const Api::SysCallSizeResult result =
+        Api::OsSysCallsSingleton::get().sendmsg(io_handle.fd(), &message, MSG_ZEROCOPY);
+    if (result.rc_ > 0) {
+      sends_.push_back({static_cast<uint64_t>(result.rc_), next_id_++, true, false});
+      zero_copy_sends_pending_++;
+      bytes_in_flight_ += result.rc_;
+      zero_copy_bytes += result.rc_;
+      return Api::IoCallUint64Result(result.rc_,
+                                     Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError));
+    }
+    if (result.rc_ < 0 && result.errno_ != ENOBUFS) {
+      return Api::IoCallUint64Result(
+          0, (result.errno_ == EAGAIN
+                  ? Api::IoErrorPtr(IoSocketError::getIoSocketEagainInstance(),
+                                    IoSocketError::deleteIoError)
+                  : Api::IoErrorPtr(new IoSocketError(result.errno_),
+                                    IoSocketError::deleteIoError)));
+    }
+    // ENOBUFS means the socket is out of memory to track completions or the process is out of
+    // lockable memory. Copy this run instead.
+  }
+  if (zero_copy) {
+    zero_copy_fallbacks++;
+  }
+#endif
+
+  Api::IoCallUint64Result result = io_handle.writev(slices, num_slices);
+  if (result.ok() && result.rc_ > 0) {
+    if (sends_.empty()) {
+      buffer.drain(result.rc_);
+    } else {
+      // Keep the buffer in order, this data is drained once the data ahead of it is released.
+      sends_.push_back({result.rc_, 0, false, true});
+      bytes_in_flight_ += result.rc_;
+    }
+  }
+  return result;
+}
+
+void ZeroCopySender::abortInFlight(IoHandle& io_handle) {
+#ifdef ENVOY_ZERO_COPY_SEND
+  if (zero_copy_sends_pending_ > 0) {
+    const linger reset{1, 0};
+    Api::OsSysCallsSingleton::get().setsockopt(io_handle.fd(), SOL_SOCKET, SO_LINGER, &reset,
+                                               sizeof(reset));
+  }
+#else
+  UNREFERENCED_PARAMETER(io_handle);
+#endif
+}
+
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+#include "envoy/api/io_error.h"
+#include "envoy/buffer/buffer.h"
+#include "envoy/network/io_handle.h"
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * Sends the large slices of a connection's write buffer with MSG_ZEROCOPY. The kernel transmits
+ * such data straight from the buffer's memory, so the data stays at the front of the buffer,
+ * unmodified, until the kernel reports on the socket error queue that it no longer needs it. Data
+ * sent but not yet released by the kernel is in flight. Buffer fragments are released only once
+ * the kernel is done with them. Small slices, and sends the kernel refuses with ENOBUFS, are
+ * copied into the socket as usual.
+ */
+class ZeroCopySender {
+public:
+  /**
+   * @param min_slice_size the smallest slice sent without copying.
+   */
+  explicit ZeroCopySender(uint64_t min_slice_size);
+
+  /**
+   * @return whether this platform supports zero copy sends.
+   */
+  static bool supported();
+
+  /**
+   * Reads the completions from the socket error queue and drains the data the kernel released
+   * from the front of the buffer.
+   */
+  void releaseCompleted(IoHandle& io_handle, Buffer::Instance& buffer);
+
+  /**
+   * Sends the data following the data in flight. Data sent without copying remains in the buffer
+   * until released, data sent by copying is drained once all data ahead of it is released.
+   * @return the result of the send.
+   */
+  Api::IoCallUint64Result write(IoHandle& io_handle, Buffer::Instance& buffer);
+
+  /**
+   * Makes closing the socket reset the connection if data is still in flight, so the kernel stops
+   * sending from buffer memory which is about to be freed.
+   */
+  void abortInFlight(IoHandle& io_handle);
+
+  /**
+   * @return the number of bytes at the front of the buffer which the kernel hasn't released yet.
+   */
+  uint64_t bytesInFlight() const { return bytes_in_flight_; }
+
+  // Process wide totals, published as server stats.
+  static uint64_t totalBytes();
+  static uint64_t totalCopiedBytes();
+  static uint64_t totalFallbacks();
+
+private:
+  // Slices sent by a single syscall, matching Buffer::OwnedImpl::write().
+  static constexpr uint64_t MaxSlices = 16;
+
+  struct Send {
+    uint64_t length_;
+    // The kernel numbers zero copy sends on a socket consecutively, starting at 0.
+    uint32_t id_;
+    bool zero_copy_;
+    bool released_;
+  };
+
+  bool enableOnSocket(IoHandle& io_handle);
+  void onCompletion(uint32_t first_id, uint32_t last_id, bool copied);
+
+  const uint64_t min_slice_size_;
+  // Cleared when the socket doesn't support zero copy sends or the kernel copies them anyway.
+  bool enabled_{true};
+  bool socket_enabled_{};
+  uint32_t next_id_{};
+  uint64_t bytes_in_flight_{};
+  uint64_t zero_copy_sends_pending_{};
+  std::deque<Send> sends_;
+};
+
+} // namespace Network
+} // namespace Envoy
@@ -34,6 +34,7 @@
 #include "common/protobuf/protobuf.h"
 #include "common/protobuf/utility.h"
 #include "common/router/retry_state_impl.h"
+#include "common/runtime/runtime_keys.h"
 #include "common/tracing/http_tracer_impl.h"
 
 #include "extensions/filters/http/common/utility.h"
@@ -545,16 +546,13 @@ void RouteEntryImplBase::finalizeResponseHeaders(Http::ResponseHeaderMap& header
 
 absl::optional<RouteEntryImplBase::RuntimeData>
 RouteEntryImplBase::loadRuntimeData(const envoy::config::route::v3::RouteMatch& route_match) {
-  absl::optional<RuntimeData> runtime;
-  RuntimeData runtime_data;
-
   if (route_match.has_runtime_fraction()) {
-    runtime_data.fractional_runtime_default_ = route_match.runtime_fraction().default_value();
-    runtime_data.fractional_runtime_key_ = route_match.runtime_fraction().runtime_key();
-    return runtime_data;
+    return RuntimeData{
+        Runtime::KeyRegistry::get().registerKey(route_match.runtime_fraction().runtime_key()),
+        route_match.runtime_fraction().default_value()};
   }
 
-  return runtime;
+  return absl::nullopt;
 }
 
 // finalizePathHeaders does the "standard" path rewriting, meaning that it
@@ -555,7 +555,8 @@ protected:
 
 private:
   struct RuntimeData {
-    std::string fractional_runtime_key_{};
+    // Registered, as the route is matched against every request.
+    Runtime::KeyHandle fractional_runtime_key_;
     envoy::type::v3::FractionalPercent fractional_runtime_default_{};
   };
 
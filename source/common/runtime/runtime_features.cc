@@ -61,14 +61,17 @@ constexpr const char* runtime_features[] = {
     "envoy.reloadable_features.reject_unsupported_transfer_encodings",
     // Begin alphabetically sorted section.
     "envoy.deprecated_features.allow_deprecated_extension_names",
+    "envoy.reloadable_features.cds_skip_unchanged_clusters",
     "envoy.reloadable_features.disallow_unbounded_access_logs",
     "envoy.reloadable_features.enable_deprecated_v2_api_warning",
     "envoy.reloadable_features.ext_authz_http_service_enable_case_sensitive_string_matcher",
     "envoy.reloadable_features.fix_upgrade_response",
     "envoy.reloadable_features.fixed_connection_close",
+    "envoy.reloadable_features.http2_dispatch_without_copy",
     "envoy.reloadable_features.listener_in_place_filterchain_update",
-    "envoy.reloadable_features.stop_faking_paths",
+    "envoy.reloadable_features.parallel_xds_decoding",
     "envoy.reloadable_features.preserve_upstream_date",
+    "envoy.reloadable_features.stop_faking_paths",
 };
 
 // This is a section for officially sanctioned runtime features which are too
@@ -82,6 +85,13 @@ constexpr const char* runtime_features[] = {
 constexpr const char* disabled_runtime_features[] = {
     // Sentinel and test flag.
     "envoy.reloadable_features.test_feature_false",
+    "envoy.reloadable_features.batch_health_check_updates",
+    "envoy.reloadable_features.http2_coalesce_writes",
+    "envoy.reloadable_features.lazy_thread_local_load_balancers",
+    "envoy.reloadable_features.raw_buffer_adaptive_read_size",
+    "envoy.reloadable_features.raw_buffer_zero_copy_send",
+    "envoy.reloadable_features.tcp_proxy_lazy_idle_timer",
+    "envoy.reloadable_features.tls_write_from_front_slice",
 };
 
 RuntimeFeatures::RuntimeFeatures() {
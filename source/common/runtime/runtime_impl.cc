@@ -25,6 +25,7 @@
 #include "common/protobuf/message_validator_impl.h"
 #include "common/protobuf/utility.h"
 #include "common/runtime/runtime_features.h"
+#include "common/runtime/runtime_keys.h"
 
 #include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
@@ -212,11 +213,11 @@ bool SnapshotImpl::featureEnabled(absl::string_view key, uint64_t default_value,
 
 Snapshot::ConstStringOptRef SnapshotImpl::get(absl::string_view key) const {
   ASSERT(!isRuntimeFeature(key)); // Make sure runtime guarding is only used for getBoolean
-  auto entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end()) {
+  const Entry* entry = getEntry(key);
+  if (entry == nullptr) {
     return absl::nullopt;
   } else {
-    return entry->second.raw_string_value_;
+    return entry->raw_string_value_;
   }
 }
 
@@ -228,22 +229,79 @@ bool SnapshotImpl::featureEnabled(absl::string_view key,
 bool SnapshotImpl::featureEnabled(absl::string_view key,
                                   const envoy::type::v3::FractionalPercent& default_value,
                                   uint64_t random_value) const {
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
+  return featureEnabled(getEntry(key), default_value, random_value);
+}
+
+uint64_t SnapshotImpl::getInteger(absl::string_view key, uint64_t default_value) const {
+  ASSERT(!isRuntimeFeature(key));
+  return getInteger(getEntry(key), default_value);
+}
+
+double SnapshotImpl::getDouble(absl::string_view key, double default_value) const {
+  ASSERT(!isRuntimeFeature(key)); // Make sure runtime guarding is only used for getBoolean
+  return getDouble(getEntry(key), default_value);
+}
+
+bool SnapshotImpl::getBoolean(absl::string_view key, bool default_value) const {
+  return getBoolean(getEntry(key), default_value);
+}
+
+bool SnapshotImpl::featureEnabled(const KeyHandle& key,
+                                  const envoy::type::v3::FractionalPercent& default_value) const {
+  return featureEnabled(key, default_value, generator_.random());
+}
+
+bool SnapshotImpl::featureEnabled(const KeyHandle& key,
+                                  const envoy::type::v3::FractionalPercent& default_value,
+                                  uint64_t random_value) const {
+  return featureEnabled(getEntry(key), default_value, random_value);
+}
+
+uint64_t SnapshotImpl::getInteger(const KeyHandle& key, uint64_t default_value) const {
+  return getInteger(getEntry(key), default_value);
+}
+
+double SnapshotImpl::getDouble(const KeyHandle& key, double default_value) const {
+  return getDouble(getEntry(key), default_value);
+}
+
+bool SnapshotImpl::getBoolean(const KeyHandle& key, bool default_value) const {
+  return getBoolean(getEntry(key), default_value);
+}
+
+const Snapshot::Entry* SnapshotImpl::getEntry(absl::string_view key) const {
+  if (key.empty()) {
+    return nullptr;
+  }
+  const auto entry = values_.find(key);
+  return entry == values_.end() ? nullptr : &entry->second;
+}
+
+const Snapshot::Entry* SnapshotImpl::getEntry(const KeyHandle& key) const {
+  if (key.index() < registered_entries_.size()) {
+    return registered_entries_[key.index()];
+  }
+  return getEntry(key.key());
+}
+
+bool SnapshotImpl::featureEnabled(const Entry* entry,
+                                  const envoy::type::v3::FractionalPercent& default_value,
+                                  uint64_t random_value) {
   envoy::type::v3::FractionalPercent percent;
-  if (entry != values_.end() && entry->second.fractional_percent_value_.has_value()) {
-    percent = entry->second.fractional_percent_value_.value();
-  } else if (entry != values_.end() && entry->second.uint_value_.has_value()) {
+  if (entry != nullptr && entry->fractional_percent_value_.has_value()) {
+    percent = entry->fractional_percent_value_.value();
+  } else if (entry != nullptr && entry->uint_value_.has_value()) {
     // Check for > 100 because the runtime value is assumed to be specified as
     // an integer, and it also ensures that truncating the uint64_t runtime
     // value into a uint32_t percent numerator later is safe
-    if (entry->second.uint_value_.value() > 100) {
+    if (entry->uint_value_.value() > 100) {
       return true;
     }
 
     // The runtime value was specified as an integer rather than a fractional
     // percent proto. To preserve legacy semantics, we treat it as a percentage
     // (i.e. denominator of 100).
-    percent.set_numerator(entry->second.uint_value_.value());
+    percent.set_numerator(entry->uint_value_.value());
     percent.set_denominator(envoy::type::v3::FractionalPercent::HUNDRED);
   } else {
     percent = default_value;
@@ -252,32 +310,27 @@ bool SnapshotImpl::featureEnabled(absl::string_view key,
   return ProtobufPercentHelper::evaluateFractionalPercent(percent, random_value);
 }
 
-uint64_t SnapshotImpl::getInteger(absl::string_view key, uint64_t default_value) const {
-  ASSERT(!isRuntimeFeature(key));
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.uint_value_) {
+uint64_t SnapshotImpl::getInteger(const Entry* entry, uint64_t default_value) {
+  if (entry == nullptr || !entry->uint_value_) {
     return default_value;
   } else {
-    return entry->second.uint_value_.value();
+    return entry->uint_value_.value();
   }
 }
 
-double SnapshotImpl::getDouble(absl::string_view key, double default_value) const {
-  ASSERT(!isRuntimeFeature(key)); // Make sure runtime guarding is only used for getBoolean
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.double_value_) {
+double SnapshotImpl::getDouble(const Entry* entry, double default_value) {
+  if (entry == nullptr || !entry->double_value_) {
     return default_value;
   } else {
-    return entry->second.double_value_.value();
+    return entry->double_value_.value();
   }
 }
 
-bool SnapshotImpl::getBoolean(absl::string_view key, bool default_value) const {
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.bool_value_.has_value()) {
+bool SnapshotImpl::getBoolean(const Entry* entry, bool default_value) {
+  if (entry == nullptr || !entry->bool_value_.has_value()) {
     return default_value;
   } else {
-    return entry->second.bool_value_.value();
+    return entry->bool_value_.value();
   }
 }
 
@@ -295,6 +348,10 @@ SnapshotImpl::SnapshotImpl(RandomGenerator& generator, RuntimeStats& stats,
     }
   }
   stats.num_keys_.set(values_.size());
+
+  // values_ is not modified from here on, so the entries stay put.
+  KeyRegistry::get().iterate(
+      [this](const std::string& key) { registered_entries_.push_back(getEntry(key)); });
 }
 
 SnapshotImpl::Entry SnapshotImpl::createEntry(const std::string& value) {
@@ -97,6 +97,14 @@ public:
   uint64_t getInteger(absl::string_view key, uint64_t default_value) const override;
   double getDouble(absl::string_view key, double default_value) const override;
   bool getBoolean(absl::string_view key, bool value) const override;
+  bool featureEnabled(const KeyHandle& key,
+                      const envoy::type::v3::FractionalPercent& default_value) const override;
+  bool featureEnabled(const KeyHandle& key,
+                      const envoy::type::v3::FractionalPercent& default_value,
+                      uint64_t random_value) const override;
+  uint64_t getInteger(const KeyHandle& key, uint64_t default_value) const override;
+  double getDouble(const KeyHandle& key, double default_value) const override;
+  bool getBoolean(const KeyHandle& key, bool default_value) const override;
   const std::vector<OverrideLayerConstPtr>& getLayers() const override;
 
   static Entry createEntry(const std::string& value);
@@ -124,8 +132,21 @@ private:
   static bool parseEntryDoubleValue(Entry& entry);
   static void parseEntryFractionalPercentValue(Entry& entry);
 
+  // The lookups take the entry of the key, or nullptr if the key has no value.
+  const Entry* getEntry(absl::string_view key) const;
+  const Entry* getEntry(const KeyHandle& key) const;
+  static bool featureEnabled(const Entry* entry,
+                             const envoy::type::v3::FractionalPercent& default_value,
+                             uint64_t random_value);
+  static uint64_t getInteger(const Entry* entry, uint64_t default_value);
+  static double getDouble(const Entry* entry, double default_value);
+  static bool getBoolean(const Entry* entry, bool default_value);
+
   const std::vector<OverrideLayerConstPtr> layers_;
   EntryMap values_;
+  // The entries of the keys registered with the KeyRegistry when the snapshot was created, by
+  // index. Keys registered later are looked up in values_.
+  std::vector<const Entry*> registered_entries_;
   RandomGenerator& generator_;
   RuntimeStats& stats_;
 };
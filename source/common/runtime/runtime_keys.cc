@@ -0,0 +1,30 @@
+#include "common/runtime/runtime_keys.h"
+
+#include "common/common/macros.h"
+
+namespace Envoy {
+namespace Runtime {
+
+KeyRegistry& KeyRegistry::get() { MUTABLE_CONSTRUCT_ON_FIRST_USE(KeyRegistry); }
+
+KeyHandle KeyRegistry::registerKey(absl::string_view key) {
+  absl::MutexLock lock(&mutex_);
+  auto it = indices_.find(key);
+  if (it != indices_.end()) {
+    return {std::string(key), it->second};
+  }
+  const uint32_t index = keys_.size();
+  keys_.emplace_back(key);
+  indices_.emplace(key, index);
+  return {std::string(key), index};
+}
+
+void KeyRegistry::iterate(const std::function<void(const std::string&)>& cb) const {
+  absl::MutexLock lock(&mutex_);
+  for (const std::string& key : keys_) {
+    cb(key);
+  }
+}
+
+} // namespace Runtime
+} // namespace Envoy
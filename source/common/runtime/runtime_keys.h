@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "envoy/runtime/runtime.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Runtime {
+
+/**
+ * The process wide registry of the runtime keys looked up through a KeyHandle. Each distinct key is
+ * given the next index, and keeps it for the life of the process, so that handles stay valid
+ * across configuration updates. Thread safe.
+ */
+class KeyRegistry {
+public:
+  /**
+   * @return KeyRegistry& the registry indexed by the snapshots.
+   */
+  static KeyRegistry& get();
+
+  /**
+   * @param key supplies the runtime key.
+   * @return KeyHandle the handle of the key, which is registered unless it already was.
+   */
+  KeyHandle registerKey(absl::string_view key);
+
+  /**
+   * Calls the callback with each registered key, in the order of their indices.
+   * @param cb supplies the callback.
+   */
+  void iterate(const std::function<void(const std::string&)>& cb) const;
+
+private:
+  mutable absl::Mutex mutex_;
+  std::vector<std::string> keys_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<std::string, uint32_t> indices_ ABSL_GUARDED_BY(mutex_);
+};
+
+} // namespace Runtime
+} // namespace Envoy
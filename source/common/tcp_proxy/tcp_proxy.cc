@@ -1,5 +1,6 @@
 #include "common/tcp_proxy/tcp_proxy.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -25,6 +26,7 @@
 #include "common/network/transport_socket_options_impl.h"
 #include "common/network/upstream_server_name.h"
 #include "common/router/metadatamatchcriteria_impl.h"
+#include "common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace TcpProxy {
@@ -210,7 +212,9 @@ UpstreamDrainManager& Config::drainManager() {
 
 Filter::Filter(ConfigSharedPtr config, Upstream::ClusterManager& cluster_manager)
     : config_(config), cluster_manager_(cluster_manager), downstream_callbacks_(*this),
-      upstream_callbacks_(new UpstreamCallbacks(this)) {
+      upstream_callbacks_(new UpstreamCallbacks(this)),
+      lazy_idle_timer_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.tcp_proxy_lazy_idle_timer")) {
   ASSERT(config != nullptr);
 }
 
@@ -549,6 +553,11 @@ void Filter::onDownstreamEvent(Network::ConnectionEvent event) {
     Tcp::ConnectionPool::ConnectionDataPtr conn_data(upstream_->onDownstreamEvent(event));
     if (conn_data != nullptr &&
         conn_data->connection().state() != Network::Connection::State::Closed) {
+      if (lazy_idle_timer_ && idle_timer_ != nullptr) {
+        // The drainer only re-arms the timer on upstream writes, so hand it over armed for the
+        // time actually left rather than for a deadline that predates the latest activity.
+        idle_timer_->enableTimer(idleTimeRemaining());
+      }
       config_->drainManager().add(config_->sharedConfig(), std::move(conn_data),
                                   std::move(upstream_callbacks_), std::move(idle_timer_),
                                   read_callbacks_->upstreamHost());
@@ -630,6 +639,15 @@ void Filter::onUpstreamEvent(Network::ConnectionEvent event) {
 }
 
 void Filter::onIdleTimeout() {
+  if (lazy_idle_timer_) {
+    const std::chrono::milliseconds remaining = idleTimeRemaining();
+    if (remaining.count() > 0) {
+      // There was activity since the timer was armed; wait out the rest of the idle period.
+      idle_timer_->enableTimer(remaining);
+      return;
+    }
+  }
+
   ENVOY_CONN_LOG(debug, "Session timed out", read_callbacks_->connection());
   config_->stats().idle_timeout_.inc();
 
@@ -640,10 +658,25 @@ void Filter::onIdleTimeout() {
 void Filter::resetIdleTimer() {
   if (idle_timer_ != nullptr) {
     ASSERT(config_->idleTimeout());
+    if (lazy_idle_timer_) {
+      // Record the activity and let onIdleTimeout() push the deadline out when the timer fires,
+      // instead of re-arming the timer for every chunk of data proxied in either direction.
+      last_activity_ = read_callbacks_->connection().dispatcher().approximateMonotonicTime();
+      if (idle_timer_->enabled()) {
+        return;
+      }
+    }
     idle_timer_->enableTimer(config_->idleTimeout().value());
   }
 }
 
+std::chrono::milliseconds Filter::idleTimeRemaining() {
+  ASSERT(config_->idleTimeout());
+  const auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(
+      read_callbacks_->connection().dispatcher().approximateMonotonicTime() - last_activity_);
+  return std::max(config_->idleTimeout().value() - idle, std::chrono::milliseconds(0));
+}
+
 void Filter::disableIdleTimer() {
   if (idle_timer_ != nullptr) {
     idle_timer_->disableTimer();
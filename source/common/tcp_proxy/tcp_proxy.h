@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -7,6 +8,7 @@
 #include <vector>
 
 #include "envoy/access_log/access_log.h"
+#include "envoy/common/time.h"
 #include "envoy/event/timer.h"
 #include "envoy/extensions/filters/network/tcp_proxy/v3/tcp_proxy.pb.h"
 #include "envoy/network/connection.h"
@@ -360,6 +362,7 @@ protected:
   void onIdleTimeout();
   void resetIdleTimer();
   void disableIdleTimer();
+  std::chrono::milliseconds idleTimeRemaining();
 
   const ConfigSharedPtr config_;
   Upstream::ClusterManager& cluster_manager_;
@@ -376,6 +379,9 @@ protected:
   Network::TransportSocketOptionsSharedPtr transport_socket_options_;
   uint32_t connect_attempts_{};
   bool connecting_{};
+  // When set, activity only updates last_activity_ and the idle timer is re-armed lazily.
+  const bool lazy_idle_timer_;
+  MonotonicTime last_activity_;
 };
 
 // This class deals with an upstream connection that needs to finish flushing, when the downstream
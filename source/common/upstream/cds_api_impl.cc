@@ -1,6 +1,8 @@
 #include "common/upstream/cds_api_impl.h"
 
+#include <algorithm>
 #include <string>
+#include <thread>
 
 #include "envoy/api/v2/cluster.pb.h"
 #include "envoy/config/cluster/v3/cluster.pb.h"
@@ -11,28 +13,39 @@
 
 #include "common/common/assert.h"
 #include "common/common/cleanup.h"
+#include "common/common/hash.h"
 #include "common/common/utility.h"
 #include "common/config/api_version.h"
 #include "common/config/utility.h"
 #include "common/protobuf/utility.h"
+#include "common/runtime/runtime_features.h"
 
 #include "absl/strings/str_join.h"
 
 namespace Envoy {
 namespace Upstream {
 
+namespace {
+// The threads decoding large updates compete with the workers for CPU, so only use a few of them.
+constexpr uint32_t MaxDecodeThreads = 4;
+} // namespace
+
 CdsApiPtr CdsApiImpl::create(const envoy::config::core::v3::ConfigSource& cds_config,
                              ClusterManager& cm, Stats::Scope& scope,
-                             ProtobufMessage::ValidationVisitor& validation_visitor) {
-  return CdsApiPtr{new CdsApiImpl(cds_config, cm, scope, validation_visitor)};
+                             ProtobufMessage::ValidationVisitor& validation_visitor,
+                             Api::Api& api) {
+  return CdsApiPtr{new CdsApiImpl(cds_config, cm, scope, validation_visitor, api)};
 }
 
 CdsApiImpl::CdsApiImpl(const envoy::config::core::v3::ConfigSource& cds_config, ClusterManager& cm,
-                       Stats::Scope& scope, ProtobufMessage::ValidationVisitor& validation_visitor)
+                       Stats::Scope& scope, ProtobufMessage::ValidationVisitor& validation_visitor,
+                       Api::Api& api)
     : Envoy::Config::SubscriptionBase<envoy::config::cluster::v3::Cluster>(
           cds_config.resource_api_version()),
       cm_(cm), scope_(scope.createScope("cluster_manager.cds.")),
-      validation_visitor_(validation_visitor) {
+      validation_visitor_(validation_visitor),
+      decoder_(api.threadFactory(),
+               std::min(std::thread::hardware_concurrency(), MaxDecodeThreads)) {
   const auto resource_name = getResourceName();
   subscription_ = cm_.subscriptionFactory().subscriptionFromConfigSource(
       cds_config, Grpc::Common::typeUrl(resource_name), *scope_, *this);
@@ -40,31 +53,82 @@ CdsApiImpl::CdsApiImpl(const envoy::config::core::v3::ConfigSource& cds_config,
 
 void CdsApiImpl::onConfigUpdate(const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources,
                                 const std::string& version_info) {
+  const bool skip_unchanged =
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.cds_skip_unchanged_clusters");
   ClusterManager::ClusterInfoMap clusters_to_remove = cm_.clusters();
-  std::vector<envoy::config::cluster::v3::Cluster> clusters;
-  for (const auto& cluster_blob : resources) {
-    // No validation needed here the overloaded call to onConfigUpdate validates.
-    clusters.push_back(MessageUtil::anyConvert<envoy::config::cluster::v3::Cluster>(cluster_blob));
-    clusters_to_remove.erase(clusters.back().name());
+  std::vector<const ProtobufWkt::Any*> changed_resources;
+  std::vector<uint64_t> changed_hashes;
+  std::vector<std::string> unchanged_clusters;
+  for (const auto& resource : resources) {
+    const uint64_t hash = resourceHash(resource);
+    if (skip_unchanged) {
+      // The cluster must still exist, and be sent once, to be left as is.
+      const auto applied = applied_names_.find(hash);
+      if (applied != applied_names_.end() && clusters_to_remove.erase(applied->second) > 0) {
+        unchanged_clusters.push_back(applied->second);
+        continue;
+      }
+    }
+    changed_resources.push_back(&resource);
+    changed_hashes.push_back(hash);
+  }
+  const auto clusters = decoder_.decode<envoy::config::cluster::v3::Cluster>(changed_resources);
+  for (const auto& cluster : clusters) {
+    // Validation happens when the clusters are applied.
+    clusters_to_remove.erase(cluster.message().name());
   }
   Protobuf::RepeatedPtrField<std::string> to_remove_repeated;
   for (const auto& cluster : clusters_to_remove) {
     *to_remove_repeated.Add() = cluster.first;
   }
-  Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource> to_add_repeated;
-  for (const auto& cluster : clusters) {
-    envoy::service::discovery::v3::Resource* to_add = to_add_repeated.Add();
-    to_add->set_name(cluster.name());
-    to_add->set_version(version_info);
-    to_add->mutable_resource()->PackFrom(cluster);
-  }
-  onConfigUpdate(to_add_repeated, to_remove_repeated, version_info);
+  applyConfigUpdate(
+      clusters, [&version_info](int) -> const std::string& { return version_info; },
+      changed_hashes, unchanged_clusters, to_remove_repeated, version_info);
 }
 
 void CdsApiImpl::onConfigUpdate(
     const Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource>& added_resources,
     const Protobuf::RepeatedPtrField<std::string>& removed_resources,
     const std::string& system_version_info) {
+  const bool skip_unchanged =
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.cds_skip_unchanged_clusters");
+  absl::optional<ClusterManager::ClusterInfoMap> clusters;
+  std::vector<const envoy::service::discovery::v3::Resource*> changed_resources;
+  std::vector<const ProtobufWkt::Any*> changed_anys;
+  std::vector<uint64_t> changed_hashes;
+  std::vector<std::string> unchanged_clusters;
+  for (const auto& resource : added_resources) {
+    const uint64_t hash = resourceHash(resource.resource());
+    if (skip_unchanged) {
+      const auto applied = applied_hashes_.find(resource.name());
+      if (applied != applied_hashes_.end() && applied->second == hash) {
+        // Only look the clusters up when there is one to skip, as most updates change them all.
+        if (!clusters.has_value()) {
+          clusters = cm_.clusters();
+        }
+        if (clusters->count(resource.name()) > 0) {
+          unchanged_clusters.push_back(resource.name());
+          continue;
+        }
+      }
+    }
+    changed_resources.push_back(&resource);
+    changed_anys.push_back(&resource.resource());
+    changed_hashes.push_back(hash);
+  }
+  applyConfigUpdate(
+      decoder_.decode<envoy::config::cluster::v3::Cluster>(changed_anys),
+      [&changed_resources](int i) -> const std::string& { return changed_resources[i]->version(); },
+      changed_hashes, unchanged_clusters, removed_resources, system_version_info);
+}
+
+void CdsApiImpl::applyConfigUpdate(
+    const std::vector<Config::DecodedResource<envoy::config::cluster::v3::Cluster>>&
+        added_clusters,
+    const std::function<const std::string&(int)>& added_version,
+    const std::vector<uint64_t>& added_hashes, const std::vector<std::string>& unchanged_clusters,
+    const Protobuf::RepeatedPtrField<std::string>& removed_resources,
+    const std::string& system_version_info) {
   std::unique_ptr<Cleanup> maybe_eds_resume;
   if (cm_.adsMux()) {
     const auto type_url = Config::getTypeUrl<envoy::config::endpoint::v3::ClusterLoadAssignment>(
@@ -74,32 +138,37 @@ void CdsApiImpl::onConfigUpdate(
         std::make_unique<Cleanup>([this, type_url] { cm_.adsMux()->resume(type_url); });
   }
 
-  ENVOY_LOG(info, "cds: add {} cluster(s), remove {} cluster(s)", added_resources.size(),
-            removed_resources.size());
+  ENVOY_LOG(info, "cds: add {} cluster(s), remove {} cluster(s), {} cluster(s) unchanged",
+            added_clusters.size(), removed_resources.size(), unchanged_clusters.size());
 
   std::vector<std::string> exception_msgs;
-  std::unordered_set<std::string> cluster_names;
+  std::unordered_set<std::string> cluster_names(unchanged_clusters.begin(),
+                                                unchanged_clusters.end());
   bool any_applied = false;
-  for (const auto& resource : added_resources) {
-    envoy::config::cluster::v3::Cluster cluster;
+  for (size_t i = 0; i < added_clusters.size(); ++i) {
+    // Only set once the cluster is valid, as the name of invalid clusters is not reported.
+    const envoy::config::cluster::v3::Cluster* cluster = nullptr;
     try {
-      cluster = MessageUtil::anyConvertAndValidate<envoy::config::cluster::v3::Cluster>(
-          resource.resource(), validation_visitor_);
-      if (!cluster_names.insert(cluster.name()).second) {
+      cluster = &added_clusters[i].validate(validation_visitor_);
+      if (!cluster_names.insert(cluster->name()).second) {
         // NOTE: at this point, the first of these duplicates has already been successfully applied.
-        throw EnvoyException(fmt::format("duplicate cluster {} found", cluster.name()));
+        throw EnvoyException(fmt::format("duplicate cluster {} found", cluster->name()));
       }
-      if (cm_.addOrUpdateCluster(cluster, resource.version())) {
+      if (cm_.addOrUpdateCluster(*cluster, added_version(i))) {
         any_applied = true;
-        ENVOY_LOG(info, "cds: add/update cluster '{}'", cluster.name());
+        ENVOY_LOG(info, "cds: add/update cluster '{}'", cluster->name());
       } else {
-        ENVOY_LOG(debug, "cds: add/update cluster '{}' skipped", cluster.name());
+        ENVOY_LOG(debug, "cds: add/update cluster '{}' skipped", cluster->name());
       }
+      // Either way, the cluster manager now has this version of the cluster.
+      setAppliedHash(cluster->name(), added_hashes[i]);
     } catch (const EnvoyException& e) {
-      exception_msgs.push_back(fmt::format("{}: {}", cluster.name(), e.what()));
+      exception_msgs.push_back(
+          fmt::format("{}: {}", cluster != nullptr ? cluster->name() : "", e.what()));
     }
   }
   for (const auto& resource_name : removed_resources) {
+    forgetAppliedHash(resource_name);
     if (cm_.removeCluster(resource_name)) {
       any_applied = true;
       ENVOY_LOG(info, "cds: remove cluster '{}'", resource_name);
@@ -116,6 +185,25 @@ void CdsApiImpl::onConfigUpdate(
   }
 }
 
+uint64_t CdsApiImpl::resourceHash(const ProtobufWkt::Any& resource) {
+  // The type is part of the hash as the same bytes may decode differently as v2 and v3 clusters.
+  return HashUtil::xxHash64(resource.value(), HashUtil::xxHash64(resource.type_url()));
+}
+
+void CdsApiImpl::setAppliedHash(const std::string& cluster_name, uint64_t hash) {
+  forgetAppliedHash(cluster_name);
+  applied_hashes_[cluster_name] = hash;
+  applied_names_[hash] = cluster_name;
+}
+
+void CdsApiImpl::forgetAppliedHash(const std::string& cluster_name) {
+  const auto applied = applied_hashes_.find(cluster_name);
+  if (applied != applied_hashes_.end()) {
+    applied_names_.erase(applied->second);
+    applied_hashes_.erase(applied);
+  }
+}
+
 void CdsApiImpl::onConfigUpdateFailed(Envoy::Config::ConfigUpdateFailureReason reason,
                                       const EnvoyException*) {
   ASSERT(Envoy::Config::ConfigUpdateFailureReason::ConnectionFailure != reason);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <functional>
+#include <string>
+#include <vector>
 
 #include "envoy/api/api.h"
 #include "envoy/config/cluster/v3/cluster.pb.h"
@@ -13,8 +15,11 @@
 #include "envoy/upstream/cluster_manager.h"
 
 #include "common/common/logger.h"
+#include "common/config/parallel_decoder.h"
 #include "common/config/subscription_base.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -27,7 +32,7 @@ class CdsApiImpl : public CdsApi,
 public:
   static CdsApiPtr create(const envoy::config::core::v3::ConfigSource& cds_config,
                           ClusterManager& cm, Stats::Scope& scope,
-                          ProtobufMessage::ValidationVisitor& validation_visitor);
+                          ProtobufMessage::ValidationVisitor& validation_visitor, Api::Api& api);
 
   // Upstream::CdsApi
   void initialize() override { subscription_->start({}); }
@@ -50,15 +55,37 @@ private:
     return MessageUtil::anyConvert<envoy::config::cluster::v3::Cluster>(resource).name();
   }
   CdsApiImpl(const envoy::config::core::v3::ConfigSource& cds_config, ClusterManager& cm,
-             Stats::Scope& scope, ProtobufMessage::ValidationVisitor& validation_visitor);
+             Stats::Scope& scope, ProtobufMessage::ValidationVisitor& validation_visitor,
+             Api::Api& api);
+  void applyConfigUpdate(
+      const std::vector<Config::DecodedResource<envoy::config::cluster::v3::Cluster>>&
+          added_clusters,
+      const std::function<const std::string&(int)>& added_version,
+      const std::vector<uint64_t>& added_hashes,
+      const std::vector<std::string>& unchanged_clusters,
+      const Protobuf::RepeatedPtrField<std::string>& removed_resources,
+      const std::string& system_version_info);
   void runInitializeCallbackIfAny();
 
+  // The hash of a cluster as the management server sent it, which is cheap to compute compared to
+  // decoding the cluster.
+  static uint64_t resourceHash(const ProtobufWkt::Any& resource);
+  void setAppliedHash(const std::string& cluster_name, uint64_t hash);
+  void forgetAppliedHash(const std::string& cluster_name);
+
   ClusterManager& cm_;
   std::unique_ptr<Config::Subscription> subscription_;
   std::string system_version_info_;
   std::function<void()> initialize_callback_;
   Stats::ScopePtr scope_;
   ProtobufMessage::ValidationVisitor& validation_visitor_;
+  Config::ParallelDecoder decoder_;
+  // The hashes of the clusters last applied by name, and the other way around, so that a cluster
+  // sent again unchanged, e.g. when the management server is reconnected to, is neither decoded
+  // nor applied again. Resources with the same content but serialized differently are decoded and
+  // compared by the ClusterManager as before.
+  absl::flat_hash_map<std::string, uint64_t> applied_hashes_;
+  absl::flat_hash_map<uint64_t, std::string> applied_names_;
 };
 
 } // namespace Upstream
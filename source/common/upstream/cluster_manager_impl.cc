@@ -32,6 +32,7 @@
 #include "common/network/utility.h"
 #include "common/protobuf/utility.h"
 #include "common/router/shadow_writer_impl.h"
+#include "common/runtime/runtime_features.h"
 #include "common/tcp/conn_pool.h"
 #include "common/upstream/cds_api_impl.h"
 #include "common/upstream/load_balancer_impl.h"
@@ -886,7 +887,7 @@ Host::CreateConnectionData ClusterManagerImpl::tcpConnForCluster(const std::stri
     throw EnvoyException(fmt::format("unknown cluster '{}'", cluster));
   }
 
-  HostConstSharedPtr logical_host = entry->second->lb_->chooseHost(context);
+  HostConstSharedPtr logical_host = entry->second->loadBalancer().chooseHost(context);
   if (logical_host) {
     auto conn_info = logical_host->createConnection(
         cluster_manager.thread_local_dispatcher_, nullptr,
@@ -910,7 +911,7 @@ Http::AsyncClient& ClusterManagerImpl::httpAsyncClientForCluster(const std::stri
   ThreadLocalClusterManagerImpl& cluster_manager = tls_->getTyped<ThreadLocalClusterManagerImpl>();
   auto entry = cluster_manager.thread_local_clusters_.find(cluster);
   if (entry != cluster_manager.thread_local_clusters_.end()) {
-    return entry->second->http_async_client_;
+    return entry->second->httpAsyncClient();
   } else {
     throw EnvoyException(fmt::format("unknown cluster '{}'", cluster));
   }
@@ -1139,8 +1140,9 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::updateClusterMembership(
                                            std::move(locality_weights), hosts_added, hosts_removed,
                                            overprovisioning_factor);
 
-  // If an LB is thread aware, create a new worker local LB on membership changes.
-  if (cluster_entry->lb_factory_ != nullptr) {
+  // If an LB is thread aware, create a new worker local LB on membership changes. An LB which has
+  // not been created yet picks up the membership when it is.
+  if (cluster_entry->lb_factory_ != nullptr && cluster_entry->lb_ != nullptr) {
     ENVOY_LOG(debug, "re-creating local LB for TLS cluster {}", name);
     cluster_entry->lb_ = cluster_entry->lb_factory_->create();
   }
@@ -1212,43 +1214,72 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::getHttpConnPoolsContainer(
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::ClusterEntry(
     ThreadLocalClusterManagerImpl& parent, ClusterInfoConstSharedPtr cluster,
     const LoadBalancerFactorySharedPtr& lb_factory)
-    : parent_(parent), lb_factory_(lb_factory), cluster_info_(cluster),
-      http_async_client_(cluster, parent.parent_.stats_, parent.thread_local_dispatcher_,
-                         parent.parent_.local_info_, parent.parent_, parent.parent_.runtime_,
-                         parent.parent_.random_,
-                         Router::ShadowWriterPtr{new Router::ShadowWriterImpl(parent.parent_)},
-                         parent_.parent_.http_context_) {
+    : parent_(parent), lb_factory_(lb_factory), cluster_info_(cluster) {
   priority_set_.getOrCreateHostSet(0);
 
+  if (!Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.lazy_thread_local_load_balancers")) {
+    createLoadBalancer();
+  }
+
+  if (cluster->connectionPoolIdleTimeout().has_value()) {
+    idle_pool_timer_ =
+        parent_.thread_local_dispatcher_.createTimer([this]() -> void { onIdlePoolTimer(); });
+    idle_pool_timer_->enableTimer(cluster->connectionPoolIdleTimeout().value());
+  }
+}
+
+LoadBalancer& ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::loadBalancer() {
+  if (lb_ == nullptr) {
+    createLoadBalancer();
+  }
+  return *lb_;
+}
+
+Http::AsyncClient&
+ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::httpAsyncClient() {
+  if (http_async_client_ == nullptr) {
+    http_async_client_ = std::make_unique<Http::AsyncClientImpl>(
+        cluster_info_, parent_.parent_.stats_, parent_.thread_local_dispatcher_,
+        parent_.parent_.local_info_, parent_.parent_, parent_.parent_.runtime_,
+        parent_.parent_.random_,
+        Router::ShadowWriterPtr{new Router::ShadowWriterImpl(parent_.parent_)},
+        parent_.parent_.http_context_);
+  }
+  return *http_async_client_;
+}
+
+void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::createLoadBalancer() {
+  const ClusterInfo& cluster = *cluster_info_;
   // TODO(mattklein123): Consider converting other LBs over to thread local. All of them could
   // benefit given the healthy panic, locality, and priority calculations that take place.
-  if (cluster->lbSubsetInfo().isEnabled()) {
+  if (cluster.lbSubsetInfo().isEnabled()) {
     lb_ = std::make_unique<SubsetLoadBalancer>(
-        cluster->lbType(), priority_set_, parent_.local_priority_set_, cluster->stats(),
-        cluster->statsScope(), parent.parent_.runtime_, parent.parent_.random_,
-        cluster->lbSubsetInfo(), cluster->lbRingHashConfig(), cluster->lbLeastRequestConfig(),
-        cluster->lbConfig());
+        cluster.lbType(), priority_set_, parent_.local_priority_set_, cluster.stats(),
+        cluster.statsScope(), parent_.parent_.runtime_, parent_.parent_.random_,
+        cluster.lbSubsetInfo(), cluster.lbRingHashConfig(), cluster.lbLeastRequestConfig(),
+        cluster.lbConfig());
   } else {
-    switch (cluster->lbType()) {
+    switch (cluster.lbType()) {
     case LoadBalancerType::LeastRequest: {
       ASSERT(lb_factory_ == nullptr);
       lb_ = std::make_unique<LeastRequestLoadBalancer>(
-          priority_set_, parent_.local_priority_set_, cluster->stats(), parent.parent_.runtime_,
-          parent.parent_.random_, cluster->lbConfig(), cluster->lbLeastRequestConfig());
+          priority_set_, parent_.local_priority_set_, cluster.stats(), parent_.parent_.runtime_,
+          parent_.parent_.random_, cluster.lbConfig(), cluster.lbLeastRequestConfig());
       break;
     }
     case LoadBalancerType::Random: {
       ASSERT(lb_factory_ == nullptr);
       lb_ = std::make_unique<RandomLoadBalancer>(priority_set_, parent_.local_priority_set_,
-                                                 cluster->stats(), parent.parent_.runtime_,
-                                                 parent.parent_.random_, cluster->lbConfig());
+                                                 cluster.stats(), parent_.parent_.runtime_,
+                                                 parent_.parent_.random_, cluster.lbConfig());
       break;
     }
     case LoadBalancerType::RoundRobin: {
       ASSERT(lb_factory_ == nullptr);
       lb_ = std::make_unique<RoundRobinLoadBalancer>(priority_set_, parent_.local_priority_set_,
-                                                     cluster->stats(), parent.parent_.runtime_,
-                                                     parent.parent_.random_, cluster->lbConfig());
+                                                     cluster.stats(), parent_.parent_.runtime_,
+                                                     parent_.parent_.random_, cluster.lbConfig());
       break;
     }
     case LoadBalancerType::ClusterProvided:
@@ -1263,6 +1294,20 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::ClusterEntry(
   }
 }
 
+void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::onIdlePoolTimer() {
+  // Pools are freed only once they have been unused for a whole interval, so a pool is reclaimed
+  // between one and two intervals after its last use.
+  for (const auto& host_set : priority_set_.hostSetsPerPriority()) {
+    for (const HostSharedPtr& host : host_set->hosts()) {
+      ConnPoolsContainer* container = parent_.getHttpConnPoolsContainer(host);
+      if (container != nullptr) {
+        container->pools_->freeIdlePools();
+      }
+    }
+  }
+  idle_pool_timer_->enableTimer(cluster_info_->connectionPoolIdleTimeout().value());
+}
+
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::~ClusterEntry() {
   // We need to drain all connection pools for the cluster being removed. Then we can remove the
   // cluster.
@@ -1278,7 +1323,7 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::~ClusterEntry()
 Http::ConnectionPool::Instance*
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::connPool(
     ResourcePriority priority, Http::Protocol protocol, LoadBalancerContext* context) {
-  HostConstSharedPtr host = lb_->chooseHost(context);
+  HostConstSharedPtr host = loadBalancer().chooseHost(context);
   if (!host) {
     ENVOY_LOG(debug, "no healthy host for HTTP connection pool");
     cluster_info_->stats().upstream_cx_none_healthy_.inc();
@@ -1331,7 +1376,7 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::connPool(
 Tcp::ConnectionPool::Instance*
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::tcpConnPool(
     ResourcePriority priority, LoadBalancerContext* context) {
-  HostConstSharedPtr host = lb_->chooseHost(context);
+  HostConstSharedPtr host = loadBalancer().chooseHost(context);
   if (!host) {
     ENVOY_LOG(debug, "no healthy host for TCP connection pool");
     cluster_info_->stats().upstream_cx_none_healthy_.inc();
@@ -1421,7 +1466,8 @@ CdsApiPtr
 ProdClusterManagerFactory::createCds(const envoy::config::core::v3::ConfigSource& cds_config,
                                      ClusterManager& cm) {
   // TODO(htuch): Differentiate static vs. dynamic validation visitors.
-  return CdsApiImpl::create(cds_config, cm, stats_, validation_context_.dynamicValidationVisitor());
+  return CdsApiImpl::create(cds_config, cm, stats_, validation_context_.dynamicValidationVisitor(),
+                            api_);
 }
 
 } // namespace Upstream
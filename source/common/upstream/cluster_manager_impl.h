@@ -336,7 +336,11 @@ private:
       // Upstream::ThreadLocalCluster
       const PrioritySet& prioritySet() override { return priority_set_; }
       ClusterInfoConstSharedPtr info() override { return cluster_info_; }
-      LoadBalancer& loadBalancer() override { return *lb_; }
+      LoadBalancer& loadBalancer() override;
+
+      Http::AsyncClient& httpAsyncClient();
+      void createLoadBalancer();
+      void onIdlePoolTimer();
 
       ThreadLocalClusterManagerImpl& parent_;
       PrioritySetImpl priority_set_;
@@ -344,10 +348,17 @@ private:
       // a factory will create a new LB on every membership update. LB types that don't have a
       // factory will create an LB on construction and use it forever.
       LoadBalancerFactorySharedPtr lb_factory_;
-      // Current active LB.
+      // Current active LB. Most clusters of a large CDS deployment never see traffic on a given
+      // worker, so when envoy.reloadable_features.lazy_thread_local_load_balancers is enabled the
+      // LB is only created when the worker first picks a host, and LB types with a factory are
+      // not re-created on membership updates until then.
       LoadBalancerPtr lb_;
       ClusterInfoConstSharedPtr cluster_info_;
-      Http::AsyncClientImpl http_async_client_;
+      // Created on first use, like the LB.
+      std::unique_ptr<Http::AsyncClientImpl> http_async_client_;
+      // Periodically frees unused HTTP connection pools if the cluster configures
+      // connection_pool_idle_timeout.
+      Event::TimerPtr idle_pool_timer_;
     };
 
     using ClusterEntryPtr = std::unique_ptr<ClusterEntry>;
@@ -56,7 +56,21 @@ public:
    */
   void drainConnections();
 
+  /**
+   * Destroys every pool that has no active connections and has not been returned by `getPool()`
+   * since the previous call. Destroying a pool closes its idle connections. This is a no-op while
+   * drained callbacks are registered, since those expect every mapped pool to report when drained.
+   * @return the number of pools that were destroyed.
+   */
+  size_t freeIdlePools();
+
 private:
+  struct PoolEntry {
+    std::unique_ptr<POOL_TYPE> pool_;
+    // Set when the pool is returned by `getPool()` or is busy, cleared by `freeIdlePools()`.
+    bool used_{true};
+  };
+
   /**
    * Frees the first idle pool in `active_pools_`.
    * @return false if no pool was freed.
@@ -68,7 +82,7 @@ private:
    **/
   void clearActivePools();
 
-  absl::flat_hash_map<KEY_TYPE, std::unique_ptr<POOL_TYPE>> active_pools_;
+  absl::flat_hash_map<KEY_TYPE, PoolEntry> active_pools_;
   Event::Dispatcher& thread_local_dispatcher_;
   std::vector<DrainedCb> cached_callbacks_;
   Common::DebugRecursionChecker recursion_checker_;
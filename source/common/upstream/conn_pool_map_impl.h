@@ -28,7 +28,8 @@ ConnPoolMap<KEY_TYPE, POOL_TYPE>::getPool(KEY_TYPE key, const PoolFactory& facto
   // here. Maybe we'll pass them to the factory function?
   auto pool_iter = active_pools_.find(key);
   if (pool_iter != active_pools_.end()) {
-    return std::ref(*(pool_iter->second));
+    pool_iter->second.used_ = true;
+    return std::ref(*(pool_iter->second.pool_));
   }
   ResourceLimit& connPoolResource = host_->cluster().resourceManager(priority_).connectionPools();
   // We need a new pool. Check if we have room.
@@ -56,8 +57,8 @@ ConnPoolMap<KEY_TYPE, POOL_TYPE>::getPool(KEY_TYPE key, const PoolFactory& facto
     new_pool->addDrainedCallback(cb);
   }
 
-  auto inserted = active_pools_.emplace(key, std::move(new_pool));
-  return std::ref(*inserted.first->second);
+  auto inserted = active_pools_.emplace(key, PoolEntry{std::move(new_pool)});
+  return std::ref(*inserted.first->second.pool_);
 }
 
 template <typename KEY_TYPE, typename POOL_TYPE>
@@ -68,7 +69,7 @@ size_t ConnPoolMap<KEY_TYPE, POOL_TYPE>::size() const {
 template <typename KEY_TYPE, typename POOL_TYPE> void ConnPoolMap<KEY_TYPE, POOL_TYPE>::clear() {
   Common::AutoDebugRecursionChecker assert_not_in(recursion_checker_);
   for (auto& pool_pair : active_pools_) {
-    thread_local_dispatcher_.deferredDelete(std::move(pool_pair.second));
+    thread_local_dispatcher_.deferredDelete(std::move(pool_pair.second.pool_));
   }
   clearActivePools();
 }
@@ -77,7 +78,7 @@ template <typename KEY_TYPE, typename POOL_TYPE>
 void ConnPoolMap<KEY_TYPE, POOL_TYPE>::addDrainedCallback(const DrainedCb& cb) {
   Common::AutoDebugRecursionChecker assert_not_in(recursion_checker_);
   for (auto& pool_pair : active_pools_) {
-    pool_pair.second->addDrainedCallback(cb);
+    pool_pair.second.pool_->addDrainedCallback(cb);
   }
 
   cached_callbacks_.emplace_back(std::move(cb));
@@ -87,16 +88,43 @@ template <typename KEY_TYPE, typename POOL_TYPE>
 void ConnPoolMap<KEY_TYPE, POOL_TYPE>::drainConnections() {
   Common::AutoDebugRecursionChecker assert_not_in(recursion_checker_);
   for (auto& pool_pair : active_pools_) {
-    pool_pair.second->drainConnections();
+    pool_pair.second.pool_->drainConnections();
   }
 }
 
+template <typename KEY_TYPE, typename POOL_TYPE>
+size_t ConnPoolMap<KEY_TYPE, POOL_TYPE>::freeIdlePools() {
+  Common::AutoDebugRecursionChecker assert_not_in(recursion_checker_);
+  if (!cached_callbacks_.empty()) {
+    return 0;
+  }
+
+  size_t freed = 0;
+  for (auto pool_iter = active_pools_.begin(); pool_iter != active_pools_.end();) {
+    PoolEntry& entry = pool_iter->second;
+    const bool active = entry.pool_->hasActiveConnections();
+    if (entry.used_ || active) {
+      // A pool that is still busy needs a full interval without use once it goes idle.
+      entry.used_ = active;
+      ++pool_iter;
+      continue;
+    }
+
+    thread_local_dispatcher_.deferredDelete(std::move(entry.pool_));
+    active_pools_.erase(pool_iter++);
+    ++freed;
+  }
+
+  host_->cluster().resourceManager(priority_).connectionPools().decBy(freed);
+  return freed;
+}
+
 template <typename KEY_TYPE, typename POOL_TYPE>
 bool ConnPoolMap<KEY_TYPE, POOL_TYPE>::freeOnePool() {
   // Try to find a pool that isn't doing anything.
   auto pool_iter = active_pools_.begin();
   while (pool_iter != active_pools_.end()) {
-    if (!pool_iter->second->hasActiveConnections()) {
+    if (!pool_iter->second.pool_->hasActiveConnections()) {
       break;
     }
     ++pool_iter;
@@ -13,6 +13,8 @@
 #include "common/config/api_version.h"
 #include "common/config/version_converter.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -184,49 +186,51 @@ void EdsClusterImpl::onAssignmentTimeout() {
   info_->stats().assignment_stale_.inc();
 }
 
-void EdsClusterImpl::reloadHealthyHostsHelper(const HostSharedPtr& host) {
-  // Here we will see if we have a host that has been marked for deletion by service discovery
-  // but has been stabilized due to passing active health checking. If such a host is now
+void EdsClusterImpl::reloadHealthyHostsHelper(const HostVector& hosts) {
+  // Here we will see if we have hosts that have been marked for deletion by service discovery
+  // but have been stabilized due to passing active health checking. If such a host is now
   // failing active health checking we can remove it during this health check update.
-  HostSharedPtr host_to_exclude = host;
-  if (host_to_exclude != nullptr &&
-      host_to_exclude->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC) &&
-      host_to_exclude->healthFlagGet(Host::HealthFlag::PENDING_DYNAMIC_REMOVAL)) {
-    // Empty for clarity.
-  } else {
-    // Do not exclude and remove the host during the update.
-    host_to_exclude = nullptr;
+  absl::flat_hash_map<const Host*, HostSharedPtr> hosts_to_exclude;
+  for (const HostSharedPtr& host : hosts) {
+    if (host->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC) &&
+        host->healthFlagGet(Host::HealthFlag::PENDING_DYNAMIC_REMOVAL)) {
+      // Only exclude the host if it is still the one known at its address: a host already removed
+      // by an update may have been replaced by a new host with the same address.
+      const auto existing = all_hosts_.find(host->address()->asString());
+      if (existing != all_hosts_.end() && existing->second.get() == host.get()) {
+        hosts_to_exclude.emplace(host.get(), host);
+      }
+    }
   }
 
   const auto& host_sets = prioritySet().hostSetsPerPriority();
   for (size_t priority = 0; priority < host_sets.size(); ++priority) {
     const auto& host_set = host_sets[priority];
 
-    // Filter current hosts in case we need to exclude a host.
+    // Filter current hosts in case we need to exclude hosts, and setup a hosts to remove vector
+    // with the ones that were excluded.
     HostVectorSharedPtr hosts_copy(new HostVector());
-    std::copy_if(host_set->hosts().begin(), host_set->hosts().end(),
-                 std::back_inserter(*hosts_copy),
-                 [&host_to_exclude](const HostSharedPtr& host) { return host_to_exclude != host; });
-
-    // Setup a hosts to remove vector in case we need to exclude a host.
     HostVector hosts_to_remove;
-    if (hosts_copy->size() != host_set->hosts().size()) {
-      ASSERT(hosts_copy->size() == host_set->hosts().size() - 1);
-      hosts_to_remove.emplace_back(host_to_exclude);
+    for (const HostSharedPtr& host : host_set->hosts()) {
+      if (hosts_to_exclude.contains(host.get())) {
+        hosts_to_remove.emplace_back(host);
+      } else {
+        hosts_copy->emplace_back(host);
+      }
     }
 
-    // Filter hosts per locality in case we need to exclude a host.
+    // Filter hosts per locality in case we need to exclude hosts.
     HostsPerLocalityConstSharedPtr hosts_per_locality_copy = host_set->hostsPerLocality().filter(
-        {[&host_to_exclude](const Host& host) { return &host != host_to_exclude.get(); }})[0];
+        {[&hosts_to_exclude](const Host& host) { return !hosts_to_exclude.contains(&host); }})[0];
 
     prioritySet().updateHosts(priority,
                               HostSetImpl::partitionHosts(hosts_copy, hosts_per_locality_copy),
                               host_set->localityWeights(), {}, hosts_to_remove, absl::nullopt);
   }
 
-  if (host_to_exclude != nullptr) {
-    ASSERT(all_hosts_.find(host_to_exclude->address()->asString()) != all_hosts_.end());
-    all_hosts_.erase(host_to_exclude->address()->asString());
+  for (const auto& host_to_exclude : hosts_to_exclude) {
+    ASSERT(all_hosts_.find(host_to_exclude.second->address()->asString()) != all_hosts_.end());
+    all_hosts_.erase(host_to_exclude.second->address()->asString());
   }
 }
 
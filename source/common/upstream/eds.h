@@ -57,7 +57,7 @@ private:
   bool validateUpdateSize(int num_resources);
 
   // ClusterImplBase
-  void reloadHealthyHostsHelper(const HostSharedPtr& host) override;
+  void reloadHealthyHostsHelper(const HostVector& hosts) override;
   void startPreInit() override;
   void onAssignmentTimeout();
 
@@ -553,9 +553,10 @@ void DetectorImpl::onConsecutiveErrorWorker(
   }
 }
 
-DetectorImpl::EjectionPair DetectorImpl::successRateEjectionThreshold(
-    double success_rate_sum, const std::vector<HostSuccessRatePair>& valid_success_rate_hosts,
-    double success_rate_stdev_factor) {
+DetectorImpl::EjectionPair
+DetectorImpl::successRateEjectionThreshold(double success_rate_sum,
+                                           const std::vector<double>& success_rates,
+                                           double success_rate_stdev_factor) {
   // This function is using mean and standard deviation as statistical measures for outlier
   // detection. First the mean is calculated by dividing the sum of success rate data over the
   // number of data points. Then variance is calculated by taking the mean of the
@@ -571,14 +572,14 @@ DetectorImpl::EjectionPair DetectorImpl::successRateEjectionThreshold(
   // variance = 400
   // stdev = 20
   // threshold returned = 52
-  double mean = success_rate_sum / valid_success_rate_hosts.size();
+  const double mean = success_rate_sum / success_rates.size();
   double variance = 0;
-  std::for_each(valid_success_rate_hosts.begin(), valid_success_rate_hosts.end(),
-                [&variance, mean](HostSuccessRatePair v) {
-                  variance += std::pow(v.success_rate_ - mean, 2);
-                });
-  variance /= valid_success_rate_hosts.size();
-  double stdev = std::sqrt(variance);
+  for (const double success_rate : success_rates) {
+    const double deviation = success_rate - mean;
+    variance += deviation * deviation;
+  }
+  variance /= success_rates.size();
+  const double stdev = std::sqrt(variance);
 
   return {mean, (mean - (success_rate_stdev_factor * stdev))};
 }
@@ -596,8 +597,8 @@ void DetectorImpl::processSuccessRateEjections(
       runtime_.snapshot().getInteger("outlier_detection.failure_percentage_request_volume",
                                      config_.failurePercentageRequestVolume());
 
-  std::vector<HostSuccessRatePair> valid_success_rate_hosts;
-  std::vector<HostSuccessRatePair> valid_failure_percentage_hosts;
+  HostSuccessRates valid_success_rate_hosts;
+  HostSuccessRates valid_failure_percentage_hosts;
   double success_rate_sum = 0;
 
   // Reset the Detector's success rate mean and stdev.
@@ -633,11 +634,11 @@ void DetectorImpl::processSuccessRateEjections(
       }
 
       if (request_volume >= success_rate_request_volume) {
-        valid_success_rate_hosts.emplace_back(HostSuccessRatePair(host.first, success_rate));
+        valid_success_rate_hosts.add(host.first, host.second, success_rate);
         success_rate_sum += success_rate;
       }
       if (request_volume >= failure_percentage_request_volume) {
-        valid_failure_percentage_hosts.emplace_back(HostSuccessRatePair(host.first, success_rate));
+        valid_failure_percentage_hosts.add(host.first, host.second, success_rate);
       }
     }
   }
@@ -649,17 +650,15 @@ void DetectorImpl::processSuccessRateEjections(
                                        config_.successRateStdevFactor()) /
         1000.0;
     getSRNums(monitor_type) = successRateEjectionThreshold(
-        success_rate_sum, valid_success_rate_hosts, success_rate_stdev_factor);
+        success_rate_sum, valid_success_rate_hosts.success_rates_, success_rate_stdev_factor);
     const double success_rate_ejection_threshold = getSRNums(monitor_type).ejection_threshold_;
-    for (const auto& host_success_rate_pair : valid_success_rate_hosts) {
-      if (host_success_rate_pair.success_rate_ < success_rate_ejection_threshold) {
+    for (size_t i = 0; i < valid_success_rate_hosts.size(); i++) {
+      if (valid_success_rate_hosts.success_rates_[i] < success_rate_ejection_threshold) {
         stats_.ejections_success_rate_.inc(); // Deprecated.
         const envoy::data::cluster::v2alpha::OutlierEjectionType type =
-            host_monitors_[host_success_rate_pair.host_]
-                ->getSRMonitor(monitor_type)
-                .getEjectionType();
+            valid_success_rate_hosts.monitors_[i]->getSRMonitor(monitor_type).getEjectionType();
         updateDetectedEjectionStats(type);
-        ejectHost(host_success_rate_pair.host_, type);
+        ejectHost(valid_success_rate_hosts.hosts_[i], type);
       }
     }
   }
@@ -669,8 +668,9 @@ void DetectorImpl::processSuccessRateEjections(
     const double failure_percentage_threshold = runtime_.snapshot().getInteger(
         "outlier_detection.failure_percentage_threshold", config_.failurePercentageThreshold());
 
-    for (const auto& host_success_rate_pair : valid_failure_percentage_hosts) {
-      if ((100.0 - host_success_rate_pair.success_rate_) >= failure_percentage_threshold) {
+    for (size_t i = 0; i < valid_failure_percentage_hosts.size(); i++) {
+      if ((100.0 - valid_failure_percentage_hosts.success_rates_[i]) >=
+          failure_percentage_threshold) {
         // We should eject.
 
         // The ejection type returned by the SuccessRateMonitor's getEjectionType() will be a
@@ -680,7 +680,7 @@ void DetectorImpl::processSuccessRateEjections(
                 ? envoy::data::cluster::v2alpha::FAILURE_PERCENTAGE
                 : envoy::data::cluster::v2alpha::FAILURE_PERCENTAGE_LOCAL_ORIGIN;
         updateDetectedEjectionStats(type);
-        ejectHost(host_success_rate_pair.host_, type);
+        ejectHost(valid_failure_percentage_hosts.hosts_[i], type);
       }
     }
   }
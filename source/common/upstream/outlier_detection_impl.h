@@ -54,14 +54,30 @@ public:
                    EventLoggerSharedPtr event_logger);
 };
 
+class DetectorHostMonitorImpl;
+
 /**
- * Thin struct to facilitate calculations for success rate outlier detection.
+ * Columnar set of hosts taking part in a success rate calculation for one ejection interval. The
+ * success rates are kept in their own contiguous array, separate from the host references, so that
+ * the mean and variance passes over large clusters walk plain doubles.
  */
-struct HostSuccessRatePair {
-  HostSuccessRatePair(HostSharedPtr host, double success_rate)
-      : host_(host), success_rate_(success_rate) {}
-  HostSharedPtr host_;
-  double success_rate_;
+struct HostSuccessRates {
+  void reserve(size_t size) {
+    hosts_.reserve(size);
+    monitors_.reserve(size);
+    success_rates_.reserve(size);
+  }
+  void add(const HostSharedPtr& host, DetectorHostMonitorImpl* monitor, double success_rate) {
+    hosts_.push_back(host);
+    monitors_.push_back(monitor);
+    success_rates_.push_back(success_rate);
+  }
+  bool empty() const { return success_rates_.empty(); }
+  size_t size() const { return success_rates_.size(); }
+
+  std::vector<HostSharedPtr> hosts_;
+  std::vector<DetectorHostMonitorImpl*> monitors_;
+  std::vector<double> success_rates_;
 };
 
 struct SuccessRateAccumulatorBucket {
@@ -351,19 +367,17 @@ public:
    * This function returns pair of double values for success rate outlier detection. The pair
    * contains the average success rate of all valid hosts in the cluster and the ejection threshold.
    * If a host's success rate is under this threshold, the host is an outlier.
-   * @param success_rate_sum is the sum of the data in the success_rate_data vector.
-   * @param valid_success_rate_hosts is the vector containing the individual success rate data
-   *        points.
+   * @param success_rate_sum is the sum of the data in the success_rates vector.
+   * @param success_rates is the vector containing the individual success rate data points.
    * @return EjectionPair
    */
   struct EjectionPair {
     double success_rate_average_; // average success rate of all valid hosts in the cluster
     double ejection_threshold_;   // ejection threshold for the cluster
   };
-  static EjectionPair
-  successRateEjectionThreshold(double success_rate_sum,
-                               const std::vector<HostSuccessRatePair>& valid_success_rate_hosts,
-                               double success_rate_stdev_factor);
+  static EjectionPair successRateEjectionThreshold(double success_rate_sum,
+                                                   const std::vector<double>& success_rates,
+                                                   double success_rate_stdev_factor);
 
 private:
   DetectorImpl(const Cluster& cluster, const envoy::config::cluster::v3::OutlierDetection& config,
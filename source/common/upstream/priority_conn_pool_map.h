@@ -51,6 +51,12 @@ public:
    */
   void drainConnections();
 
+  /**
+   * Destroys idle pools across all priorities. See `ConnPoolMap::freeIdlePools()`.
+   * @return the number of pools that were destroyed.
+   */
+  size_t freeIdlePools();
+
 private:
   std::array<std::unique_ptr<ConnPoolMapType>, NumResourcePriorities> conn_pool_maps_;
 };
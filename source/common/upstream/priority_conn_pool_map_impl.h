@@ -57,5 +57,14 @@ void PriorityConnPoolMap<KEY_TYPE, POOL_TYPE>::drainConnections() {
   }
 }
 
+template <typename KEY_TYPE, typename POOL_TYPE>
+size_t PriorityConnPoolMap<KEY_TYPE, POOL_TYPE>::freeIdlePools() {
+  size_t freed = 0;
+  for (auto& pool_map : conn_pool_maps_) {
+    freed += pool_map->freeIdlePools();
+  }
+  return freed;
+}
+
 } // namespace Upstream
 } // namespace Envoy
@@ -1,5 +1,6 @@
 #include "common/upstream/upstream_impl.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <limits>
@@ -23,6 +24,7 @@
 #include "envoy/secret/secret_manager.h"
 #include "envoy/server/filter_config.h"
 #include "envoy/server/transport_socket_config.h"
+#include "envoy/singleton/manager.h"
 #include "envoy/ssl/context_manager.h"
 #include "envoy/stats/scope.h"
 #include "envoy/upstream/health_checker.h"
@@ -40,6 +42,7 @@
 #include "common/protobuf/protobuf.h"
 #include "common/protobuf/utility.h"
 #include "common/router/config_utility.h"
+#include "common/runtime/runtime_features.h"
 #include "common/runtime/runtime_impl.h"
 #include "common/upstream/eds.h"
 #include "common/upstream/health_checker_impl.h"
@@ -51,12 +54,30 @@
 #include "extensions/filters/network/common/utility.h"
 #include "extensions/transport_sockets/well_known_names.h"
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/strings/str_cat.h"
 
 namespace Envoy {
 namespace Upstream {
 namespace {
 
+SINGLETON_MANAGER_REGISTRATION(const_http2_protocol_options_shared_pool);
+SINGLETON_MANAGER_REGISTRATION(const_http_protocol_options_shared_pool);
+SINGLETON_MANAGER_REGISTRATION(const_common_lb_config_shared_pool);
+
+// Returns the copy of the message shared by all the clusters with the same message, from the
+// singleton pool of the given name. Main thread only, as clusters are created there.
+template <class MessageType>
+std::shared_ptr<const MessageType>
+getSharedMessage(const MessageType& message, const std::string& pool_name,
+                 Server::Configuration::TransportSocketFactoryContext& factory_context) {
+  using Pool = SharedPool::ObjectSharedPool<const MessageType, MessageUtil>;
+  Event::Dispatcher& dispatcher = factory_context.dispatcher();
+  return factory_context.singletonManager()
+      .getTyped<Pool>(pool_name, [&dispatcher] { return std::make_shared<Pool>(dispatcher); })
+      ->getObject(message);
+}
+
 const Network::Address::InstanceConstSharedPtr
 getSourceAddress(const envoy::config::cluster::v3::Cluster& cluster,
                  const envoy::config::core::v3::BindConfig& bind_config) {
@@ -678,16 +699,21 @@ ClusterInfoImpl::ClusterInfoImpl(
       per_connection_buffer_limit_bytes_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, per_connection_buffer_limit_bytes, 1024 * 1024)),
       socket_matcher_(std::move(socket_matcher)), stats_scope_(std::move(stats_scope)),
-      stats_(generateStats(*stats_scope_)), load_report_stats_store_(stats_scope_->symbolTable()),
-      load_report_stats_(generateLoadReportStats(load_report_stats_store_)),
+      stats_(generateStats(*stats_scope_)),
       timeout_budget_stats_(config.track_timeout_budgets()
                                 ? absl::make_optional<ClusterTimeoutBudgetStats>(
                                       generateTimeoutBudgetStats(*stats_scope_))
                                 : absl::nullopt),
       features_(parseFeatures(config)),
       http1_settings_(Http::Utility::parseHttp1Settings(config.http_protocol_options())),
-      http2_options_(Http2::Utility::initializeAndValidateOptions(config.http2_protocol_options())),
-      common_http_protocol_options_(config.common_http_protocol_options()),
+      http2_options_(getSharedMessage(
+          Http2::Utility::initializeAndValidateOptions(config.http2_protocol_options()),
+          SINGLETON_MANAGER_REGISTERED_NAME(const_http2_protocol_options_shared_pool),
+          factory_context)),
+      common_http_protocol_options_(getSharedMessage(
+          config.common_http_protocol_options(),
+          SINGLETON_MANAGER_REGISTERED_NAME(const_http_protocol_options_shared_pool),
+          factory_context)),
       extension_protocol_options_(parseExtensionProtocolOptions(config, validation_visitor)),
       resource_managers_(config, runtime, name_, *stats_scope_),
       maintenance_mode_runtime_key_(absl::StrCat("upstream.maintenance_mode.", name_)),
@@ -696,12 +722,23 @@ ClusterInfoImpl::ClusterInfoImpl(
       lb_ring_hash_config_(config.ring_hash_lb_config()),
       lb_original_dst_config_(config.original_dst_lb_config()), added_via_api_(added_via_api),
       lb_subset_(LoadBalancerSubsetInfoImpl(config.lb_subset_config())),
-      metadata_(config.metadata()), typed_metadata_(config.metadata()),
-      common_lb_config_(config.common_lb_config()),
+      metadata_(Config::Metadata::getConstMetadataSharedPool(factory_context.singletonManager(),
+                                                             factory_context.dispatcher())
+                    ->getObject(config.metadata())),
+      typed_metadata_(config.metadata()),
+      common_lb_config_(
+          getSharedMessage(config.common_lb_config(),
+                           SINGLETON_MANAGER_REGISTERED_NAME(const_common_lb_config_shared_pool),
+                           factory_context)),
       cluster_socket_options_(parseClusterSocketOptions(config, bind_config)),
       drain_connections_on_host_removal_(config.ignore_health_on_host_removal()),
+      connection_pool_idle_timeout_(
+          config.has_connection_pool_idle_timeout()
+              ? absl::make_optional(std::chrono::milliseconds(
+                    DurationUtil::durationToMilliseconds(config.connection_pool_idle_timeout())))
+              : absl::nullopt),
       warm_hosts_(!config.health_checks().empty() &&
-                  common_lb_config_.ignore_new_hosts_until_first_hc()),
+                  common_lb_config_->ignore_new_hosts_until_first_hc()),
       upstream_http_protocol_options_(
           config.has_upstream_http_protocol_options()
               ? absl::make_optional<envoy::config::core::v3::UpstreamHttpProtocolOptions>(
@@ -794,7 +831,7 @@ ClusterInfoImpl::ClusterInfoImpl(
   // TODO(htuch): Remove this temporary workaround when we have
   // https://github.com/envoyproxy/protoc-gen-validate/issues/97 resolved. This just provides
   // early validation of sanity of fields that we should catch at config ingestion.
-  DurationUtil::durationToMilliseconds(common_lb_config_.update_merge_window());
+  DurationUtil::durationToMilliseconds(common_lb_config_->update_merge_window());
 
   // Create upstream filter factories
   auto filters = config.filters();
@@ -870,6 +907,7 @@ ClusterImplBase::ClusterImplBase(
     Stats::ScopePtr&& stats_scope, bool added_via_api)
     : init_manager_(fmt::format("Cluster {}", cluster.name())),
       init_watcher_("ClusterImplBase", [this]() { onInitDone(); }), runtime_(runtime),
+      dispatcher_(factory_context.dispatcher()),
       local_cluster_(factory_context.clusterManager().localClusterName().value_or("") ==
                      cluster.name()),
       symbol_table_(stats_scope->symbolTable()),
@@ -1001,7 +1039,7 @@ void ClusterImplBase::finishInitialization() {
   initialization_complete_callback_ = nullptr;
 
   if (health_checker_ != nullptr) {
-    reloadHealthyHosts(nullptr);
+    reloadHealthyHosts({});
   }
 
   if (snapped_callback != nullptr) {
@@ -1018,9 +1056,54 @@ void ClusterImplBase::setHealthChecker(const HealthCheckerSharedPtr& health_chec
         // If we get a health check completion that resulted in a state change, signal to
         // update the host sets on all threads.
         if (changed_state == HealthTransition::Changed) {
-          reloadHealthyHosts(host);
+          onHealthCheckTransition(host);
         }
       });
+  // Service discovery may remove some of the hosts with a pending transition before it is flushed,
+  // possibly adding a new host with the same address. Those hosts are no longer members of the
+  // cluster and must not be acted upon.
+  prioritySet().addMemberUpdateCb([this](const HostVector&, const HostVector& hosts_removed) {
+    if (pending_health_transitions_.empty() || hosts_removed.empty()) {
+      return;
+    }
+    absl::flat_hash_set<const Host*> removed;
+    for (const HostSharedPtr& host : hosts_removed) {
+      removed.insert(host.get());
+    }
+    pending_health_transitions_.erase(
+        std::remove_if(pending_health_transitions_.begin(), pending_health_transitions_.end(),
+                       [&removed](const HostSharedPtr& host) {
+                         return removed.contains(host.get());
+                       }),
+        pending_health_transitions_.end());
+  });
+}
+
+void ClusterImplBase::onHealthCheckTransition(const HostSharedPtr& host) {
+  if (!Runtime::runtimeFeatureEnabled("envoy.reloadable_features.batch_health_check_updates")) {
+    reloadHealthyHosts({host});
+    return;
+  }
+
+  // Each rebuild recomputes every host set and posts the result to all workers, so with large
+  // clusters a burst of health check completions can keep the main thread busy for a long time.
+  // Instead, collect the transitions seen in this event loop iteration and rebuild once.
+  pending_health_transitions_.push_back(host);
+  if (health_transition_timer_ == nullptr) {
+    health_transition_timer_ =
+        dispatcher_.createTimer([this]() -> void { flushPendingHealthTransitions(); });
+  }
+  if (!health_transition_timer_->enabled()) {
+    health_transition_timer_->enableTimer(std::chrono::milliseconds(0));
+  }
+}
+
+void ClusterImplBase::flushPendingHealthTransitions() {
+  HostVector hosts;
+  hosts.swap(pending_health_transitions_);
+  if (!hosts.empty()) {
+    reloadHealthyHosts(hosts);
+  }
 }
 
 void ClusterImplBase::setOutlierDetector(const Outlier::DetectorSharedPtr& outlier_detector) {
@@ -1030,10 +1113,10 @@ void ClusterImplBase::setOutlierDetector(const Outlier::DetectorSharedPtr& outli
 
   outlier_detector_ = outlier_detector;
   outlier_detector_->addChangedStateCb(
-      [this](const HostSharedPtr& host) -> void { reloadHealthyHosts(host); });
+      [this](const HostSharedPtr& host) -> void { reloadHealthyHosts({host}); });
 }
 
-void ClusterImplBase::reloadHealthyHosts(const HostSharedPtr& host) {
+void ClusterImplBase::reloadHealthyHosts(const HostVector& hosts) {
   // Every time a host changes Health Check state we cause a full healthy host recalculation which
   // for expensive LBs (ring, subset, etc.) can be quite time consuming. During startup, this
   // can also block worker threads by doing this repeatedly. There is no reason to do this
@@ -1043,10 +1126,10 @@ void ClusterImplBase::reloadHealthyHosts(const HostSharedPtr& host) {
     return;
   }
 
-  reloadHealthyHostsHelper(host);
+  reloadHealthyHostsHelper(hosts);
 }
 
-void ClusterImplBase::reloadHealthyHostsHelper(const HostSharedPtr&) {
+void ClusterImplBase::reloadHealthyHostsHelper(const HostVector&) {
   const auto& host_sets = prioritySet().hostSetsPerPriority();
   for (size_t priority = 0; priority < host_sets.size(); ++priority) {
     const auto& host_set = host_sets[priority];
@@ -1105,6 +1188,14 @@ ClusterInfoImpl::generateCircuitBreakersStats(Stats::Scope& scope, const std::st
   }
 }
 
+ClusterLoadReportStats& ClusterInfoImpl::loadReportStats() const {
+  return load_report_stats_
+      .get([this]() -> LoadReportStatsStore* {
+        return new LoadReportStatsStore(stats_scope_->symbolTable());
+      })
+      ->stats_;
+}
+
 Http::Http1::CodecStats& ClusterInfoImpl::http1CodecStats() const {
   return Http::Http1::CodecStats::atomicGet(http1_codec_stats_, *stats_scope_);
 }
@@ -528,22 +528,25 @@ public:
   // Upstream::ClusterInfo
   bool addedViaApi() const override { return added_via_api_; }
   const envoy::config::cluster::v3::Cluster::CommonLbConfig& lbConfig() const override {
-    return common_lb_config_;
+    return *common_lb_config_;
   }
   std::chrono::milliseconds connectTimeout() const override { return connect_timeout_; }
   const absl::optional<std::chrono::milliseconds> idleTimeout() const override {
     return idle_timeout_;
   }
+  const absl::optional<std::chrono::milliseconds> connectionPoolIdleTimeout() const override {
+    return connection_pool_idle_timeout_;
+  }
   uint32_t perConnectionBufferLimitBytes() const override {
     return per_connection_buffer_limit_bytes_;
   }
   uint64_t features() const override { return features_; }
   const Http::Http1Settings& http1Settings() const override { return http1_settings_; }
   const envoy::config::core::v3::Http2ProtocolOptions& http2Options() const override {
-    return http2_options_;
+    return *http2_options_;
   }
   const envoy::config::core::v3::HttpProtocolOptions& commonHttpProtocolOptions() const override {
-    return common_http_protocol_options_;
+    return *common_http_protocol_options_;
   }
   ProtocolOptionsConfigConstSharedPtr
   extensionProtocolOptions(const std::string& name) const override;
@@ -573,7 +576,7 @@ public:
   TransportSocketMatcher& transportSocketMatcher() const override { return *socket_matcher_; }
   ClusterStats& stats() const override { return stats_; }
   Stats::Scope& statsScope() const override { return *stats_scope_; }
-  ClusterLoadReportStats& loadReportStats() const override { return load_report_stats_; }
+  ClusterLoadReportStats& loadReportStats() const override;
   const absl::optional<ClusterTimeoutBudgetStats>& timeoutBudgetStats() const override {
     return timeout_budget_stats_;
   }
@@ -581,7 +584,7 @@ public:
     return source_address_;
   };
   const LoadBalancerSubsetInfo& lbSubsetInfo() const override { return lb_subset_; }
-  const envoy::config::core::v3::Metadata& metadata() const override { return metadata_; }
+  const envoy::config::core::v3::Metadata& metadata() const override { return *metadata_; }
   const Envoy::Config::TypedMetadata& typedMetadata() const override { return typed_metadata_; }
 
   const Network::ConnectionSocket::OptionsSharedPtr& clusterSocketOptions() const override {
@@ -618,6 +621,17 @@ private:
     Managers managers_;
   };
 
+  // The load report stats are latched by the load stats reporter rather than by the stats sinks,
+  // so they live in a store of their own. Only the clusters that LRS reports on or that drop
+  // requests use them, so the store is created on first use.
+  struct LoadReportStatsStore {
+    LoadReportStatsStore(Stats::SymbolTable& symbol_table)
+        : store_(symbol_table), stats_(generateLoadReportStats(store_)) {}
+
+    Stats::IsolatedStoreImpl store_;
+    ClusterLoadReportStats stats_;
+  };
+
   Runtime::Loader& runtime_;
   const std::string name_;
   const envoy::config::cluster::v3::Cluster::DiscoveryType type_;
@@ -629,13 +643,16 @@ private:
   TransportSocketMatcherPtr socket_matcher_;
   Stats::ScopePtr stats_scope_;
   mutable ClusterStats stats_;
-  Stats::IsolatedStoreImpl load_report_stats_store_;
-  mutable ClusterLoadReportStats load_report_stats_;
+  mutable Thread::AtomicPtr<LoadReportStatsStore, Thread::AtomicPtrAllocMode::DeleteOnDestruct>
+      load_report_stats_;
   const absl::optional<ClusterTimeoutBudgetStats> timeout_budget_stats_;
   const uint64_t features_;
   const Http::Http1Settings http1_settings_;
-  const envoy::config::core::v3::Http2ProtocolOptions http2_options_;
-  const envoy::config::core::v3::HttpProtocolOptions common_http_protocol_options_;
+  // The options and metadata below are usually identical across clusters, so clusters with the
+  // same messages share one copy of them, see getSharedMessage().
+  const std::shared_ptr<const envoy::config::core::v3::Http2ProtocolOptions> http2_options_;
+  const std::shared_ptr<const envoy::config::core::v3::HttpProtocolOptions>
+      common_http_protocol_options_;
   const std::map<std::string, ProtocolOptionsConfigConstSharedPtr> extension_protocol_options_;
   mutable ResourceManagers resource_managers_;
   const std::string maintenance_mode_runtime_key_;
@@ -647,11 +664,13 @@ private:
   absl::optional<envoy::config::cluster::v3::Cluster::OriginalDstLbConfig> lb_original_dst_config_;
   const bool added_via_api_;
   LoadBalancerSubsetInfoImpl lb_subset_;
-  const envoy::config::core::v3::Metadata metadata_;
+  const std::shared_ptr<const envoy::config::core::v3::Metadata> metadata_;
   Envoy::Config::TypedMetadataImpl<ClusterTypedMetadataFactory> typed_metadata_;
-  const envoy::config::cluster::v3::Cluster::CommonLbConfig common_lb_config_;
+  const std::shared_ptr<const envoy::config::cluster::v3::Cluster::CommonLbConfig>
+      common_lb_config_;
   const Network::ConnectionSocket::OptionsSharedPtr cluster_socket_options_;
   const bool drain_connections_on_host_removal_;
+  const absl::optional<std::chrono::milliseconds> connection_pool_idle_timeout_;
   const bool warm_hosts_;
   const absl::optional<envoy::config::core::v3::UpstreamHttpProtocolOptions>
       upstream_http_protocol_options_;
@@ -751,7 +770,12 @@ protected:
    */
   void onInitDone();
 
-  virtual void reloadHealthyHostsHelper(const HostSharedPtr& host);
+  /**
+   * Rebuilds the healthy host sets of every priority following a health change.
+   * @param hosts supplies the hosts whose health changed since the last rebuild. Empty when the
+   *        rebuild is not attributable to specific hosts (e.g., at the end of initialization).
+   */
+  virtual void reloadHealthyHostsHelper(const HostVector& hosts);
 
   // This init manager is shared via TransportSocketFactoryContext. The initialization targets that
   // register with this init manager are expected to be for implementations of SdsApi (see
@@ -776,11 +800,20 @@ protected:
 
 private:
   void finishInitialization();
-  void reloadHealthyHosts(const HostSharedPtr& host);
+  void reloadHealthyHosts(const HostVector& hosts);
+  void onHealthCheckTransition(const HostSharedPtr& host);
+  void flushPendingHealthTransitions();
 
   bool initialization_started_{};
   std::function<void()> initialization_complete_callback_;
   uint64_t pending_initialize_health_checks_{};
+  Event::Dispatcher& dispatcher_;
+  // Hosts whose active health check state changed during the current event loop iteration. Used
+  // to coalesce host set rebuilds when envoy.reloadable_features.batch_health_check_updates is
+  // enabled. Hosts are dropped from here as soon as they are removed from the cluster, so that the
+  // flush only touches the hosts which changed.
+  HostVector pending_health_transitions_;
+  Event::TimerPtr health_transition_timer_;
   const bool local_cluster_;
   Stats::SymbolTable& symbol_table_;
   Config::ConstMetadataSharedPoolSharedPtr const_metadata_shared_pool_;
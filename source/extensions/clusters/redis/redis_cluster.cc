@@ -128,15 +128,18 @@ void RedisCluster::onClusterSlotUpdate(ClusterSlotsPtr&& slots) {
   onPreInitComplete();
 }
 
-void RedisCluster::reloadHealthyHostsHelper(const Upstream::HostSharedPtr& host) {
+void RedisCluster::reloadHealthyHostsHelper(const Upstream::HostVector& hosts) {
   if (lb_factory_) {
     lb_factory_->onHostHealthUpdate();
   }
-  if (host && (host->health() == Upstream::Host::Health::Degraded ||
-               host->health() == Upstream::Host::Health::Unhealthy)) {
-    refresh_manager_->onHostDegraded(cluster_name_);
+  for (const auto& host : hosts) {
+    if (host->health() == Upstream::Host::Health::Degraded ||
+        host->health() == Upstream::Host::Health::Unhealthy) {
+      refresh_manager_->onHostDegraded(cluster_name_);
+      break;
+    }
   }
-  ClusterImplBase::reloadHealthyHostsHelper(host);
+  ClusterImplBase::reloadHealthyHostsHelper(hosts);
 }
 
 // DnsDiscoveryResolveTarget
@@ -128,7 +128,7 @@ private:
 
   void onClusterSlotUpdate(ClusterSlotsPtr&&);
 
-  void reloadHealthyHostsHelper(const Upstream::HostSharedPtr& host) override;
+  void reloadHealthyHostsHelper(const Upstream::HostVector& hosts) override;
 
   const envoy::config::endpoint::v3::LocalityLbEndpoints& localityLbEndpoint() const {
     // Always use the first endpoint.
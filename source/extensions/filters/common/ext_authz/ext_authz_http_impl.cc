@@ -98,15 +98,47 @@ createStringMatchers(const envoy::type::matcher::v3::ListStringMatcher& list,
   return matchers;
 }
 
+const std::string* safeRegex(const Matchers::StringMatcher& matcher) {
+  const auto* string_matcher = dynamic_cast<const Matchers::StringMatcherImpl*>(&matcher);
+  if (string_matcher == nullptr ||
+      string_matcher->matcher().match_pattern_case() !=
+          envoy::type::matcher::v3::StringMatcher::MatchPatternCase::kSafeRegex) {
+    return nullptr;
+  }
+  return &string_matcher->matcher().safe_regex().regex();
+}
+
 } // namespace
 
 // Matchers
-HeaderKeyMatcher::HeaderKeyMatcher(std::vector<Matchers::StringMatcherPtr>&& list)
-    : matchers_(std::move(list)) {}
+HeaderKeyMatcher::HeaderKeyMatcher(std::vector<Matchers::StringMatcherPtr>&& list) {
+  // Every header key is tested against the whole list, so match the safe regexes in a single pass.
+  // Each pattern has already been compiled and checked against its max program size on its own.
+  std::vector<std::string> regexes;
+  for (const auto& matcher : list) {
+    const std::string* regex = safeRegex(*matcher);
+    if (regex != nullptr) {
+      regexes.push_back(*regex);
+    }
+  }
+  if (regexes.size() > 1) {
+    try {
+      regex_set_ = std::make_unique<const Regex::CompiledMatcherSet>(regexes);
+    } catch (const EnvoyException&) {
+      // The patterns don't fit in a single set, keep matching them in turn.
+    }
+  }
+  for (auto& matcher : list) {
+    if (regex_set_ == nullptr || safeRegex(*matcher) == nullptr) {
+      matchers_.push_back(std::move(matcher));
+    }
+  }
+}
 
 bool HeaderKeyMatcher::matches(absl::string_view key) const {
   return std::any_of(matchers_.begin(), matchers_.end(),
-                     [&key](auto& matcher) { return matcher->match(key); });
+                     [&key](auto& matcher) { return matcher->match(key); }) ||
+         (regex_set_ != nullptr && regex_set_->matchAny(key));
 }
 
 NotHeaderKeyMatcher::NotHeaderKeyMatcher(std::vector<Matchers::StringMatcherPtr>&& list)
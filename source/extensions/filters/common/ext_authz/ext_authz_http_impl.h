@@ -9,6 +9,7 @@
 
 #include "common/common/logger.h"
 #include "common/common/matchers.h"
+#include "common/common/regex.h"
 #include "common/router/header_parser.h"
 
 #include "extensions/filters/common/ext_authz/ext_authz.h"
@@ -44,7 +45,9 @@ public:
   bool matches(absl::string_view key) const override;
 
 private:
-  const std::vector<Matchers::StringMatcherPtr> matchers_;
+  std::vector<Matchers::StringMatcherPtr> matchers_;
+  // The safe regex patterns of the list, when there are several of them.
+  std::unique_ptr<const Regex::CompiledMatcherSet> regex_set_;
 };
 
 class NotHeaderKeyMatcher : public Matcher {
@@ -22,13 +22,23 @@ public:
     auto entry = cache_.lookup(request_);
     body_ = std::move(entry.body_);
     cb(entry.response_headers_
-           ? request_.makeLookupResult(std::move(entry.response_headers_), body_.size())
+           ? request_.makeLookupResult(std::move(entry.response_headers_), body_->size())
            : LookupResult{});
   }
 
   void getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) override {
-    ASSERT(range.end() <= body_.length(), "Attempt to read past end of body.");
-    cb(std::make_unique<Buffer::OwnedImpl>(&body_[range.begin()], range.length()));
+    ASSERT(body_ != nullptr);
+    ASSERT(range.end() <= body_->length(), "Attempt to read past end of body.");
+    // Reference the cached body instead of copying it. The fragment holds a reference to the body,
+    // so the data stays valid even if the entry is replaced while the response is being sent.
+    auto fragment = new Buffer::BufferFragmentImpl(
+        body_->data() + range.begin(), range.length(),
+        [body = body_](const void*, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+          delete this_fragment;
+        });
+    auto data = std::make_unique<Buffer::OwnedImpl>();
+    data->addBufferFragment(*fragment);
+    cb(std::move(data));
   }
 
   void getTrailers(LookupTrailersCallback&&) override {
@@ -41,7 +51,7 @@ public:
 private:
   SimpleHttpCache& cache_;
   const LookupRequest request_;
-  std::string body_;
+  std::shared_ptr<const std::string> body_;
 };
 
 class SimpleInsertContext : public InsertContext {
@@ -115,7 +125,8 @@ SimpleHttpCache::Entry SimpleHttpCache::lookup(const LookupRequest& request) {
 void SimpleHttpCache::insert(const Key& key, Http::ResponseHeaderMapPtr&& response_headers,
                              std::string&& body) {
   absl::WriterMutexLock lock(&mutex_);
-  map_[key] = SimpleHttpCache::Entry{std::move(response_headers), std::move(body)};
+  map_[key] = SimpleHttpCache::Entry{std::move(response_headers),
+                                     std::make_shared<const std::string>(std::move(body))};
 }
 
 InsertContextPtr SimpleHttpCache::makeInsertContext(LookupContextPtr&& lookup_context) {
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <memory>
+#include <string>
+
 #include "common/protobuf/utility.h"
 
 #include "extensions/filters/http/cache/http_cache.h"
@@ -18,7 +21,8 @@ class SimpleHttpCache : public HttpCache {
 private:
   struct Entry {
     Http::ResponseHeaderMapPtr response_headers_;
-    std::string body_;
+    // Shared with in-flight lookups, so that hits don't copy the body.
+    std::shared_ptr<const std::string> body_;
   };
 
 public:
@@ -22,9 +22,10 @@ ActiveQuicListener::ActiveQuicListener(Event::Dispatcher& dispatcher,
                                        const quic::QuicConfig& quic_config,
                                        Network::Socket::OptionsSharedPtr options,
                                        const envoy::config::core::v3::RuntimeFeatureFlag& enabled)
+    // UDP listen sockets are not bound to a worker.
     : ActiveQuicListener(dispatcher, parent,
-                         listener_config.listenSocketFactory().getListenSocket(), listener_config,
-                         quic_config, std::move(options), enabled) {}
+                         listener_config.listenSocketFactory().getListenSocket(absl::nullopt),
+                         listener_config, quic_config, std::move(options), enabled) {}
 
 ActiveQuicListener::ActiveQuicListener(Event::Dispatcher& dispatcher,
                                        Network::ConnectionHandler& parent,
@@ -77,6 +77,8 @@ public:
     NOT_REACHED_GCOVR_EXCL_LINE;
   }
   bool aboveHighWatermark() const override;
+  // QUIC streams are not accounted yet.
+  Buffer::BufferMemoryAccountSharedPtr bufferMemoryAccount() const override { return nullptr; }
 
   const Network::ConnectionSocket::OptionsSharedPtr& socketOptions() const override;
   StreamInfo::StreamInfo& streamInfo() override { return stream_info_; }
@@ -0,0 +1,167 @@
+#include "extensions/transport_sockets/tls/cert_store_cache.h"
+
+#include "envoy/common/exception.h"
+
+#include "common/common/assert.h"
+
+#include "absl/strings/str_cat.h"
+#include "openssl/sha.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+namespace {
+
+// A X509_STORE_CTX_verify_cb callback for ignoring cert expiration in X509_verify_cert().
+int ignoreCertificateExpirationCallback(int ok, X509_STORE_CTX* store_ctx) {
+  if (!ok) {
+    int err = X509_STORE_CTX_get_error(store_ctx);
+    if (err == X509_V_ERR_CERT_HAS_EXPIRED || err == X509_V_ERR_CERT_NOT_YET_VALID) {
+      return 1;
+    }
+  }
+
+  return ok;
+}
+
+void hashField(SHA256_CTX& sha256, const std::string& field) {
+  // Prefix each field with its length so that the digest of one split of the material can't
+  // collide with another.
+  const uint64_t length = field.size();
+  SHA256_Update(&sha256, &length, sizeof(length));
+  SHA256_Update(&sha256, field.data(), field.size());
+}
+
+} // namespace
+
+CertStoreConstSharedPtr
+CertStoreCache::getOrCreate(const Ssl::CertificateValidationContextConfig& config) {
+  const std::string store_key = key(config);
+  absl::MutexLock lock(&mutex_);
+  auto it = stores_.find(store_key);
+  if (it != stores_.end()) {
+    CertStoreConstSharedPtr store = it->second.lock();
+    if (store != nullptr) {
+      return store;
+    }
+  }
+
+  CertStoreConstSharedPtr store = create(config);
+  // Forget the stores no context uses anymore. There are few distinct trust stores, so this is
+  // cheap compared to building one.
+  for (auto expired = stores_.begin(); expired != stores_.end();) {
+    if (expired->second.expired()) {
+      stores_.erase(expired++);
+    } else {
+      ++expired;
+    }
+  }
+  stores_[store_key] = store;
+  return store;
+}
+
+size_t CertStoreCache::size() {
+  absl::MutexLock lock(&mutex_);
+  size_t size = 0;
+  for (const auto& store : stores_) {
+    if (!store.second.expired()) {
+      ++size;
+    }
+  }
+  return size;
+}
+
+std::string CertStoreCache::key(const Ssl::CertificateValidationContextConfig& config) {
+  SHA256_CTX sha256;
+  SHA256_Init(&sha256);
+  hashField(sha256, config.caCert());
+  hashField(sha256, config.certificateRevocationList());
+  const uint8_t allow_expired = config.allowExpiredCertificate();
+  SHA256_Update(&sha256, &allow_expired, sizeof(allow_expired));
+  std::string digest(SHA256_DIGEST_LENGTH, 0);
+  SHA256_Final(reinterpret_cast<uint8_t*>(&digest[0]), &sha256);
+  return digest;
+}
+
+CertStoreConstSharedPtr
+CertStoreCache::create(const Ssl::CertificateValidationContextConfig& config) {
+  auto cert_store = std::make_shared<CertStore>();
+  cert_store->store_.reset(X509_STORE_new());
+  RELEASE_ASSERT(cert_store->store_ != nullptr, "");
+  X509_STORE* store = cert_store->store_.get();
+
+  if (!config.caCert().empty()) {
+    bssl::UniquePtr<BIO> bio(
+        BIO_new_mem_buf(const_cast<char*>(config.caCert().data()), config.caCert().size()));
+    RELEASE_ASSERT(bio != nullptr, "");
+    // Based on BoringSSL's X509_load_cert_crl_file().
+    bssl::UniquePtr<STACK_OF(X509_INFO)> list(
+        PEM_X509_INFO_read_bio(bio.get(), nullptr, nullptr, nullptr));
+    if (list == nullptr) {
+      throw EnvoyException(
+          absl::StrCat("Failed to load trusted CA certificates from ", config.caCertPath()));
+    }
+
+    bool has_crl = false;
+    for (const X509_INFO* item : list.get()) {
+      if (item->x509) {
+        X509_STORE_add_cert(store, item->x509);
+        if (cert_store->ca_cert_ == nullptr) {
+          X509_up_ref(item->x509);
+          cert_store->ca_cert_.reset(item->x509);
+        }
+      }
+      if (item->crl) {
+        X509_STORE_add_crl(store, item->crl);
+        has_crl = true;
+      }
+    }
+    if (cert_store->ca_cert_ == nullptr) {
+      throw EnvoyException(
+          absl::StrCat("Failed to load trusted CA certificates from ", config.caCertPath()));
+    }
+    if (has_crl) {
+      X509_STORE_set_flags(store, X509_V_FLAG_CRL_CHECK | X509_V_FLAG_CRL_CHECK_ALL);
+    }
+
+    // NOTE: We're using SSL_CTX_set_cert_verify_callback() instead of X509_verify_cert()
+    // directly. However, our new callback is still calling X509_verify_cert() under
+    // the hood. Therefore, to ignore cert expiration, we need to set the callback
+    // for X509_verify_cert to ignore that error.
+    if (config.allowExpiredCertificate()) {
+      X509_STORE_set_verify_cb(store, ignoreCertificateExpirationCallback);
+    }
+  }
+
+  if (!config.certificateRevocationList().empty()) {
+    bssl::UniquePtr<BIO> bio(
+        BIO_new_mem_buf(const_cast<char*>(config.certificateRevocationList().data()),
+                        config.certificateRevocationList().size()));
+    RELEASE_ASSERT(bio != nullptr, "");
+
+    // Based on BoringSSL's X509_load_cert_crl_file().
+    bssl::UniquePtr<STACK_OF(X509_INFO)> list(
+        PEM_X509_INFO_read_bio(bio.get(), nullptr, nullptr, nullptr));
+    if (list == nullptr) {
+      throw EnvoyException(
+          absl::StrCat("Failed to load CRL from ", config.certificateRevocationListPath()));
+    }
+
+    for (const X509_INFO* item : list.get()) {
+      if (item->crl) {
+        X509_STORE_add_crl(store, item->crl);
+      }
+    }
+
+    X509_STORE_set_flags(store, X509_V_FLAG_CRL_CHECK | X509_V_FLAG_CRL_CHECK_ALL);
+  }
+
+  return cert_store;
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
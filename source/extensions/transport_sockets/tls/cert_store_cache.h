@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "envoy/ssl/certificate_validation_context_config.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/ssl.h"
+#include "openssl/x509v3.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * The trust store built from the trusted CA certificates and CRLs of a validation context. It is
+ * not modified once built, so any number of SSL_CTXs may share it.
+ */
+struct CertStore {
+  bssl::UniquePtr<X509_STORE> store_;
+  // The first trusted CA certificate, if any, as reported by the admin /certs endpoint.
+  bssl::UniquePtr<X509> ca_cert_;
+};
+
+using CertStoreConstSharedPtr = std::shared_ptr<const CertStore>;
+
+/**
+ * Shares trust stores between the contexts whose validation contexts have the same trusted CA
+ * certificates, CRLs and expiration handling, so that a CA bundle used by many clusters or filter
+ * chains is parsed and held in memory once. Stores are keyed by a SHA-256 digest of that material
+ * and only live as long as a context uses them: when SDS delivers a new validation context, the
+ * contexts built from it get a new store, and the old store is released with the last context
+ * using it. Stores may be looked up and released from any thread.
+ */
+class CertStoreCache {
+public:
+  /**
+   * @param config supplies a validation context with a trusted CA or a CRL.
+   * @return CertStoreConstSharedPtr the trust store for the validation context, which is built if
+   *         no context uses it yet.
+   * @throw EnvoyException if the trusted CA certificates or the CRL cannot be loaded.
+   */
+  CertStoreConstSharedPtr getOrCreate(const Ssl::CertificateValidationContextConfig& config);
+
+  /**
+   * @return size_t the number of trust stores in use.
+   */
+  size_t size();
+
+private:
+  static std::string key(const Ssl::CertificateValidationContextConfig& config);
+  static CertStoreConstSharedPtr create(const Ssl::CertificateValidationContextConfig& config);
+
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, std::weak_ptr<const CertStore>> stores_ ABSL_GUARDED_BY(mutex_);
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -8,6 +8,7 @@
 #include "envoy/ssl/private_key/private_key.h"
 #include "envoy/stats/scope.h"
 
+#include "extensions/transport_sockets/tls/cert_store_cache.h"
 #include "extensions/transport_sockets/tls/private_key/private_key_manager_impl.h"
 
 namespace Envoy {
@@ -40,11 +41,17 @@ public:
     return private_key_method_manager_;
   };
 
+  /**
+   * @return CertStoreCache& the trust stores shared by the contexts.
+   */
+  CertStoreCache& certStoreCache() { return cert_store_cache_; }
+
 private:
   void removeEmptyContexts();
   TimeSource& time_source_;
   std::list<std::weak_ptr<Envoy::Ssl::Context>> contexts_;
   PrivateKeyMethodManagerImpl private_key_method_manager_{};
+  CertStoreCache cert_store_cache_;
 };
 
 } // namespace Tls
@@ -6,6 +6,7 @@
 #include "common/common/empty_string.h"
 #include "common/common/hex.h"
 #include "common/http/headers.h"
+#include "common/runtime/runtime_features.h"
 
 #include "extensions/transport_sockets/tls/utility.h"
 
@@ -45,7 +46,10 @@ public:
 SslSocket::SslSocket(Envoy::Ssl::ContextSharedPtr ctx, InitialState state,
                      const Network::TransportSocketOptionsSharedPtr& transport_socket_options)
     : transport_socket_options_(transport_socket_options),
-      ctx_(std::dynamic_pointer_cast<ContextImpl>(ctx)), state_(SocketState::PreHandshake) {
+      ctx_(std::dynamic_pointer_cast<ContextImpl>(ctx)),
+      write_from_front_slice_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.tls_write_from_front_slice")),
+      state_(SocketState::PreHandshake) {
   bssl::UniquePtr<SSL> ssl = ctx_->newSsl(transport_socket_options_.get());
   ssl_ = ssl.get();
   info_ = std::make_shared<SslSocketInfo>(std::move(ssl), ctx_);
@@ -255,7 +259,23 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
     // it again with the same parameters. This is done by tracking last write size, but not write
     // data, since linearize() will return the same undrained data anyway.
     ASSERT(bytes_to_write <= write_buffer.length());
-    int rc = SSL_write(ssl_, write_buffer.linearize(bytes_to_write), bytes_to_write);
+    const void* data = nullptr;
+    if (write_from_front_slice_) {
+      // Encrypt straight out of the first slice when it holds enough data for a reasonably sized
+      // record. linearize() copies every slice spanned by the write into a new one, which for
+      // slices that don't line up with the record size means copying almost every byte sent.
+      const Buffer::RawSlice front = write_buffer.getRawSlices(1).front();
+      if (front.len_ >= bytes_to_write) {
+        data = front.mem_;
+      } else if (front.len_ >= MinFrontSliceWriteSize) {
+        bytes_to_write = front.len_;
+        data = front.mem_;
+      }
+    }
+    if (data == nullptr) {
+      data = write_buffer.linearize(bytes_to_write);
+    }
+    int rc = SSL_write(ssl_, data, bytes_to_write);
     ENVOY_CONN_LOG(trace, "ssl write returns: {}", callbacks_->connection(), rc);
     if (rc > 0) {
       ASSERT(rc == static_cast<int>(bytes_to_write));
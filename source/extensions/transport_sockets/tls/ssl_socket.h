@@ -121,6 +121,9 @@ public:
   SSL* rawSslForTest() const { return ssl_; }
 
 private:
+  // Smallest first slice that is written as its own record rather than linearized.
+  static constexpr uint64_t MinFrontSliceWriteSize = 4096;
+
   struct ReadResult {
     bool commit_slice_{};
     absl::optional<int> error_;
@@ -137,6 +140,7 @@ private:
   const Network::TransportSocketOptionsSharedPtr transport_socket_options_;
   Network::TransportSocketCallbacks* callbacks_{};
   ContextImplSharedPtr ctx_;
+  const bool write_from_front_slice_;
   uint64_t bytes_to_retry_{};
   std::string failure_reason_;
   SocketState state_;
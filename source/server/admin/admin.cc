@@ -598,6 +598,10 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server)
            MAKE_ADMIN_HANDLER(logs_handler_.handlerLogging), false, true},
           {"/memory", "print current allocation/heap usage",
            MAKE_ADMIN_HANDLER(server_info_handler_.handlerMemory), false, false},
+          {"/regexes", "print the compiled regexes and their RE2 program sizes",
+           MAKE_ADMIN_HANDLER(server_info_handler_.handlerRegexes), false, false},
+          {"/buffer_memory", "print the connections and streams buffering the most bytes",
+           MAKE_ADMIN_HANDLER(server_info_handler_.handlerBufferMemory), false, false},
           {"/quitquitquit", "exit the server",
            MAKE_ADMIN_HANDLER(server_cmd_handler_.handlerQuitQuitQuit), false, true},
           {"/reset_counters", "reset all counters to zero",
@@ -298,7 +298,7 @@ private:
       return socket_->localAddress();
     }
 
-    Network::SocketSharedPtr getListenSocket() override {
+    Network::SocketSharedPtr getListenSocket(absl::optional<uint32_t>) override {
       // This is only supposed to be called once.
       RELEASE_ASSERT(!socket_create_, "AdminListener's socket shouldn't be shared.");
       socket_create_ = true;
@@ -306,6 +306,7 @@ private:
     }
 
     Network::SocketOptRef sharedSocket() const override { return absl::nullopt; }
+    Network::SocketSharedPtr workerSocket(uint32_t) const override { return nullptr; }
 
   private:
     Network::SocketSharedPtr socket_;
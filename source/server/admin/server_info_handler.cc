@@ -2,11 +2,16 @@
 
 #include "envoy/admin/v3/memory.pb.h"
 
+#include "common/common/regex.h"
 #include "common/common/version.h"
 #include "common/memory/stats.h"
+#include "common/protobuf/protobuf.h"
+#include "common/protobuf/utility.h"
 
 #include "server/admin/utils.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -56,6 +61,66 @@ Http::Code ServerInfoHandler::handlerMemory(absl::string_view,
   return Http::Code::OK;
 }
 
+Http::Code ServerInfoHandler::handlerRegexes(absl::string_view,
+                                             Http::ResponseHeaderMap& response_headers,
+                                             Buffer::Instance& response, AdminStream&) {
+  response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
+  std::vector<ProtobufWkt::Value> regexes;
+  for (const Regex::CompiledRegexCache::Entry& entry : Regex::CompiledRegexCache::get().entries()) {
+    ProtobufWkt::Struct regex;
+    auto* fields = regex.mutable_fields();
+    (*fields)["regex"] = ValueUtil::stringValue(entry.regex_);
+    (*fields)["program_size"] = ValueUtil::numberValue(entry.program_size_);
+    (*fields)["references"] = ValueUtil::numberValue(entry.references_);
+    regexes.push_back(ValueUtil::structValue(regex));
+  }
+
+  ProtobufWkt::Struct output;
+  (*output.mutable_fields())["regexes"] = ValueUtil::listValue(regexes);
+  response.add(MessageUtil::getJsonStringFromMessage(output, true, true)); // pretty-print
+  return Http::Code::OK;
+}
+
+namespace {
+
+ProtobufWkt::Value accountsValue(const std::vector<Buffer::BufferMemoryAccountBalance>& accounts) {
+  std::vector<ProtobufWkt::Value> values;
+  for (const Buffer::BufferMemoryAccountBalance& account : accounts) {
+    ProtobufWkt::Struct value;
+    auto* fields = value.mutable_fields();
+    (*fields)["description"] = ValueUtil::stringValue(account.description_);
+    (*fields)["buffered_bytes"] = ValueUtil::numberValue(account.balance_);
+    if (!account.children_.empty()) {
+      (*fields)["children"] = accountsValue(account.children_);
+    }
+    values.push_back(ValueUtil::structValue(value));
+  }
+  return ValueUtil::listValue(values);
+}
+
+} // namespace
+
+Http::Code ServerInfoHandler::handlerBufferMemory(absl::string_view,
+                                                  Http::ResponseHeaderMap& response_headers,
+                                                  Buffer::Instance& response, AdminStream&) {
+  response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
+  std::vector<ProtobufWkt::Value> workers;
+  uint32_t index = 0;
+  for (const auto& accounts : server_.listenerManager().largestBufferMemoryAccounts()) {
+    ProtobufWkt::Struct worker;
+    auto* fields = worker.mutable_fields();
+    // Workers are named after their index, see ListenerManagerImpl.
+    (*fields)["worker"] = ValueUtil::stringValue(absl::StrCat("worker_", index++));
+    (*fields)["accounts"] = accountsValue(accounts);
+    workers.push_back(ValueUtil::structValue(worker));
+  }
+
+  ProtobufWkt::Struct output;
+  (*output.mutable_fields())["workers"] = ValueUtil::listValue(workers);
+  response.add(MessageUtil::getJsonStringFromMessage(output, true, true)); // pretty-print
+  return Http::Code::OK;
+}
+
 Http::Code ServerInfoHandler::handlerReady(absl::string_view, Http::ResponseHeaderMap&,
                                            Buffer::Instance& response, AdminStream&) {
   const envoy::admin::v3::ServerInfo::State state =
@@ -37,6 +37,14 @@ public:
   Http::Code handlerMemory(absl::string_view path_and_query,
                            Http::ResponseHeaderMap& response_headers, Buffer::Instance& response,
                            AdminStream&);
+
+  Http::Code handlerRegexes(absl::string_view path_and_query,
+                            Http::ResponseHeaderMap& response_headers, Buffer::Instance& response,
+                            AdminStream&);
+
+  Http::Code handlerBufferMemory(absl::string_view path_and_query,
+                                 Http::ResponseHeaderMap& response_headers,
+                                 Buffer::Instance& response, AdminStream&);
 };
 
 } // namespace Server
@@ -125,6 +125,9 @@ protected:
       uint32_t bufferLimit() const override { return 65000; }
       bool localAddressRestored() const override { return false; }
       bool aboveHighWatermark() const override { return false; }
+      Buffer::BufferMemoryAccountSharedPtr bufferMemoryAccount() const override {
+        return nullptr;
+      }
       const Network::ConnectionSocket::OptionsSharedPtr& socketOptions() const override {
         return options_;
       }
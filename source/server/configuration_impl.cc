@@ -55,7 +55,8 @@ void FilterChainUtility::buildUdpFilterChain(
 
 void MainImpl::initialize(const envoy::config::bootstrap::v3::Bootstrap& bootstrap,
                           Instance& server,
-                          Upstream::ClusterManagerFactory& cluster_manager_factory) {
+                          Upstream::ClusterManagerFactory& cluster_manager_factory,
+                          StartupPhases* startup_phases) {
   // In order to support dynamic configuration of tracing providers,
   // a former server-wide HttpTracer singleton has been replaced by
   // an HttpTracer instance per "envoy.filters.network.http_connection_manager" filter.
@@ -73,14 +74,24 @@ void MainImpl::initialize(const envoy::config::bootstrap::v3::Bootstrap& bootstr
   }
 
   ENVOY_LOG(info, "loading {} cluster(s)", bootstrap.static_resources().clusters().size());
+  if (startup_phases != nullptr) {
+    startup_phases->begin("static_clusters");
+  }
   cluster_manager_ = cluster_manager_factory.clusterManagerFromProto(bootstrap);
 
   const auto& listeners = bootstrap.static_resources().listeners();
   ENVOY_LOG(info, "loading {} listener(s)", listeners.size());
+  if (startup_phases != nullptr) {
+    startup_phases->complete("static_clusters");
+    startup_phases->begin("static_listeners");
+  }
   for (ssize_t i = 0; i < listeners.size(); i++) {
     ENVOY_LOG(debug, "listener #{}:", i);
     server.listenerManager().addOrUpdateListener(listeners[i], "", false);
   }
+  if (startup_phases != nullptr) {
+    startup_phases->complete("static_listeners");
+  }
 
   stats_flush_interval_ =
       std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(bootstrap, stats_flush_interval, 5000));
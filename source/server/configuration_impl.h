@@ -23,6 +23,8 @@
 #include "common/network/resolver_impl.h"
 #include "common/network/utility.h"
 
+#include "server/startup_phases.h"
+
 namespace Envoy {
 namespace Server {
 namespace Configuration {
@@ -93,9 +95,12 @@ public:
    * @param bootstrap v2 bootstrap proto.
    * @param server supplies the owning server.
    * @param cluster_manager_factory supplies the cluster manager creation factory.
+   * @param startup_phases supplies where to record the duration of the loading of the static
+   *        resources, if anywhere.
    */
   void initialize(const envoy::config::bootstrap::v3::Bootstrap& bootstrap, Instance& server,
-                  Upstream::ClusterManagerFactory& cluster_manager_factory);
+                  Upstream::ClusterManagerFactory& cluster_manager_factory,
+                  StartupPhases* startup_phases = nullptr);
 
   // Server::Configuration::Main
   Upstream::ClusterManager* clusterManager() override { return cluster_manager_.get(); }
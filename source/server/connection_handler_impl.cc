@@ -16,8 +16,10 @@
 namespace Envoy {
 namespace Server {
 
-ConnectionHandlerImpl::ConnectionHandlerImpl(Event::Dispatcher& dispatcher)
-    : dispatcher_(dispatcher), per_handler_stat_prefix_(dispatcher.name() + "."),
+ConnectionHandlerImpl::ConnectionHandlerImpl(Event::Dispatcher& dispatcher,
+                                             absl::optional<uint32_t> worker_index)
+    : dispatcher_(dispatcher), worker_index_(worker_index),
+      per_handler_stat_prefix_(dispatcher.name() + "."),
       disable_listeners_(false) {}
 
 void ConnectionHandlerImpl::incNumConnections() { ++num_handler_connections_; }
@@ -139,8 +141,9 @@ ConnectionHandlerImpl::ActiveTcpListener::ActiveTcpListener(ConnectionHandlerImp
                                                             Network::ListenerConfig& config)
     : ActiveTcpListener(
           parent,
-          parent.dispatcher_.createListener(config.listenSocketFactory().getListenSocket(), *this,
-                                            config.bindToPort()),
+          parent.dispatcher_.createListener(
+              config.listenSocketFactory().getListenSocket(parent.worker_index_),
+              *this, config.bindToPort()),
           config) {}
 
 ConnectionHandlerImpl::ActiveTcpListener::ActiveTcpListener(ConnectionHandlerImpl& parent,
@@ -155,7 +158,10 @@ ConnectionHandlerImpl::ActiveTcpListener::ActiveTcpListener(ConnectionHandlerImp
 void ConnectionHandlerImpl::ActiveTcpListener::updateListenerConfig(
     Network::ListenerConfig& config) {
   ENVOY_LOG(trace, "replacing listener ", config_->listenerTag(), " by ", config.listenerTag());
+  // The new listener config comes with its own connection balancer.
+  config_->connectionBalancer().unregisterHandler(*this);
   config_ = &config;
+  config_->connectionBalancer().registerHandler(*this);
 }
 
 ConnectionHandlerImpl::ActiveTcpListener::~ActiveTcpListener() {
@@ -524,10 +530,11 @@ ConnectionHandlerImpl::ActiveTcpConnection::~ActiveTcpConnection() {
 ActiveRawUdpListener::ActiveRawUdpListener(Network::ConnectionHandler& parent,
                                            Event::Dispatcher& dispatcher,
                                            Network::ListenerConfig& config)
-    : ActiveRawUdpListener(
-          parent,
-          dispatcher.createUdpListener(config.listenSocketFactory().getListenSocket(), *this),
-          config) {}
+    : ActiveRawUdpListener(parent,
+                           // UDP listen sockets are not bound to a worker.
+                           dispatcher.createUdpListener(
+                               config.listenSocketFactory().getListenSocket(absl::nullopt), *this),
+                           config) {}
 
 ActiveRawUdpListener::ActiveRawUdpListener(Network::ConnectionHandler& parent,
                                            Network::UdpListenerPtr&& listener,
@@ -61,7 +61,11 @@ class ConnectionHandlerImpl : public Network::ConnectionHandler,
                               NonCopyable,
                               Logger::Loggable<Logger::Id::conn_handler> {
 public:
-  ConnectionHandlerImpl(Event::Dispatcher& dispatcher);
+  /**
+   * @param dispatcher supplies the dispatcher the handler's listeners run on.
+   * @param worker_index supplies the index of the owning worker, or nullopt for the main thread.
+   */
+  ConnectionHandlerImpl(Event::Dispatcher& dispatcher, absl::optional<uint32_t> worker_index);
 
   // Network::ConnectionHandler
   uint64_t numConnections() const override { return num_handler_connections_; }
@@ -133,6 +137,8 @@ private:
     uint64_t numConnections() const override { return num_listener_connections_; }
     void incNumConnections() override { ++num_listener_connections_; }
     void post(Network::ConnectionSocketPtr&& socket) override;
+    void setBalancerIndex(uint32_t index) override { balancer_index_ = index; }
+    uint32_t balancerIndex() const override { return balancer_index_; }
 
     /**
      * Remove and destroy an active connection.
@@ -173,6 +179,7 @@ private:
     // The number of connections currently active on this listener. This is typically used for
     // connection balancing across per-handler listeners.
     std::atomic<uint64_t> num_listener_connections_{};
+    uint32_t balancer_index_{};
     bool is_deleting_{false};
   };
 
@@ -315,6 +322,7 @@ private:
   ActiveTcpListenerOptRef findActiveTcpListenerByAddress(const Network::Address::Instance& address);
 
   Event::Dispatcher& dispatcher_;
+  const absl::optional<uint32_t> worker_index_;
   const std::string per_handler_stat_prefix_;
   std::list<std::pair<Network::Address::InstanceConstSharedPtr, ActiveListenerDetails>> listeners_;
   std::atomic<uint64_t> num_handler_connections_{};
@@ -20,7 +20,7 @@ namespace Server {
 namespace {
 
 // Return a fake address for use when either the source or destination is UDS.
-Network::Address::InstanceConstSharedPtr fakeAddress() {
+const Network::Address::InstanceConstSharedPtr& fakeAddress() {
   CONSTRUCT_ON_FIRST_USE(Network::Address::InstanceConstSharedPtr,
                          Network::Utility::parseInternetAddress("255.255.255.255"));
 }
@@ -151,6 +151,9 @@ void FilterChainManagerImpl::addFilterChain(
   Cleanup cleanup([this]() { origin_ = absl::nullopt; });
   std::unordered_set<envoy::config::listener::v3::FilterChainMatch, MessageUtil, MessageUtil>
       filter_chains;
+  // Hashing a filter chain message is expensive, so avoid rehashing the messages as the sets grow.
+  filter_chains.reserve(filter_chain_span.size());
+  fc_contexts_.reserve(filter_chain_span.size());
   uint32_t new_filter_chain_size = 0;
   for (const auto& filter_chain : filter_chain_span) {
     const auto& filter_chain_match = filter_chain->filter_chain_match();
@@ -208,7 +211,7 @@ void FilterChainManagerImpl::addFilterChain(
         filter_chain_match.server_names(), filter_chain_match.transport_protocol(),
         filter_chain_match.application_protocols(), filter_chain_match.source_type(), source_ips,
         filter_chain_match.source_ports(), filter_chain_impl);
-    fc_contexts_[*filter_chain] = filter_chain_impl;
+    fc_contexts_.emplace(*filter_chain, filter_chain_impl);
   }
   convertIPsToTries();
   ENVOY_LOG(debug, "new fc_contexts has {} filter chains, including {} newly built",
@@ -400,16 +403,14 @@ FilterChainManagerImpl::findFilterChain(const Network::ConnectionSocket& socket)
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDestinationIP(
     const DestinationIPsTrie& destination_ips_trie, const Network::ConnectionSocket& socket) const {
-  auto address = socket.localAddress();
-  if (address->type() != Network::Address::Type::Ip) {
-    address = fakeAddress();
-  }
+  const auto& address = socket.localAddress()->type() == Network::Address::Type::Ip
+                            ? socket.localAddress()
+                            : fakeAddress();
 
   // Match on both: exact IP and wider CIDR ranges using LcTrie.
-  const auto& data = destination_ips_trie.getData(address);
-  if (!data.empty()) {
-    ASSERT(data.size() == 1);
-    return findFilterChainForServerName(*data.back(), socket);
+  const ServerNamesMapSharedPtr* data = destination_ips_trie.getFirstData(address);
+  if (data != nullptr) {
+    return findFilterChainForServerName(**data, socket);
   }
 
   return nullptr;
@@ -417,7 +418,8 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDestinatio
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName(
     const ServerNamesMap& server_names_map, const Network::ConnectionSocket& socket) const {
-  const std::string server_name(socket.requestedServerName());
+  // The maps are looked up by string_view, so that matching allocates no strings.
+  const absl::string_view server_name = socket.requestedServerName();
 
   // Match on exact server name, i.e. "www.example.com" for "www.example.com".
   const auto server_name_exact_match = server_names_map.find(server_name);
@@ -427,8 +429,8 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
 
   // Match on all wildcard domains, i.e. ".example.com" and ".com" for "www.example.com".
   size_t pos = server_name.find('.', 1);
-  while (pos < server_name.size() - 1 && pos != std::string::npos) {
-    const std::string wildcard = server_name.substr(pos);
+  while (pos < server_name.size() - 1 && pos != absl::string_view::npos) {
+    const absl::string_view wildcard = server_name.substr(pos);
     const auto server_name_wildcard_match = server_names_map.find(wildcard);
     if (server_name_wildcard_match != server_names_map.end()) {
       return findFilterChainForTransportProtocol(server_name_wildcard_match->second, socket);
@@ -448,7 +450,7 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForTransportProtocol(
     const TransportProtocolsMap& transport_protocols_map,
     const Network::ConnectionSocket& socket) const {
-  const std::string transport_protocol(socket.detectedTransportProtocol());
+  const absl::string_view transport_protocol = socket.detectedTransportProtocol();
 
   // Match on exact transport protocol, e.g. "tls".
   const auto transport_protocol_match = transport_protocols_map.find(transport_protocol);
@@ -521,19 +523,17 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceType
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceIpAndPort(
     const SourceIPsTrie& source_ips_trie, const Network::ConnectionSocket& socket) const {
-  auto address = socket.remoteAddress();
-  if (address->type() != Network::Address::Type::Ip) {
-    address = fakeAddress();
-  }
+  const auto& address = socket.remoteAddress()->type() == Network::Address::Type::Ip
+                            ? socket.remoteAddress()
+                            : fakeAddress();
 
   // Match on both: exact IP and wider CIDR ranges using LcTrie.
-  const auto& data = source_ips_trie.getData(address);
-  if (data.empty()) {
+  const SourcePortsMapSharedPtr* data = source_ips_trie.getFirstData(address);
+  if (data == nullptr) {
     return nullptr;
   }
 
-  ASSERT(data.size() == 1);
-  const auto& source_ports_map = *data.back();
+  const auto& source_ports_map = **data;
   const uint32_t source_port = address->ip()->port();
   const auto port_match = source_ports_map.find(source_port);
 
@@ -602,8 +602,7 @@ std::shared_ptr<Network::DrainableFilterChain> FilterChainManagerImpl::findExist
   }
   auto iter = origin->fc_contexts_.find(filter_chain_message);
   if (iter != origin->fc_contexts_.end()) {
-    // copy the context to this filter chain manager.
-    fc_contexts_.emplace(filter_chain_message, iter->second);
+    // The caller copies the context to this filter chain manager.
     return iter->second;
   }
   return nullptr;
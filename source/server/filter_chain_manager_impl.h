@@ -287,7 +287,7 @@ private:
                                     const Network::ConnectionSocket& socket) const;
 
   const FilterChainManagerImpl* getOriginFilterChainManager() { return origin_.value(); }
-  // Duplicate the inherent factory context if any.
+  // Return the filter chain of the origin filter chain manager built from the same message, if any.
   std::shared_ptr<Network::DrainableFilterChain>
   findExistingFilterChain(const envoy::config::listener::v3::FilterChain& filter_chain_message);
 
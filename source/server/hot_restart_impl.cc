@@ -113,8 +113,9 @@ void HotRestartImpl::drainParentListeners() {
   shmem_->flags_ &= ~SHMEM_FLAGS_INITIALIZING;
 }
 
-int HotRestartImpl::duplicateParentListenSocket(const std::string& address) {
-  return as_child_.duplicateParentListenSocket(address);
+int HotRestartImpl::duplicateParentListenSocket(const std::string& address,
+                                                absl::optional<uint32_t> worker_index) {
+  return as_child_.duplicateParentListenSocket(address, worker_index);
 }
 
 void HotRestartImpl::initialize(Event::Dispatcher& dispatcher, Server::Instance& server) {
@@ -102,7 +102,8 @@ public:
 
   // Server::HotRestart
   void drainParentListeners() override;
-  int duplicateParentListenSocket(const std::string& address) override;
+  int duplicateParentListenSocket(const std::string& address,
+                                  absl::optional<uint32_t> worker_index) override;
   void initialize(Event::Dispatcher& dispatcher, Server::Instance& server) override;
   void sendParentAdminShutdownRequest(time_t& original_start_time) override;
   void sendParentTerminateRequest() override;
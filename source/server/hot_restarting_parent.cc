@@ -114,7 +114,16 @@ HotRestartingParent::Internal::getListenSocketsForChild(const HotRestartMessage:
   for (const auto& listener : server_->listenerManager().listeners()) {
     Network::ListenSocketFactory& socket_factory = listener.get().listenSocketFactory();
     if (*socket_factory.localAddress() == *addr && listener.get().bindToPort()) {
-      if (socket_factory.sharedSocket().has_value()) {
+      if (request.pass_listen_socket().worker_socket()) {
+        // Passing each worker's socket of a steered SO_REUSEPORT group keeps the sockets in the
+        // group, in worker order, once this process closes its own copies.
+        Network::SocketSharedPtr socket =
+            socket_factory.workerSocket(request.pass_listen_socket().worker_index());
+        if (socket != nullptr) {
+          wrapped_reply.mutable_reply()->mutable_pass_listen_socket()->set_fd(
+              socket->ioHandle().fd());
+        }
+      } else if (socket_factory.sharedSocket().has_value()) {
         // Pass the socket to the new process iff it is already shared across workers.
         wrapped_reply.mutable_reply()->mutable_pass_listen_socket()->set_fd(
             socket_factory.sharedSocket()->get().ioHandle().fd());
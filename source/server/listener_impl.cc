@@ -13,6 +13,7 @@
 #include "common/config/utility.h"
 #include "common/network/connection_balancer_impl.h"
 #include "common/network/resolver_impl.h"
+#include "common/network/reuse_port_cpu_steering_socket_option_impl.h"
 #include "common/network/socket_option_factory.h"
 #include "common/network/utility.h"
 #include "common/protobuf/utility.h"
@@ -28,6 +29,8 @@
 #include "extensions/filters/listener/well_known_names.h"
 #include "extensions/transport_sockets/well_known_names.h"
 
+#include "absl/container/flat_hash_set.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -56,7 +59,8 @@ ListenSocketFactoryImpl::ListenSocketFactoryImpl(ListenerComponentFactory& facto
                                                  Network::Socket::Type socket_type,
                                                  const Network::Socket::OptionsSharedPtr& options,
                                                  bool bind_to_port,
-                                                 const std::string& listener_name, bool reuse_port)
+                                                 const std::string& listener_name, bool reuse_port,
+                                                 uint32_t worker_socket_count)
     : factory_(factory), local_address_(address), socket_type_(socket_type), options_(options),
       bind_to_port_(bind_to_port), listener_name_(listener_name), reuse_port_(reuse_port) {
 
@@ -81,7 +85,9 @@ ListenSocketFactoryImpl::ListenSocketFactoryImpl(ListenerComponentFactory& facto
   }
 
   if (create_socket) {
-    socket_ = createListenSocketAndApplyOptions();
+    // With steering, the socket reserving the port number is the first worker's.
+    socket_ = createListenSocketAndApplyOptions(
+        worker_socket_count > 0 ? absl::make_optional<uint32_t>(0) : absl::nullopt);
   }
 
   if (socket_ && local_address_->ip() && local_address_->ip()->port() == 0) {
@@ -89,12 +95,31 @@ ListenSocketFactoryImpl::ListenSocketFactoryImpl(ListenerComponentFactory& facto
   }
   ENVOY_LOG(debug, "Set listener {} socket factory local address to {}", listener_name_,
             local_address_->asString());
+
+  if (worker_socket_count > 0) {
+    ASSERT(reuse_port_);
+    // Sockets join the SO_REUSEPORT group in creation order, so create them here on the main
+    // thread in worker order rather than on the workers, which race each other. The socket created
+    // above for reserving the port number is the first one.
+    // On hot restart, each socket is duplicated from the parent's socket of the same worker, so
+    // the group keeps its order when the parent closes its copies.
+    Thread::LockGuard lock(worker_sockets_lock_);
+    worker_sockets_.reserve(worker_socket_count);
+    if (socket_ != nullptr) {
+      worker_sockets_.push_back(std::move(socket_));
+    }
+    while (worker_sockets_.size() < worker_socket_count) {
+      worker_sockets_.push_back(createListenSocketAndApplyOptions(worker_sockets_.size()));
+    }
+    taken_worker_sockets_.resize(worker_socket_count);
+  }
 }
 
-Network::SocketSharedPtr ListenSocketFactoryImpl::createListenSocketAndApplyOptions() {
+Network::SocketSharedPtr
+ListenSocketFactoryImpl::createListenSocketAndApplyOptions(absl::optional<uint32_t> worker_index) {
   // socket might be nullptr depending on factory_ implementation.
   Network::SocketSharedPtr socket = factory_.createListenSocket(
-      local_address_, socket_type_, options_, {bind_to_port_, !reuse_port_});
+      local_address_, socket_type_, options_, {bind_to_port_, !reuse_port_, worker_index});
 
   // Binding is done by now.
   ENVOY_LOG(debug, "Create listen socket for listener {} on address {}", listener_name_,
@@ -118,11 +143,35 @@ Network::SocketSharedPtr ListenSocketFactoryImpl::createListenSocketAndApplyOpti
   return socket;
 }
 
-Network::SocketSharedPtr ListenSocketFactoryImpl::getListenSocket() {
+Network::SocketSharedPtr
+ListenSocketFactoryImpl::getListenSocket(absl::optional<uint32_t> worker_index) {
   if (!reuse_port_) {
     return socket_;
   }
 
+  // Listeners not owned by a worker get a socket of their own, which joins the group after the
+  // worker sockets and is never picked by the steering program.
+  if (worker_index.has_value()) {
+    Thread::LockGuard lock(worker_sockets_lock_);
+    if (!worker_sockets_.empty()) {
+      const uint32_t index = worker_index.value();
+      ASSERT(index < worker_sockets_.size());
+      if (worker_sockets_[index] != nullptr) {
+        taken_worker_sockets_[index] = worker_sockets_[index];
+        return std::move(worker_sockets_[index]);
+      }
+      // A listener update creates the worker's listener again while the previous one still holds
+      // the socket, so share it. Otherwise the socket has left the group and a new one joins it
+      // at the end, after which the group no longer follows worker order.
+      Network::SocketSharedPtr socket = taken_worker_sockets_[index].lock();
+      if (socket != nullptr) {
+        return socket;
+      }
+      ENVOY_LOG(debug, "Worker {} socket of listener {} was closed, creating a new one", index,
+                listener_name_);
+    }
+  }
+
   Network::SocketSharedPtr socket;
   absl::call_once(steal_once_, [this, &socket]() {
     if (socket_) {
@@ -144,6 +193,17 @@ Network::SocketSharedPtr ListenSocketFactoryImpl::getListenSocket() {
   return createListenSocketAndApplyOptions();
 }
 
+Network::SocketSharedPtr ListenSocketFactoryImpl::workerSocket(uint32_t worker_index) const {
+  Thread::LockGuard lock(worker_sockets_lock_);
+  if (worker_index >= worker_sockets_.size()) {
+    return nullptr;
+  }
+  if (worker_sockets_[worker_index] != nullptr) {
+    return worker_sockets_[worker_index];
+  }
+  return taken_worker_sockets_[worker_index].lock();
+}
+
 ListenerFactoryContextBaseImpl::ListenerFactoryContextBaseImpl(
     Envoy::Server::Instance& server, ProtobufMessage::ValidationVisitor& validation_visitor,
     const envoy::config::listener::v3::Listener& config, DrainManagerPtr drain_manager)
@@ -255,7 +315,7 @@ ListenerImpl::ListenerImpl(const envoy::config::listener::v3::Listener& config,
       }) {
   buildAccessLog();
   auto socket_type = Network::Utility::protobufAddressSocketType(config.address());
-  buildListenSocketOptions(socket_type);
+  buildListenSocketOptions(socket_type, concurrency);
   buildUdpListenerFactory(socket_type, concurrency);
   createListenerFilterFactories(socket_type);
   validateFilterChains(socket_type);
@@ -310,7 +370,7 @@ ListenerImpl::ListenerImpl(const ListenerImpl& origin,
       }) {
   buildAccessLog();
   auto socket_type = Network::Utility::protobufAddressSocketType(config.address());
-  buildListenSocketOptions(socket_type);
+  buildListenSocketOptions(socket_type, concurrency);
   buildUdpListenerFactory(socket_type, concurrency);
   createListenerFilterFactories(socket_type);
   validateFilterChains(socket_type);
@@ -350,7 +410,8 @@ void ListenerImpl::buildUdpListenerFactory(Network::Socket::Type socket_type,
   }
 }
 
-void ListenerImpl::buildListenSocketOptions(Network::Socket::Type socket_type) {
+void ListenerImpl::buildListenSocketOptions(Network::Socket::Type socket_type,
+                                            uint32_t concurrency) {
   if (PROTOBUF_GET_WRAPPED_OR_DEFAULT(config_, transparent, false)) {
     addListenSocketOptions(Network::SocketOptionFactory::buildIpTransparentOptions());
   }
@@ -359,6 +420,20 @@ void ListenerImpl::buildListenSocketOptions(Network::Socket::Type socket_type) {
   }
   if (config_.reuse_port()) {
     addListenSocketOptions(Network::SocketOptionFactory::buildReusePortOptions());
+    if (config_.reuse_port_steering() == envoy::config::listener::v3::Listener::CPU &&
+        socket_type == Network::Socket::Type::Stream && concurrency > 1) {
+      if (!Network::ReusePortCpuSteeringSocketOptionImpl::isSupported()) {
+        throw EnvoyException(
+            fmt::format("error adding listener '{}': CPU reuse port steering is not supported on "
+                        "this platform",
+                        address_->asString()));
+      }
+      // Each worker owns the socket at its own index of the SO_REUSEPORT group, so the program
+      // steers connections received on CPU n to worker (n % concurrency).
+      addListenSocketOptions(
+          Network::SocketOptionFactory::buildReusePortCpuSteeringOptions(concurrency));
+      steered_socket_count_ = concurrency;
+    }
   }
   if (!config_.socket_options().empty()) {
     addListenSocketOptions(
@@ -432,9 +507,18 @@ void ListenerImpl::buildFilterChains() {
 void ListenerImpl::buildSocketOptions() {
   // TCP specific setup.
   if (config_.has_connection_balance_config()) {
-    // Currently exact balance is the only supported type and there are no options.
-    ASSERT(config_.connection_balance_config().has_exact_balance());
-    connection_balancer_ = std::make_unique<Network::ExactConnectionBalancerImpl>();
+    switch (config_.connection_balance_config().balance_type_case()) {
+    case envoy::config::listener::v3::Listener::ConnectionBalanceConfig::kExactBalance:
+      connection_balancer_ = std::make_unique<Network::ExactConnectionBalancerImpl>();
+      break;
+    case envoy::config::listener::v3::Listener::ConnectionBalanceConfig::kTwoChoiceBalance:
+      // Each worker registers one handler.
+      connection_balancer_ = std::make_unique<Network::TwoChoiceConnectionBalancerImpl>(
+          parent_.server_.random(), parent_.server_.options().concurrency());
+      break;
+    default:
+      NOT_REACHED_GCOVR_EXCL_LINE;
+    }
   } else {
     connection_balancer_ = std::make_unique<Network::NopConnectionBalancerImpl>();
   }
@@ -676,10 +760,19 @@ ListenerImpl::newListenerWithFilterChain(const envoy::config::listener::v3::List
 
 void ListenerImpl::diffFilterChain(const ListenerImpl& another_listener,
                                    std::function<void(Network::DrainableFilterChain&)> callback) {
+  // The listener passed in shares the filter chains whose config did not change with `this`
+  // listener, so they are told apart by identity. Comparing the filter chain messages instead
+  // would hash and compare every message again, which dominates the update of listeners with
+  // thousands of filter chains.
+  const auto& another_filter_chains =
+      another_listener.filter_chain_manager_.filterChainsByMessage();
+  absl::flat_hash_set<const Network::DrainableFilterChain*> shared_filter_chains;
+  shared_filter_chains.reserve(another_filter_chains.size());
+  for (const auto& message_and_filter_chain : another_filter_chains) {
+    shared_filter_chains.insert(message_and_filter_chain.second.get());
+  }
   for (const auto& message_and_filter_chain : filter_chain_manager_.filterChainsByMessage()) {
-    if (another_listener.filter_chain_manager_.filterChainsByMessage().find(
-            message_and_filter_chain.first) ==
-        another_listener.filter_chain_manager_.filterChainsByMessage().end()) {
+    if (!shared_filter_chains.contains(message_and_filter_chain.second.get())) {
       // The filter chain exists in `this` listener but not in the listener passed in.
       callback(*message_and_filter_chain.second);
     }
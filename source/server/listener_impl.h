@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "envoy/access_log/access_log.h"
 #include "envoy/config/core/v3/base.pb.h"
@@ -14,6 +15,7 @@
 #include "envoy/stats/scope.h"
 
 #include "common/common/logger.h"
+#include "common/common/thread.h"
 #include "common/init/manager_impl.h"
 #include "common/init/target_impl.h"
 
@@ -42,7 +44,8 @@ public:
                           Network::Address::InstanceConstSharedPtr address,
                           Network::Socket::Type socket_type,
                           const Network::Socket::OptionsSharedPtr& options, bool bind_to_port,
-                          const std::string& listener_name, bool reuse_port);
+                          const std::string& listener_name, bool reuse_port,
+                          uint32_t worker_socket_count);
 
   // Network::ListenSocketFactory
   Network::Socket::Type socketType() const override { return socket_type_; }
@@ -50,7 +53,7 @@ public:
     return local_address_;
   }
 
-  Network::SocketSharedPtr getListenSocket() override;
+  Network::SocketSharedPtr getListenSocket(absl::optional<uint32_t> worker_index) override;
 
   /**
    * @return the socket shared by worker threads; otherwise return null.
@@ -65,8 +68,11 @@ public:
     return absl::nullopt;
   }
 
+  Network::SocketSharedPtr workerSocket(uint32_t worker_index) const override;
+
 protected:
-  Network::SocketSharedPtr createListenSocketAndApplyOptions();
+  Network::SocketSharedPtr
+  createListenSocketAndApplyOptions(absl::optional<uint32_t> worker_index = absl::nullopt);
 
 private:
   ListenerComponentFactory& factory_;
@@ -80,6 +86,15 @@ private:
   const bool reuse_port_;
   Network::SocketSharedPtr socket_;
   absl::once_flag steal_once_;
+  // When connections are steered to the sockets of the SO_REUSEPORT group by index, the sockets
+  // of all workers are created up front so that the index of each socket in the group is the
+  // index of its worker. A socket is only kept here until its worker takes it, so that it leaves
+  // the group as soon as the worker stops listening on it. Workers take their sockets while the
+  // main thread may look them up for a hot restarted process.
+  mutable Thread::MutexBasicLockable worker_sockets_lock_;
+  std::vector<Network::SocketSharedPtr> worker_sockets_ ABSL_GUARDED_BY(worker_sockets_lock_);
+  std::vector<std::weak_ptr<Network::Socket>>
+      taken_worker_sockets_ ABSL_GUARDED_BY(worker_sockets_lock_);
 };
 
 // TODO(mattklein123): Consider getting rid of pre-worker start and post-worker start code by
@@ -276,6 +291,9 @@ public:
   void setSocketFactory(const Network::ListenSocketFactorySharedPtr& socket_factory);
   void setSocketAndOptions(const Network::SocketSharedPtr& socket);
   const Network::Socket::OptionsSharedPtr& listenSocketOptions() { return listen_socket_options_; }
+  // The number of per worker sockets that must be created in worker order, or 0 if the sockets
+  // of the SO_REUSEPORT group are not steered by index.
+  uint32_t steeredSocketCount() const { return steered_socket_count_; }
   const std::string& versionInfo() const { return version_info_; }
 
   // Network::ListenerConfig
@@ -338,7 +356,7 @@ private:
   // Helpers for constructor.
   void buildAccessLog();
   void buildUdpListenerFactory(Network::Socket::Type socket_type, uint32_t concurrency);
-  void buildListenSocketOptions(Network::Socket::Type socket_type);
+  void buildListenSocketOptions(Network::Socket::Type socket_type, uint32_t concurrency);
   void createListenerFilterFactories(Network::Socket::Type socket_type);
   void validateFilterChains(Network::Socket::Type socket_type);
   void buildFilterChains();
@@ -380,6 +398,7 @@ private:
   const envoy::config::listener::v3::Listener config_;
   const std::string version_info_;
   Network::Socket::OptionsSharedPtr listen_socket_options_;
+  uint32_t steered_socket_count_{};
   const std::chrono::milliseconds listener_filters_timeout_;
   const bool continue_on_listener_filters_timeout_;
   Network::ActiveUdpListenerFactoryPtr udp_listener_factory_;
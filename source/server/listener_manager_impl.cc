@@ -79,7 +79,8 @@ void fillState(envoy::admin::v3::ListenersConfigDump::DynamicListenerState& stat
 
 bool ListenSocketCreationParams::operator==(const ListenSocketCreationParams& rhs) const {
   return (bind_to_port == rhs.bind_to_port) &&
-         (duplicate_parent_socket == rhs.duplicate_parent_socket);
+         (duplicate_parent_socket == rhs.duplicate_parent_socket) &&
+         (worker_index == rhs.worker_index);
 }
 
 bool ListenSocketCreationParams::operator!=(const ListenSocketCreationParams& rhs) const {
@@ -206,7 +207,7 @@ Network::SocketSharedPtr ProdListenerComponentFactory::createListenSocket(
           fmt::format("socket type {} not supported for pipes", toString(socket_type)));
     }
     const std::string addr = fmt::format("unix://{}", address->asString());
-    const int fd = server_.hotRestart().duplicateParentListenSocket(addr);
+    const int fd = server_.hotRestart().duplicateParentListenSocket(addr, absl::nullopt);
     Network::IoHandlePtr io_handle = std::make_unique<Network::IoSocketHandleImpl>(fd);
     if (io_handle->isOpen()) {
       ENVOY_LOG(debug, "obtained socket for address {} from parent", addr);
@@ -220,8 +221,8 @@ Network::SocketSharedPtr ProdListenerComponentFactory::createListenSocket(
                                  : std::string(Network::Utility::UDP_SCHEME);
   const std::string addr = absl::StrCat(scheme, address->asString());
 
-  if (params.bind_to_port && params.duplicate_parent_socket) {
-    const int fd = server_.hotRestart().duplicateParentListenSocket(addr);
+  if (params.bind_to_port && (params.duplicate_parent_socket || params.worker_index.has_value())) {
+    const int fd = server_.hotRestart().duplicateParentListenSocket(addr, params.worker_index);
     if (fd != -1) {
       ENVOY_LOG(debug, "obtained socket for address {} from parent", addr);
       Network::IoHandlePtr io_handle = std::make_unique<Network::IoSocketHandleImpl>(fd);
@@ -261,7 +262,7 @@ ListenerManagerImpl::ListenerManagerImpl(Instance& server,
       enable_dispatcher_stats_(enable_dispatcher_stats) {
   for (uint32_t i = 0; i < server.options().concurrency(); i++) {
     workers_.emplace_back(
-        worker_factory.createWorker(server.overloadManager(), absl::StrCat("worker_", i)));
+        worker_factory.createWorker(i, server.overloadManager(), absl::StrCat("worker_", i)));
   }
 }
 
@@ -794,6 +795,15 @@ uint64_t ListenerManagerImpl::numConnections() const {
   return num_connections;
 }
 
+std::vector<std::vector<Buffer::BufferMemoryAccountBalance>>
+ListenerManagerImpl::largestBufferMemoryAccounts() const {
+  std::vector<std::vector<Buffer::BufferMemoryAccountBalance>> accounts;
+  for (const auto& worker : workers_) {
+    accounts.push_back(worker->largestBufferMemoryAccounts());
+  }
+  return accounts;
+}
+
 bool ListenerManagerImpl::removeListener(const std::string& name) {
   ENVOY_LOG(debug, "begin remove listener: name={}", name);
 
@@ -986,7 +996,7 @@ Network::ListenSocketFactorySharedPtr ListenerManagerImpl::createListenSocketFac
   Network::Socket::Type socket_type = Network::Utility::protobufAddressSocketType(proto_address);
   return std::make_shared<ListenSocketFactoryImpl>(
       factory_, listener.address(), socket_type, listener.listenSocketOptions(),
-      listener.bindToPort(), listener.name(), reuse_port);
+      listener.bindToPort(), listener.name(), reuse_port, listener.steeredSocketCount());
 }
 
 ApiListenerOptRef ListenerManagerImpl::apiListener() {
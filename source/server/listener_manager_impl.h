@@ -188,6 +188,8 @@ public:
   }
   std::vector<std::reference_wrapper<Network::ListenerConfig>> listeners() override;
   uint64_t numConnections() const override;
+  std::vector<std::vector<Buffer::BufferMemoryAccountBalance>>
+  largestBufferMemoryAccounts() const override;
   bool removeListener(const std::string& listener_name) override;
   void startWorkers(GuardDog& guard_dog) override;
   void stopListeners(StopListenersType stop_listeners_type) override;
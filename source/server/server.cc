@@ -24,16 +24,20 @@
 
 #include "common/api/api_impl.h"
 #include "common/api/os_sys_calls_impl.h"
+#include "common/buffer/buffer_impl.h"
 #include "common/common/enum_to_int.h"
 #include "common/common/mutex_tracer_impl.h"
+#include "common/common/regex.h"
 #include "common/common/utility.h"
 #include "common/common/version.h"
 #include "common/config/utility.h"
 #include "common/config/version_converter.h"
 #include "common/http/codes.h"
+#include "common/http/headers.h"
 #include "common/local_info/local_info_impl.h"
 #include "common/memory/stats.h"
 #include "common/network/address_impl.h"
+#include "common/network/zero_copy_sender.h"
 #include "common/protobuf/utility.h"
 #include "common/router/rds_impl.h"
 #include "common/runtime/runtime_impl.h"
@@ -63,14 +67,15 @@ InstanceImpl::InstanceImpl(
       options_(options), validation_context_(options_.allowUnknownStaticFields(),
                                              !options.rejectUnknownDynamicFields(),
                                              options.ignoreUnknownDynamicFields()),
-      time_source_(time_system), restarter_(restarter), start_time_(time(nullptr)),
+      time_source_(time_system), startup_phases_(time_system), restarter_(restarter),
+      start_time_(time(nullptr)),
       original_start_time_(start_time_), stats_store_(store), thread_local_(tls),
       api_(new Api::Impl(thread_factory, store, time_system, file_system,
                          process_context ? ProcessContextOptRef(std::ref(*process_context))
                                          : absl::nullopt)),
       dispatcher_(api_->allocateDispatcher("main_thread")),
       singleton_manager_(new Singleton::ManagerImpl(api_->threadFactory())),
-      handler_(new ConnectionHandlerImpl(*dispatcher_)),
+      handler_(new ConnectionHandlerImpl(*dispatcher_, absl::nullopt)),
       random_generator_(std::move(random_generator)), listener_component_factory_(*this),
       worker_factory_(thread_local_, *api_, hooks),
       access_log_manager_(options.fileFlushIntervalMsec(), *api_, *dispatcher_, access_log_lock,
@@ -218,6 +223,14 @@ void InstanceImpl::updateServerStats() {
       enumToInt(Utility::serverState(initManager().state(), healthCheckFailed())));
   server_stats_->stats_recent_lookups_.set(
       stats_store_.symbolTable().getRecentLookups([](absl::string_view, uint64_t) {}));
+  server_stats_->buffer_slices_allocated_.set(Buffer::OwnedSlice::freshAllocations());
+  server_stats_->buffer_slices_recycled_.set(Buffer::OwnedSlice::recycledAllocations());
+  server_stats_->compiled_regexes_.set(Regex::CompiledRegexCache::get().size());
+  server_stats_->compiled_regexes_max_program_size_.set(
+      Regex::CompiledRegexCache::get().maxProgramSize());
+  server_stats_->zero_copy_send_bytes_.set(Network::ZeroCopySender::totalBytes());
+  server_stats_->zero_copy_send_copied_bytes_.set(Network::ZeroCopySender::totalCopiedBytes());
+  server_stats_->zero_copy_send_fallbacks_.set(Network::ZeroCopySender::totalFallbacks());
 }
 
 void InstanceImpl::flushStatsInternal() {
@@ -298,10 +311,14 @@ void InstanceImpl::initialize(const Options& options,
     ENVOY_LOG(info, "  {}: {}", ext.first, absl::StrJoin(ext.second->registeredNames(), ", "));
   }
 
+  startup_phases_.begin("initialize");
+
   // Handle configuration that needs to take place prior to the main configuration load.
+  startup_phases_.begin("load_bootstrap");
   InstanceUtil::loadBootstrapConfig(bootstrap_, options,
                                     messageValidationContext().staticValidationVisitor(), *api_);
   bootstrap_config_update_time_ = time_source_.systemTime();
+  startup_phases_.complete("load_bootstrap");
 
   // Immediate after the bootstrap has been loaded, override the header prefix, if configured to
   // do so. This must be set before any other code block references the HeaderValues ConstSingleton.
@@ -386,6 +403,15 @@ void InstanceImpl::initialize(const Options& options,
   }
   config_tracker_entry_ =
       admin_->getConfigTracker().add("bootstrap", [this] { return dumpBootstrapConfig(); });
+  admin_->addHandler(
+      "/startup_phases", "print the durations of the phases of the server startup",
+      [this](absl::string_view, Http::ResponseHeaderMap& response_headers,
+             Buffer::Instance& response, AdminStream&) -> Http::Code {
+        response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
+        response.add(startup_phases_.toJson());
+        return Http::Code::OK;
+      },
+      false, false);
   if (initial_config.admin().address()) {
     admin_->addListenerToHandler(handler_.get());
   }
@@ -435,9 +461,11 @@ void InstanceImpl::initialize(const Options& options,
 
   // Runtime gets initialized before the main configuration since during main configuration
   // load things may grab a reference to the loader for later use.
+  startup_phases_.begin("runtime");
   runtime_singleton_ = std::make_unique<Runtime::ScopedLoaderSingleton>(
       component_factory.createRuntime(*this, initial_config));
   hooks.onRuntimeCreated();
+  startup_phases_.complete("runtime");
 
   // Once we have runtime we can initialize the SSL context manager.
   ssl_context_manager_ = createContextManager("ssl_context_manager", time_source_);
@@ -455,7 +483,8 @@ void InstanceImpl::initialize(const Options& options,
   // thread local data per above. See MainImpl::initialize() for why ConfigImpl
   // is constructed as part of the InstanceImpl and then populated once
   // cluster_manager_factory_ is available.
-  config_.initialize(bootstrap_, *this, *cluster_manager_factory_);
+  startup_phases_.begin("primary_clusters");
+  config_.initialize(bootstrap_, *this, *cluster_manager_factory_, &startup_phases_);
 
   // Instruct the listener manager to create the LDS provider if needed. This must be done later
   // because various items do not yet exist when the listener manager is created.
@@ -492,14 +521,22 @@ void InstanceImpl::initialize(const Options& options,
     bootstrap_extensions_.push_back(
         factory.createBootstrapExtension(*config, serverFactoryContext()));
   }
+
+  startup_phases_.complete("initialize");
 }
 
 void InstanceImpl::onClusterManagerPrimaryInitializationComplete() {
+  startup_phases_.complete("primary_clusters");
+  startup_phases_.begin("rtds");
   // If RTDS was not configured the `onRuntimeReady` callback is immediately invoked.
   Runtime::LoaderSingleton::get().startRtdsSubscriptions([this]() { onRuntimeReady(); });
 }
 
 void InstanceImpl::onRuntimeReady() {
+  startup_phases_.complete("rtds");
+  // The secondary clusters and the init targets, e.g. RDS and dynamic listeners, are ready when
+  // the workers start.
+  startup_phases_.begin("secondary_clusters_and_init_targets");
   // Begin initializing secondary clusters after RTDS configuration has been applied.
   clusterManager().initializeSecondaryClusters(bootstrap_);
 
@@ -520,7 +557,10 @@ void InstanceImpl::onRuntimeReady() {
 }
 
 void InstanceImpl::startWorkers() {
+  startup_phases_.complete("secondary_clusters_and_init_targets");
+  startup_phases_.begin("start_workers");
   listener_manager_->startWorkers(*guard_dog_);
+  startup_phases_.complete("start_workers");
   initialization_timer_->complete();
   // Update server stats as soon as initialization is done.
   updateServerStats();
@@ -41,6 +41,7 @@
 #include "server/listener_hooks.h"
 #include "server/listener_manager_impl.h"
 #include "server/overload_manager_impl.h"
+#include "server/startup_phases.h"
 #include "server/worker_impl.h"
 
 #include "absl/container/node_hash_map.h"
@@ -56,6 +57,10 @@ namespace Server {
   COUNTER(debug_assertion_failures)                                                                \
   COUNTER(dynamic_unknown_fields)                                                                  \
   COUNTER(static_unknown_fields)                                                                   \
+  GAUGE(buffer_slices_allocated, NeverImport)                                                      \
+  GAUGE(buffer_slices_recycled, NeverImport)                                                       \
+  GAUGE(compiled_regexes, NeverImport)                                                             \
+  GAUGE(compiled_regexes_max_program_size, NeverImport)                                            \
   GAUGE(concurrency, NeverImport)                                                                  \
   GAUGE(days_until_first_cert_expiring, Accumulate)                                                \
   GAUGE(hot_restart_epoch, NeverImport)                                                            \
@@ -70,6 +75,9 @@ namespace Server {
   GAUGE(total_connections, Accumulate)                                                             \
   GAUGE(uptime, Accumulate)                                                                        \
   GAUGE(version, NeverImport)                                                                      \
+  GAUGE(zero_copy_send_bytes, NeverImport)                                                         \
+  GAUGE(zero_copy_send_copied_bytes, NeverImport)                                                  \
+  GAUGE(zero_copy_send_fallbacks, NeverImport)                                                     \
   HISTOGRAM(initialization_time_ms, Milliseconds)
 
 struct ServerStats {
@@ -309,6 +317,7 @@ private:
   const Options& options_;
   ProtobufMessage::ProdValidationContextImpl validation_context_;
   TimeSource& time_source_;
+  StartupPhases startup_phases_;
   // Delete local_info_ as late as possible as some members below may reference it during their
   // destruction.
   LocalInfo::LocalInfoPtr local_info_;
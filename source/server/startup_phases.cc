@@ -0,0 +1,58 @@
+#include "server/startup_phases.h"
+
+#include <algorithm>
+
+#include "common/protobuf/protobuf.h"
+#include "common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Server {
+
+StartupPhases::StartupPhases(TimeSource& time_source)
+    : time_source_(time_source), start_(time_source.monotonicTime()) {}
+
+std::chrono::milliseconds StartupPhases::sinceStart() const {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(time_source_.monotonicTime() -
+                                                               start_);
+}
+
+void StartupPhases::begin(absl::string_view name) {
+  if (std::any_of(phases_.begin(), phases_.end(),
+                  [name](const Phase& phase) { return phase.name_ == name; })) {
+    return;
+  }
+  phases_.push_back({std::string(name), sinceStart(), absl::nullopt});
+}
+
+void StartupPhases::complete(absl::string_view name) {
+  auto phase = std::find_if(phases_.begin(), phases_.end(),
+                            [name](const Phase& phase) { return phase.name_ == name; });
+  if (phase == phases_.end() || phase->duration_.has_value()) {
+    return;
+  }
+  phase->duration_ = sinceStart() - phase->start_;
+  ENVOY_LOG(info, "startup phase {} took {}ms", phase->name_, phase->duration_.value().count());
+}
+
+std::string StartupPhases::toJson() const {
+  std::vector<ProtobufWkt::Value> phases;
+  phases.reserve(phases_.size());
+  for (const Phase& phase : phases_) {
+    ProtobufWkt::Struct phase_struct;
+    auto* fields = phase_struct.mutable_fields();
+    (*fields)["name"] = ValueUtil::stringValue(phase.name_);
+    (*fields)["start_ms"] = ValueUtil::numberValue(phase.start_.count());
+    // Phases still in progress have no duration.
+    if (phase.duration_.has_value()) {
+      (*fields)["duration_ms"] = ValueUtil::numberValue(phase.duration_.value().count());
+    }
+    phases.push_back(ValueUtil::structValue(phase_struct));
+  }
+
+  ProtobufWkt::Struct startup;
+  (*startup.mutable_fields())["phases"] = ValueUtil::listValue(phases);
+  return MessageUtil::getJsonStringFromMessage(startup, true, true);
+}
+
+} // namespace Server
+} // namespace Envoy
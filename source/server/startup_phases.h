@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+
+#include "common/common/logger.h"
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Server {
+
+/**
+ * Records when the phases of the server startup begin and how long they take, as shown by the
+ * /startup_phases admin endpoint. Phases may overlap, e.g. the initialization of the primary
+ * clusters continues while the rest of the configuration is loaded. Main thread only.
+ */
+class StartupPhases : Logger::Loggable<Logger::Id::main> {
+public:
+  struct Phase {
+    std::string name_;
+    // Since the startup began.
+    std::chrono::milliseconds start_;
+    absl::optional<std::chrono::milliseconds> duration_;
+  };
+
+  explicit StartupPhases(TimeSource& time_source);
+
+  /**
+   * Begin a phase. Phases which have already begun are not restarted.
+   * @param name supplies the name of the phase.
+   */
+  void begin(absl::string_view name);
+
+  /**
+   * Complete a phase. Phases which did not begin or are already complete are ignored.
+   * @param name supplies the name of the phase.
+   */
+  void complete(absl::string_view name);
+
+  /**
+   * @return const std::vector<Phase>& the phases in the order they began.
+   */
+  const std::vector<Phase>& phases() const { return phases_; }
+
+  /**
+   * @return std::string the phases as a JSON document.
+   */
+  std::string toJson() const;
+
+private:
+  std::chrono::milliseconds sinceStart() const;
+
+  TimeSource& time_source_;
+  const MonotonicTime start_;
+  std::vector<Phase> phases_;
+};
+
+} // namespace Server
+} // namespace Envoy
@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "envoy/event/dispatcher.h"
 #include "envoy/event/timer.h"
@@ -10,15 +11,18 @@
 
 #include "server/connection_handler_impl.h"
 
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+
 namespace Envoy {
 namespace Server {
 
-WorkerPtr ProdWorkerFactory::createWorker(OverloadManager& overload_manager,
+WorkerPtr ProdWorkerFactory::createWorker(uint32_t index, OverloadManager& overload_manager,
                                           const std::string& worker_name) {
   Event::DispatcherPtr dispatcher(api_.allocateDispatcher(worker_name));
   return WorkerPtr{
       new WorkerImpl(tls_, hooks_, std::move(dispatcher),
-                     Network::ConnectionHandlerPtr{new ConnectionHandlerImpl(*dispatcher)},
+                     Network::ConnectionHandlerPtr{new ConnectionHandlerImpl(*dispatcher, index)},
                      overload_manager, api_)};
 }
 
@@ -31,6 +35,9 @@ WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
   overload_manager.registerForAction(
       OverloadActionNames::get().StopAcceptingConnections, *dispatcher_,
       [this](OverloadActionState state) { stopAcceptingConnectionsCb(state); });
+  overload_manager.registerForAction(
+      OverloadActionNames::get().ResetHighMemoryConnections, *dispatcher_,
+      [this](OverloadActionState state) { resetHighMemoryConnectionsCb(state); });
 }
 
 void WorkerImpl::addListener(absl::optional<uint64_t> overridden_listener,
@@ -97,7 +104,20 @@ void WorkerImpl::start(GuardDog& guard_dog) {
       [this, &guard_dog]() -> void { threadRoutine(guard_dog); }, options);
 }
 
-void WorkerImpl::initializeStats(Stats::Scope& scope) { dispatcher_->initializeStats(scope); }
+void WorkerImpl::initializeStats(Stats::Scope& scope) {
+  dispatcher_->initializeStats(scope);
+  // The gauges are resolved on this thread, so that nothing posted to the worker references the
+  // scope. The buffer memory tracker of the dispatcher may only be used on the worker thread, so
+  // only the stats refresh is posted.
+  buffer_memory_stats_ = std::make_unique<WorkerBufferMemoryStats>(
+      WorkerBufferMemoryStats{ALL_WORKER_BUFFER_MEMORY_STATS(
+          POOL_GAUGE_PREFIX(scope, absl::StrCat(dispatcher_->name(), ".buffer_memory.")))});
+  dispatcher_->post([this]() -> void {
+    buffer_memory_stats_timer_ =
+        dispatcher_->createTimer([this]() -> void { updateBufferMemoryStats(); });
+    updateBufferMemoryStats();
+  });
+}
 
 void WorkerImpl::stop() {
   // It's possible for the server to cleanly shut down while cluster initialization during startup
@@ -136,6 +156,8 @@ void WorkerImpl::threadRoutine(GuardDog& guard_dog) {
   // destructors from running on the main thread which might reference thread locals. Destroying
   // the handler does this which additionally purges the dispatcher delayed deletion list.
   handler_.reset();
+  reset_high_memory_connections_timer_.reset();
+  buffer_memory_stats_timer_.reset();
   tls_.shutdownThread();
   watch_dog_.reset();
 }
@@ -151,5 +173,52 @@ void WorkerImpl::stopAcceptingConnectionsCb(OverloadActionState state) {
   }
 }
 
+void WorkerImpl::resetHighMemoryConnectionsCb(OverloadActionState state) {
+  switch (state) {
+  case OverloadActionState::Active:
+    if (reset_high_memory_connections_timer_ == nullptr) {
+      reset_high_memory_connections_timer_ =
+          dispatcher_->createTimer([this]() -> void { resetHighMemoryConnections(); });
+    }
+    resetHighMemoryConnections();
+    break;
+  case OverloadActionState::Inactive:
+    if (reset_high_memory_connections_timer_ != nullptr) {
+      reset_high_memory_connections_timer_->disableTimer();
+    }
+    break;
+  }
+}
+
+void WorkerImpl::resetHighMemoryConnections() {
+  Buffer::BufferMemoryTracker& tracker = dispatcher_->bufferMemoryTracker();
+  const uint64_t buffered = tracker.balance();
+  ENVOY_LOG(debug, "largest buffer memory accounts: {} bytes",
+            absl::StrJoin(tracker.largestBalances(HighMemoryConnectionsResetBatch), ", "));
+  const uint32_t reset = tracker.resetLargestAccounts(HighMemoryConnectionsResetBatch);
+  ENVOY_LOG(debug, "reset {} high memory connections, {} bytes were buffered", reset, buffered);
+  // Keep closing connections until the overload action becomes inactive again.
+  reset_high_memory_connections_timer_->enableTimer(HighMemoryConnectionsResetInterval);
+}
+
+void WorkerImpl::updateBufferMemoryStats() {
+  Buffer::BufferMemoryTracker& tracker = dispatcher_->bufferMemoryTracker();
+  buffer_memory_stats_->buffered_bytes_.set(tracker.balance());
+  const std::vector<uint64_t> largest = tracker.largestBalances(1);
+  buffer_memory_stats_->largest_account_buffered_bytes_.set(largest.empty() ? 0 : largest[0]);
+  std::vector<Buffer::BufferMemoryAccountBalance> largest_accounts =
+      tracker.largestAccounts(LargestBufferMemoryAccounts);
+  {
+    Thread::LockGuard lock(largest_buffer_memory_accounts_lock_);
+    largest_buffer_memory_accounts_.swap(largest_accounts);
+  }
+  buffer_memory_stats_timer_->enableTimer(BufferMemoryStatsInterval);
+}
+
+std::vector<Buffer::BufferMemoryAccountBalance> WorkerImpl::largestBufferMemoryAccounts() const {
+  Thread::LockGuard lock(largest_buffer_memory_accounts_lock_);
+  return largest_buffer_memory_accounts_;
+}
+
 } // namespace Server
 } // namespace Envoy
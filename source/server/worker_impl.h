@@ -1,29 +1,49 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "envoy/api/api.h"
+#include "envoy/event/timer.h"
 #include "envoy/network/connection_handler.h"
 #include "envoy/server/guarddog.h"
 #include "envoy/server/listener_manager.h"
 #include "envoy/server/worker.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
 #include "envoy/thread_local/thread_local.h"
 
 #include "common/common/logger.h"
+#include "common/common/thread.h"
 
 #include "server/listener_hooks.h"
 
 namespace Envoy {
 namespace Server {
 
+/**
+ * Memory held by the buffers of a worker, see the buffer memory tracker of its dispatcher.
+ */
+#define ALL_WORKER_BUFFER_MEMORY_STATS(GAUGE)                                                      \
+  GAUGE(buffered_bytes, NeverImport)                                                               \
+  GAUGE(largest_account_buffered_bytes, NeverImport)
+
+/**
+ * Struct definition for the buffer memory stats of a worker. @see stats_macros.h
+ */
+struct WorkerBufferMemoryStats {
+  ALL_WORKER_BUFFER_MEMORY_STATS(GENERATE_GAUGE_STRUCT)
+};
+
 class ProdWorkerFactory : public WorkerFactory, Logger::Loggable<Logger::Id::main> {
 public:
   ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api, ListenerHooks& hooks)
       : tls_(tls), api_(api), hooks_(hooks) {}
 
   // Server::WorkerFactory
-  WorkerPtr createWorker(OverloadManager& overload_manager,
+  WorkerPtr createWorker(uint32_t index, OverloadManager& overload_manager,
                          const std::string& worker_name) override;
 
 private:
@@ -45,6 +65,7 @@ public:
   void addListener(absl::optional<uint64_t> overridden_listener, Network::ListenerConfig& listener,
                    AddListenerCompletion completion) override;
   uint64_t numConnections() const override;
+  std::vector<Buffer::BufferMemoryAccountBalance> largestBufferMemoryAccounts() const override;
 
   void removeListener(Network::ListenerConfig& listener, std::function<void()> completion) override;
   void removeFilterChains(uint64_t listener_tag,
@@ -58,6 +79,19 @@ public:
 private:
   void threadRoutine(GuardDog& guard_dog);
   void stopAcceptingConnectionsCb(OverloadActionState state);
+  void resetHighMemoryConnectionsCb(OverloadActionState state);
+  void resetHighMemoryConnections();
+  void updateBufferMemoryStats();
+
+  // The number of connections closed at a time while the reset high memory connections overload
+  // action is active, and the interval between two batches.
+  static constexpr uint32_t HighMemoryConnectionsResetBatch = 10;
+  static constexpr std::chrono::milliseconds HighMemoryConnectionsResetInterval{100};
+  // Finding the largest account walks all the accounts of the worker, so the buffer memory stats
+  // are refreshed periodically rather than on every change.
+  static constexpr std::chrono::milliseconds BufferMemoryStatsInterval{1000};
+  // The number of accounts, and of child accounts of each, reported to the admin.
+  static constexpr uint32_t LargestBufferMemoryAccounts = 10;
 
   ThreadLocal::Instance& tls_;
   ListenerHooks& hooks_;
@@ -66,6 +100,13 @@ private:
   Api::Api& api_;
   Thread::ThreadPtr thread_;
   WatchDogSharedPtr watch_dog_;
+  Event::TimerPtr reset_high_memory_connections_timer_;
+  std::unique_ptr<WorkerBufferMemoryStats> buffer_memory_stats_;
+  Event::TimerPtr buffer_memory_stats_timer_;
+  // Refreshed on the worker thread along with the buffer memory stats, read by the admin.
+  mutable Thread::MutexBasicLockable largest_buffer_memory_accounts_lock_;
+  std::vector<Buffer::BufferMemoryAccountBalance>
+      largest_buffer_memory_accounts_ ABSL_GUARDED_BY(largest_buffer_memory_accounts_lock_);
 };
 
 } // namespace Server
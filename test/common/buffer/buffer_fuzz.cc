@@ -172,6 +172,8 @@ public:
     return result;
   }
 
+  void bindAccount(Buffer::BufferMemoryAccountSharedPtr) override {}
+
   absl::string_view asStringView() const { return {start(), size_}; }
 
   char* mutableStart() { return data_.data() + start_; }
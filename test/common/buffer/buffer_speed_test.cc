@@ -1,4 +1,5 @@
 #include "common/buffer/buffer_impl.h"
+#include "common/buffer/memory_account_impl.h"
 #include "common/common/assert.h"
 
 #include "absl/strings/string_view.h"
@@ -202,6 +203,38 @@ static void bufferMovePartial(benchmark::State& state) {
 }
 BENCHMARK(bufferMovePartial)->Arg(1)->Arg(4096)->Arg(16384)->Arg(65536);
 
+// Test splitting a buffer into HTTP/2 DATA frame sized moves, where frame boundaries rarely
+// line up with slice boundaries, either copying or sharing the split slices.
+static void bufferMoveFrames(benchmark::State& state) {
+  constexpr uint64_t FrameSize = 16384;
+  const std::string data(state.range(0), 'a');
+  const bool share_slices = state.range(1) != 0;
+  Buffer::OwnedImpl frame;
+  for (auto _ : state) {
+    Buffer::OwnedImpl buffer;
+    for (uint64_t added = 0; added < MaxBufferLength; added += data.size()) {
+      buffer.add(data);
+    }
+    while (buffer.length() != 0) {
+      const uint64_t length = std::min(FrameSize, buffer.length());
+      if (share_slices) {
+        frame.moveSharingSlices(buffer, length);
+      } else {
+        frame.move(buffer, length);
+      }
+      frame.drain(frame.length());
+    }
+  }
+  benchmark::DoNotOptimize(frame.length());
+}
+BENCHMARK(bufferMoveFrames)
+    ->Args({4096, 0})
+    ->Args({4096, 1})
+    ->Args({20440, 0})
+    ->Args({20440, 1})
+    ->Args({65536, 0})
+    ->Args({65536, 1});
+
 // Test the reserve+commit cycle, for the special case where the reserved space is
 // fully used (and therefore the commit size equals the reservation size).
 static void bufferReserveCommit(benchmark::State& state) {
@@ -244,6 +277,27 @@ static void bufferReserveCommitPartial(benchmark::State& state) {
 }
 BENCHMARK(bufferReserveCommitPartial)->Arg(1)->Arg(4096)->Arg(16384)->Arg(65536);
 
+// Test the slice lifecycle of proxying data: read into one buffer, move it to another and
+// drain it once written, so that every iteration releases the slices it allocated.
+static void bufferReadMoveDrain(benchmark::State& state) {
+  Buffer::OwnedImpl read_buffer;
+  Buffer::OwnedImpl write_buffer;
+  const uint64_t recycled = Buffer::OwnedSlice::recycledAllocations();
+  const uint64_t fresh = Buffer::OwnedSlice::freshAllocations();
+  for (auto _ : state) {
+    constexpr uint64_t NumSlices = 2;
+    Buffer::RawSlice slices[NumSlices];
+    uint64_t slices_used = read_buffer.reserve(state.range(0), slices, NumSlices);
+    read_buffer.commit(slices, slices_used);
+    write_buffer.move(read_buffer);
+    write_buffer.drain(write_buffer.length());
+  }
+  benchmark::DoNotOptimize(write_buffer.length());
+  state.counters["recycled_slices"] = Buffer::OwnedSlice::recycledAllocations() - recycled;
+  state.counters["fresh_slices"] = Buffer::OwnedSlice::freshAllocations() - fresh;
+}
+BENCHMARK(bufferReadMoveDrain)->Arg(4096)->Arg(16384)->Arg(65536);
+
 // Test the linearization of a buffer in the best case where the data is in one slice.
 static void bufferLinearizeSimple(benchmark::State& state) {
   const std::string data(state.range(0), 'a');
@@ -368,4 +422,32 @@ BENCHMARK(bufferStartsWithMatch)
     ->Args({16384, 256})
     ->Args({65536, 4096});
 
+// Add and drain varying amounts of content with the buffer unbound (0), bound to an account (1) or
+// bound to the child account of an account (2), as the filter buffers of an HTTP stream are.
+static void bufferAddDrainAccounted(benchmark::State& state) {
+  const std::string data(state.range(1), 'a');
+  const absl::string_view input(data);
+  Buffer::BufferMemoryTrackerImpl tracker;
+  Buffer::OwnedImpl buffer;
+  if (state.range(0) > 0) {
+    Buffer::BufferMemoryAccountSharedPtr account = tracker.createAccount("connection", []() {});
+    if (state.range(0) > 1) {
+      account = account->createChildAccount("stream");
+    }
+    buffer.bindAccount(account);
+  }
+  for (auto _ : state) {
+    buffer.add(input);
+    buffer.drain(input.size());
+  }
+  benchmark::DoNotOptimize(tracker.balance());
+}
+BENCHMARK(bufferAddDrainAccounted)
+    ->Args({0, 1})
+    ->Args({1, 1})
+    ->Args({2, 1})
+    ->Args({0, 4096})
+    ->Args({1, 4096})
+    ->Args({2, 4096});
+
 } // namespace Envoy
@@ -1,4 +1,5 @@
 #include <limits>
+#include <vector>
 
 #include "envoy/common/exception.h"
 
@@ -6,6 +7,7 @@
 
 #include "test/common/buffer/utility.h"
 #include "test/test_common/printers.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
 #include "gtest/gtest.h"
@@ -60,7 +62,8 @@ bool sliceMatches(const SlicePtr& slice, const std::string& expected) {
 }
 
 TEST_F(OwnedSliceTest, Create) {
-  static constexpr uint64_t Sizes[] = {0, 1, 64, 4096 - sizeof(OwnedSlice), 65535};
+  static constexpr uint64_t Sizes[] = {
+      0, 1, 64, 4096 - sizeof(OwnedSlice) - OwnedSlice::BlockHeaderSize, 65535};
   for (const auto size : Sizes) {
     auto slice = OwnedSlice::create(size);
     EXPECT_NE(nullptr, slice->data());
@@ -69,6 +72,84 @@ TEST_F(OwnedSliceTest, Create) {
   }
 }
 
+#ifndef ENVOY_DISABLE_SLICE_BLOCK_CACHE
+// Tests that released blocks are handed out again to slices of the same size.
+TEST_F(OwnedSliceTest, RecycleReleasedBlocks) {
+  // Take more blocks of this size than are ever cached, so that the block released below is the
+  // only cached one.
+  std::vector<SlicePtr> slices;
+  for (uint32_t i = 0; i < 100; i++) {
+    slices.push_back(OwnedSlice::create(100));
+  }
+
+  auto slice = OwnedSlice::create(100);
+  const void* block = slice.get();
+  slice.reset();
+
+  const uint64_t recycled = OwnedSlice::recycledAllocations();
+  const uint64_t fresh = OwnedSlice::freshAllocations();
+  slice = OwnedSlice::create(200);
+  EXPECT_EQ(block, slice.get());
+  EXPECT_EQ(0, slice->dataSize());
+  EXPECT_LE(200, slice->reservableSize());
+  EXPECT_EQ(recycled + 1, OwnedSlice::recycledAllocations());
+  EXPECT_EQ(fresh, OwnedSlice::freshAllocations());
+
+  // A different number of pages needs a block of its own.
+  auto large_slice = OwnedSlice::create(16384);
+  EXPECT_NE(block, large_slice.get());
+}
+
+// Tests that only a bounded number of released blocks is kept per thread.
+TEST_F(OwnedSliceTest, RecycleIsBounded) {
+  std::vector<SlicePtr> slices;
+  for (uint32_t i = 0; i < 100; i++) {
+    slices.push_back(OwnedSlice::create(8000));
+  }
+  slices.clear();
+
+  const uint64_t recycled = OwnedSlice::recycledAllocations();
+  const uint64_t fresh = OwnedSlice::freshAllocations();
+  for (uint32_t i = 0; i < 100; i++) {
+    slices.push_back(OwnedSlice::create(8000));
+  }
+  const uint64_t num_recycled = OwnedSlice::recycledAllocations() - recycled;
+  EXPECT_LT(0, num_recycled);
+  EXPECT_GT(100, num_recycled);
+  EXPECT_EQ(100, num_recycled + OwnedSlice::freshAllocations() - fresh);
+}
+
+// Tests that slices can be released on a thread other than the one that created them.
+TEST_F(OwnedSliceTest, ReleaseOnOtherThread) {
+  auto slice = OwnedSlice::create("hello", 5);
+  const void* block = slice.get();
+  const uint64_t recycled = OwnedSlice::recycledAllocations();
+  Thread::ThreadPtr thread =
+      Thread::threadFactoryForTest().createThread([&slice, block, recycled]() {
+        EXPECT_TRUE(sliceMatches(slice, "hello"));
+        slice.reset();
+        // The block is now cached by this thread.
+        auto other_slice = OwnedSlice::create(5);
+        EXPECT_EQ(block, other_slice.get());
+        EXPECT_EQ(recycled + 1, OwnedSlice::recycledAllocations());
+      });
+  thread->join();
+  EXPECT_EQ(nullptr, slice);
+  // The counts of a thread are kept after it exits.
+  EXPECT_EQ(recycled + 1, OwnedSlice::recycledAllocations());
+}
+#endif
+
+// Tests that every slice allocation is counted, whichever thread made it.
+TEST_F(OwnedSliceTest, CountAllocations) {
+  const uint64_t total = OwnedSlice::recycledAllocations() + OwnedSlice::freshAllocations();
+  auto slice = OwnedSlice::create(100);
+  Thread::ThreadPtr thread = Thread::threadFactoryForTest().createThread(
+      []() { auto other_slice = OwnedSlice::create(100); });
+  thread->join();
+  EXPECT_EQ(total + 2, OwnedSlice::recycledAllocations() + OwnedSlice::freshAllocations());
+}
+
 TEST_F(OwnedSliceTest, ReserveCommit) {
   auto slice = OwnedSlice::create(100);
   const uint64_t initial_capacity = slice->reservableSize();
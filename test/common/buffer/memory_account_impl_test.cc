@@ -0,0 +1,162 @@
+#include "common/buffer/buffer_impl.h"
+#include "common/buffer/memory_account_impl.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+TEST(BufferMemoryTrackerImplTest, Balance) {
+  BufferMemoryTrackerImpl tracker;
+  BufferMemoryAccountSharedPtr account1 = tracker.createAccount("test", []() {});
+  BufferMemoryAccountSharedPtr account2 = tracker.createAccount("test", []() {});
+
+  account1->charge(10);
+  account2->charge(5);
+  EXPECT_EQ(15, tracker.balance());
+  account1->credit(7);
+  EXPECT_EQ(3, account1->balance());
+  EXPECT_EQ(8, tracker.balance());
+
+  account1->credit(3);
+  account2->credit(5);
+  EXPECT_EQ(0, tracker.balance());
+}
+
+TEST(BufferMemoryTrackerImplTest, LargestBalances) {
+  BufferMemoryTrackerImpl tracker;
+  std::vector<BufferMemoryAccountSharedPtr> accounts;
+  for (uint64_t balance : {3, 0, 7, 1, 5}) {
+    accounts.push_back(tracker.createAccount("test", []() {}));
+    accounts.back()->charge(balance);
+  }
+
+  EXPECT_EQ((std::vector<uint64_t>{7, 5}), tracker.largestBalances(2));
+  // Accounts with an empty balance are left out.
+  EXPECT_EQ((std::vector<uint64_t>{7, 5, 3, 1}), tracker.largestBalances(10));
+  EXPECT_TRUE(tracker.largestBalances(0).empty());
+
+  accounts[0]->credit(3);
+  accounts[2]->credit(7);
+  accounts[3]->credit(1);
+  accounts[4]->credit(5);
+}
+
+TEST(BufferMemoryTrackerImplTest, ChildAccounts) {
+  BufferMemoryTrackerImpl tracker;
+  BufferMemoryAccountSharedPtr account = tracker.createAccount("connection", []() {});
+  OwnedImpl buffer1(std::string(100, 'a'));
+  buffer1.bindAccount(account);
+  {
+    OwnedImpl buffer2(std::string(300, 'a'));
+    OwnedImpl buffer3(std::string(200, 'a'));
+    // Children are charged to their parent, but not listed as accounts of the tracker.
+    buffer2.bindAccount(account->createChildAccount("stream 1"));
+    buffer3.bindAccount(account->createChildAccount("stream 2"));
+    EXPECT_EQ(600, account->balance());
+    EXPECT_EQ(600, tracker.balance());
+    EXPECT_EQ((std::vector<uint64_t>{600}), tracker.largestBalances(2));
+
+    const std::vector<BufferMemoryAccountBalance> largest = tracker.largestAccounts(1);
+    ASSERT_EQ(1, largest.size());
+    EXPECT_EQ("connection", largest[0].description_);
+    EXPECT_EQ(600, largest[0].balance_);
+    ASSERT_EQ(1, largest[0].children_.size());
+    EXPECT_EQ("stream 1", largest[0].children_[0].description_);
+    EXPECT_EQ(300, largest[0].children_[0].balance_);
+    EXPECT_TRUE(largest[0].children_[0].children_.empty());
+  }
+  EXPECT_EQ(100, account->balance());
+  EXPECT_EQ(100, tracker.balance());
+  EXPECT_TRUE(tracker.largestAccounts(1)[0].children_.empty());
+}
+
+TEST(BufferMemoryTrackerImplTest, ChildAccountOutlivesParentOwner) {
+  BufferMemoryTrackerImpl tracker;
+  OwnedImpl buffer(std::string(100, 'a'));
+  {
+    BufferMemoryAccountSharedPtr account = tracker.createAccount("connection", []() {});
+    buffer.bindAccount(account->createChildAccount("stream"));
+  }
+  // The child keeps its parent, and its charges, alive.
+  EXPECT_EQ(100, tracker.balance());
+  EXPECT_EQ(1, tracker.largestAccounts(1).size());
+  buffer.drain(100);
+  EXPECT_EQ(0, tracker.balance());
+}
+
+TEST(BufferMemoryTrackerImplTest, ResetLargestAccounts) {
+  BufferMemoryTrackerImpl tracker;
+  std::vector<uint32_t> reset;
+  std::vector<std::unique_ptr<OwnedImpl>> buffers;
+  for (uint32_t i = 0; i < 4; ++i) {
+    buffers.push_back(std::make_unique<OwnedImpl>(std::string(i * 100, 'a')));
+    buffers.back()->bindAccount(tracker.createAccount("test", [&reset, &buffers, i]() {
+      reset.push_back(i);
+      buffers[i].reset();
+    }));
+  }
+  EXPECT_EQ(600, tracker.balance());
+
+  EXPECT_EQ(2, tracker.resetLargestAccounts(2));
+  EXPECT_EQ((std::vector<uint32_t>{3, 2}), reset);
+  EXPECT_EQ(100, tracker.balance());
+
+  // The empty account is never reset.
+  EXPECT_EQ(1, tracker.resetLargestAccounts(2));
+  EXPECT_EQ((std::vector<uint32_t>{3, 2, 1}), reset);
+  EXPECT_EQ(0, tracker.balance());
+  EXPECT_EQ(0, tracker.resetLargestAccounts(2));
+}
+
+TEST(BufferMemoryTrackerImplTest, ResetReleasesOtherAccount) {
+  BufferMemoryTrackerImpl tracker;
+  auto buffer1 = std::make_unique<OwnedImpl>(std::string(200, 'a'));
+  auto buffer2 = std::make_unique<OwnedImpl>(std::string(100, 'a'));
+  bool buffer2_reset = false;
+  // Resetting the first account also releases the buffer of the second, as when closing a
+  // downstream connection closes its upstream connection. The second account is then not reset.
+  buffer1->bindAccount(tracker.createAccount("test", [&]() {
+    buffer1.reset();
+    buffer2.reset();
+  }));
+  buffer2->bindAccount(tracker.createAccount("test", [&]() { buffer2_reset = true; }));
+
+  EXPECT_EQ(1, tracker.resetLargestAccounts(2));
+  EXPECT_FALSE(buffer2_reset);
+  EXPECT_EQ(0, tracker.balance());
+}
+
+TEST(BufferMemoryTrackerImplTest, ClearResetCallback) {
+  BufferMemoryTrackerImpl tracker;
+  bool reset = false;
+  OwnedImpl buffer1(std::string(200, 'a'));
+  OwnedImpl buffer2(std::string(100, 'a'));
+  BufferMemoryAccountSharedPtr account1 =
+      tracker.createAccount("test", [&reset]() { reset = true; });
+  buffer1.bindAccount(account1);
+  buffer2.bindAccount(
+      tracker.createAccount("test", [&buffer2]() { buffer2.drain(buffer2.length()); }));
+  account1->clearResetCallback();
+
+  // The account is still charged, but the next largest one is reset instead.
+  EXPECT_EQ((std::vector<uint64_t>{200, 100}), tracker.largestBalances(2));
+  EXPECT_EQ(1, tracker.resetLargestAccounts(1));
+  EXPECT_FALSE(reset);
+  EXPECT_EQ(0, tracker.resetLargestAccounts(1));
+}
+
+TEST(BufferMemoryTrackerImplTest, AccountOutlivesTracker) {
+  BufferMemoryAccountSharedPtr account;
+  {
+    BufferMemoryTrackerImpl tracker;
+    account = tracker.createAccount("test", []() {});
+  }
+  account->charge(1);
+  account->credit(1);
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
@@ -1,6 +1,7 @@
 #include "envoy/api/io_error.h"
 
 #include "common/buffer/buffer_impl.h"
+#include "common/buffer/memory_account_impl.h"
 #include "common/network/io_socket_handle_impl.h"
 
 #include "test/common/buffer/utility.h"
@@ -334,6 +335,9 @@ TEST_F(OwnedImplTest, ReserveCommit) {
     Buffer::OwnedImpl buffer;
     // A zero-byte reservation should fail.
     static constexpr uint64_t NumIovecs = 16;
+    // The capacity of a slice that fills one page.
+    static constexpr uint64_t PageSliceCapacity =
+        4096 - sizeof(OwnedSlice) - OwnedSlice::BlockHeaderSize;
     Buffer::RawSlice iovecs[NumIovecs];
     uint64_t num_reserved = buffer.reserve(0, iovecs, NumIovecs);
     EXPECT_EQ(0, num_reserved);
@@ -360,7 +364,7 @@ TEST_F(OwnedImplTest, ReserveCommit) {
     // Request a reservation that is too large to fit in the remaining space at the end of
     // the last slice, and allow the buffer to use only one slice. This should result in the
     // creation of a new slice within the buffer.
-    num_reserved = buffer.reserve(4096 - sizeof(OwnedSlice), iovecs, 1);
+    num_reserved = buffer.reserve(PageSliceCapacity, iovecs, 1);
     EXPECT_EQ(1, num_reserved);
     EXPECT_NE(slice1, iovecs[0].mem_);
     clearReservation(iovecs, num_reserved, buffer);
@@ -368,19 +372,19 @@ TEST_F(OwnedImplTest, ReserveCommit) {
     // Request the same size reservation, but allow the buffer to use multiple slices. This
     // should result in the buffer creating a second slice and splitting the reservation between the
     // last two slices.
-    num_reserved = buffer.reserve(4096 - sizeof(OwnedSlice), iovecs, NumIovecs);
+    num_reserved = buffer.reserve(PageSliceCapacity, iovecs, NumIovecs);
     EXPECT_EQ(2, num_reserved);
     EXPECT_EQ(slice1, iovecs[0].mem_);
     clearReservation(iovecs, num_reserved, buffer);
 
     // Request a reservation that too big to fit in the existing slices. This should result
     // in the creation of a third slice.
-    expectSlices({{1, 4055, 4056}}, buffer);
-    buffer.reserve(4096 - sizeof(OwnedSlice), iovecs, NumIovecs);
-    expectSlices({{1, 4055, 4056}, {0, 4056, 4056}}, buffer);
+    expectSlices({{1, 4047, 4048}}, buffer);
+    buffer.reserve(PageSliceCapacity, iovecs, NumIovecs);
+    expectSlices({{1, 4047, 4048}, {0, 4048, 4048}}, buffer);
     const void* slice2 = iovecs[1].mem_;
     num_reserved = buffer.reserve(8192, iovecs, NumIovecs);
-    expectSlices({{1, 4055, 4056}, {0, 4056, 4056}, {0, 4056, 4056}}, buffer);
+    expectSlices({{1, 4047, 4048}, {0, 4048, 4048}, {0, 4048, 4048}}, buffer);
     EXPECT_EQ(3, num_reserved);
     EXPECT_EQ(slice1, iovecs[0].mem_);
     EXPECT_EQ(slice2, iovecs[1].mem_);
@@ -389,11 +393,11 @@ TEST_F(OwnedImplTest, ReserveCommit) {
     // Append a fragment to the buffer, and then request a small reservation. The buffer
     // should make a new slice to satisfy the reservation; it cannot safely use any of
     // the previously seen slices, because they are no longer at the end of the buffer.
-    expectSlices({{1, 4055, 4056}}, buffer);
+    expectSlices({{1, 4047, 4048}}, buffer);
     buffer.addBufferFragment(fragment);
     EXPECT_EQ(13, buffer.length());
     num_reserved = buffer.reserve(1, iovecs, NumIovecs);
-    expectSlices({{1, 4055, 4056}, {12, 0, 12}, {0, 4056, 4056}}, buffer);
+    expectSlices({{1, 4047, 4048}, {12, 0, 12}, {0, 4048, 4048}}, buffer);
     EXPECT_EQ(1, num_reserved);
     EXPECT_NE(slice1, iovecs[0].mem_);
     commitReservation(iovecs, num_reserved, buffer);
@@ -669,7 +673,7 @@ TEST_F(OwnedImplTest, ReserveZeroCommit) {
   ASSERT_EQ(os_sys_calls.close(pipe_fds[1]).rc_, 0);
   ASSERT_EQ(previous_length, buf.search(data.data(), rc, previous_length));
   EXPECT_EQ("bbbbb", buf.toString().substr(0, 5));
-  expectSlices({{5, 0, 4056}, {1953, 2103, 4056}}, buf);
+  expectSlices({{5, 0, 4048}, {1953, 2095, 4048}}, buf);
 }
 
 TEST_F(OwnedImplTest, ReadReserveAndCommit) {
@@ -696,7 +700,7 @@ TEST_F(OwnedImplTest, ReadReserveAndCommit) {
   ASSERT_EQ(result.rc_, static_cast<uint64_t>(rc));
   ASSERT_EQ(os_sys_calls.close(pipe_fds[1]).rc_, 0);
   EXPECT_EQ("bbbbbe", buf.toString());
-  expectSlices({{6, 4050, 4056}}, buf);
+  expectSlices({{6, 4042, 4048}}, buf);
 }
 
 TEST(OverflowDetectingUInt64, Arithmetic) {
@@ -760,6 +764,158 @@ TEST_F(OwnedImplTest, MoveSmallSliceIntoNotEnoughFreeSpace) {
   TestBufferMove(4096 - 127, 128, 2);
 }
 
+// moveSharingSlices() shares the storage of a slice when moving a large part of it.
+TEST_F(OwnedImplTest, MovePartialSliceSharesStorage) {
+  Buffer::OwnedImpl buffer1;
+  buffer1.add(std::string(2048, 'a'));
+  buffer1.add(std::string(2048, 'b'));
+  const void* data = buffer1.getRawSlices().front().mem_;
+
+  Buffer::OwnedImpl buffer2;
+  buffer2.moveSharingSlices(buffer1, 3072);
+  EXPECT_EQ(1024, buffer1.length());
+  EXPECT_EQ(3072, buffer2.length());
+  EXPECT_EQ(data, buffer2.getRawSlices().front().mem_);
+  EXPECT_EQ(static_cast<const uint8_t*>(data) + 3072, buffer1.getRawSlices().front().mem_);
+  EXPECT_EQ(std::string(2048, 'a') + std::string(1024, 'b'), buffer2.toString());
+  EXPECT_EQ(std::string(1024, 'b'), buffer1.toString());
+
+  // Splitting a shared slice again still shares the original storage.
+  Buffer::OwnedImpl buffer3;
+  buffer3.moveSharingSlices(buffer2, 2560);
+  EXPECT_EQ(data, buffer3.getRawSlices().front().mem_);
+  EXPECT_EQ(std::string(2048, 'a') + std::string(512, 'b'), buffer3.toString());
+  EXPECT_EQ(std::string(512, 'b'), buffer2.toString());
+
+  // Appending to a buffer ending in a shared slice never writes into the shared storage.
+  buffer3.add("c");
+  EXPECT_EQ(2, buffer3.getRawSlices().size());
+  EXPECT_EQ(std::string(512, 'b'), buffer2.toString());
+}
+
+// Small parts of a slice are still copied.
+TEST_F(OwnedImplTest, MoveSmallPartialSliceCopies) {
+  Buffer::OwnedImpl buffer1;
+  buffer1.add(std::string(2048, 'a'));
+  const void* data = buffer1.getRawSlices().front().mem_;
+
+  Buffer::OwnedImpl buffer2;
+  buffer2.moveSharingSlices(buffer1, 100);
+  EXPECT_NE(data, buffer2.getRawSlices().front().mem_);
+  EXPECT_EQ(std::string(100, 'a'), buffer2.toString());
+  EXPECT_EQ(1948, buffer1.length());
+}
+
+// Small fractions of a large slice are copied, as a view would pin the whole slice.
+TEST_F(OwnedImplTest, MoveSmallFractionOfLargeSliceCopies) {
+  Buffer::OwnedImpl buffer1;
+  buffer1.add(std::string(65536, 'a'));
+  ASSERT_EQ(1, buffer1.getRawSlices().size());
+  const void* data = buffer1.getRawSlices().front().mem_;
+
+  Buffer::OwnedImpl buffer2;
+  buffer2.moveSharingSlices(buffer1, 4096);
+  EXPECT_NE(data, buffer2.getRawSlices().front().mem_);
+  EXPECT_EQ(std::string(4096, 'a'), buffer2.toString());
+
+  Buffer::OwnedImpl buffer3;
+  buffer3.moveSharingSlices(buffer1, 32768);
+  EXPECT_EQ(static_cast<const uint8_t*>(data) + 4096, buffer3.getRawSlices().front().mem_);
+  EXPECT_EQ(28672, buffer1.length());
+}
+
+// Plain partial moves always copy.
+TEST_F(OwnedImplTest, MovePartialSliceCopies) {
+  Buffer::OwnedImpl buffer1;
+  buffer1.add(std::string(4096, 'a'));
+  const void* data = buffer1.getRawSlices().front().mem_;
+
+  Buffer::OwnedImpl buffer2;
+  buffer2.move(buffer1, 3072);
+  EXPECT_NE(data, buffer2.getRawSlices().front().mem_);
+  EXPECT_EQ(std::string(3072, 'a'), buffer2.toString());
+  EXPECT_EQ(1024, buffer1.length());
+}
+
+// A fragment split between buffers is released once both parts are drained.
+TEST_F(OwnedImplTest, MovePartialFragmentReleasedAfterAllParts) {
+  std::string input(4096, 'a');
+  BufferFragmentImpl frag(
+      input.c_str(), input.size(),
+      [this](const void*, size_t, const BufferFragmentImpl*) { release_callback_called_ = true; });
+  Buffer::OwnedImpl buffer1;
+  buffer1.addBufferFragment(frag);
+
+  Buffer::OwnedImpl buffer2;
+  buffer2.moveSharingSlices(buffer1, 1024);
+  EXPECT_EQ(input.c_str(), buffer2.getRawSlices().front().mem_);
+
+  // Views have no reservable space, so added data goes into a new slice.
+  buffer2.add(std::string(10, 'b'));
+  EXPECT_EQ(2, buffer2.getRawSlices().size());
+
+  buffer1.drain(buffer1.length());
+  EXPECT_FALSE(release_callback_called_);
+  buffer2.drain(buffer2.length());
+  EXPECT_TRUE(release_callback_called_);
+}
+
+TEST_F(OwnedImplTest, BoundAccountChargedAndCredited) {
+  BufferMemoryTrackerImpl tracker;
+  BufferMemoryAccountSharedPtr account = tracker.createAccount("test", []() {});
+  Buffer::OwnedImpl buffer1("abc");
+  Buffer::OwnedImpl buffer2;
+
+  // Binding charges the data already in the buffer.
+  buffer1.bindAccount(account);
+  buffer2.bindAccount(account);
+  EXPECT_EQ(3, account->balance());
+
+  buffer1.add(std::string(4096, 'a'));
+  EXPECT_EQ(4099, account->balance());
+  buffer1.drain(99);
+  EXPECT_EQ(4000, account->balance());
+
+  // Moving between buffers bound to the same account leaves the balance unchanged.
+  buffer2.move(buffer1, 1000);
+  EXPECT_EQ(4000, account->balance());
+  EXPECT_EQ(4000, tracker.balance());
+
+  // Moving to an unbound buffer credits the account.
+  Buffer::OwnedImpl buffer3;
+  buffer3.move(buffer2);
+  EXPECT_EQ(3000, account->balance());
+
+  buffer1.bindAccount(nullptr);
+  EXPECT_EQ(0, account->balance());
+  EXPECT_EQ(0, tracker.balance());
+}
+
+TEST_F(OwnedImplTest, BoundAccountCreditedOnDestruction) {
+  BufferMemoryTrackerImpl tracker;
+  BufferMemoryAccountSharedPtr account = tracker.createAccount("test", []() {});
+  {
+    Buffer::OwnedImpl buffer("abc");
+    buffer.bindAccount(account);
+    EXPECT_EQ(3, tracker.balance());
+  }
+  EXPECT_EQ(0, account->balance());
+  EXPECT_EQ(0, tracker.balance());
+}
+
+TEST_F(OwnedImplTest, RebindAccount) {
+  BufferMemoryTrackerImpl tracker;
+  BufferMemoryAccountSharedPtr account1 = tracker.createAccount("test", []() {});
+  BufferMemoryAccountSharedPtr account2 = tracker.createAccount("test", []() {});
+  Buffer::OwnedImpl buffer("abc");
+
+  buffer.bindAccount(account1);
+  buffer.bindAccount(account2);
+  EXPECT_EQ(0, account1->balance());
+  EXPECT_EQ(3, account2->balance());
+  EXPECT_EQ(3, tracker.balance());
+}
+
 } // namespace
 } // namespace Buffer
 } // namespace Envoy
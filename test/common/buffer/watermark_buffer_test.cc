@@ -203,6 +203,16 @@ TEST_F(WatermarkBufferTest, MoveOneByte) {
   EXPECT_EQ(11, buffer_.length());
 }
 
+TEST_F(WatermarkBufferTest, MoveSharingSlices) {
+  buffer_.add(TEN_BYTES, 9);
+  OwnedImpl data(std::string(4096, 'a'));
+
+  buffer_.moveSharingSlices(data, 2048);
+  EXPECT_EQ(1, times_high_watermark_called_);
+  EXPECT_EQ(2057, buffer_.length());
+  EXPECT_EQ(2048, data.length());
+}
+
 TEST_F(WatermarkBufferTest, WatermarkFdFunctions) {
   os_fd_t pipe_fds[2] = {0, 0};
 #ifdef WIN32
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "envoy/common/exception.h"
 #include "envoy/type/matcher/v3/regex.pb.h"
 
@@ -73,6 +75,77 @@ TEST(Utility, ParseRegex) {
   }
 }
 
+TEST(CompiledMatcherSet, Match) {
+  CompiledMatcherSet set({"/foo/.*", "/foo/bar", "/baz/[0-9]+", ".*"});
+  EXPECT_EQ((std::vector<int>{0, 1, 3}), set.match("/foo/bar"));
+  EXPECT_EQ((std::vector<int>{0, 3}), set.match("/foo/baz"));
+  EXPECT_EQ((std::vector<int>{2, 3}), set.match("/baz/42"));
+  // Patterns must match the whole value.
+  EXPECT_EQ((std::vector<int>{3}), set.match("/baz/42/"));
+
+  EXPECT_THROW_WITH_REGEX(CompiledMatcherSet({"/foo", "(+invalid)"}), EnvoyException,
+                          "invalid regex '\\(\\+invalid\\)': .+");
+}
+
+TEST(CompiledMatcherSet, MatchAny) {
+  CompiledMatcherSet set({"x-foo-.*", "x-bar"});
+  EXPECT_TRUE(set.matchAny("x-foo-baz"));
+  EXPECT_TRUE(set.matchAny("x-bar"));
+  EXPECT_FALSE(set.matchAny("x-bar-baz"));
+  EXPECT_FALSE(CompiledMatcherSet({}).matchAny("x-bar"));
+}
+
+TEST(CompiledRegexCache, SharesPrograms) {
+  CompiledRegexCache cache;
+  auto regex1 = cache.getOrCompile("/asdf/.*");
+  auto regex2 = cache.getOrCompile("/asdf/.*");
+  auto regex3 = cache.getOrCompile("x*");
+  EXPECT_EQ(regex1, regex2);
+  EXPECT_NE(regex1, regex3);
+
+  auto entries = cache.entries();
+  ASSERT_EQ(2, entries.size());
+  EXPECT_EQ("/asdf/.*", entries[0].regex_);
+  EXPECT_EQ(regex1->ProgramSize(), entries[0].program_size_);
+  EXPECT_EQ(2, entries[0].references_);
+  EXPECT_EQ("x*", entries[1].regex_);
+  EXPECT_EQ(1, entries[1].references_);
+  EXPECT_GT(entries[0].program_size_, entries[1].program_size_);
+  EXPECT_EQ(2, cache.size());
+  EXPECT_EQ(entries[0].program_size_, cache.maxProgramSize());
+
+  // Programs are freed with their last user.
+  regex1.reset();
+  regex3.reset();
+  entries = cache.entries();
+  ASSERT_EQ(1, entries.size());
+  EXPECT_EQ(1, entries[0].references_);
+  regex2.reset();
+  EXPECT_TRUE(cache.entries().empty());
+  EXPECT_EQ(0, cache.size());
+  EXPECT_EQ(0, cache.maxProgramSize());
+
+  EXPECT_THROW_WITH_MESSAGE(cache.getOrCompile("(+invalid)"), EnvoyException,
+                            "no argument for repetition operator: +");
+  EXPECT_TRUE(cache.entries().empty());
+}
+
+TEST(CompiledRegexCache, SharedByParsedMatchers) {
+  envoy::type::matcher::v3::RegexMatcher matcher;
+  matcher.mutable_google_re2();
+  matcher.set_regex("/shared_by_parsed_matchers/[0-9]+");
+  const auto compiled_matcher1 = Utility::parseRegex(matcher);
+  const auto compiled_matcher2 = Utility::parseRegex(matcher);
+  EXPECT_TRUE(compiled_matcher2->match("/shared_by_parsed_matchers/42"));
+
+  const auto entries = CompiledRegexCache::get().entries();
+  const auto entry = std::find_if(entries.begin(), entries.end(), [](const auto& entry) {
+    return entry.regex_ == "/shared_by_parsed_matchers/[0-9]+";
+  });
+  ASSERT_NE(entries.end(), entry);
+  EXPECT_EQ(2, entry->references_);
+}
+
 } // namespace
 } // namespace Regex
 } // namespace Envoy
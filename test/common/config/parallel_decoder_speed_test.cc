@@ -0,0 +1,61 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/config/cluster/v3/cluster.pb.validate.h"
+
+#include "common/config/parallel_decoder.h"
+
+#include "test/mocks/protobuf/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+// Decode and validate a CDS update of the given number of EDS clusters over the given number of
+// threads, as CdsApiImpl does before applying the clusters.
+static void decodeClusters(benchmark::State& state) {
+  const uint32_t concurrency = state.range(0);
+  const int num_clusters = state.range(1);
+  Envoy::Protobuf::RepeatedPtrField<Envoy::ProtobufWkt::Any> resources;
+  for (int i = 0; i < num_clusters; ++i) {
+    const auto cluster = Envoy::TestUtility::parseYaml<envoy::config::cluster::v3::Cluster>(
+        absl::StrCat(R"EOF(
+name: cluster_)EOF",
+                     i, R"EOF(
+connect_timeout: 0.25s
+type: EDS
+lb_policy: ROUND_ROBIN
+eds_cluster_config:
+  service_name: service_)EOF",
+                     i, R"EOF(
+  eds_config:
+    ads: {}
+circuit_breakers:
+  thresholds:
+  - max_connections: 1000
+    max_pending_requests: 1000
+    max_requests: 1000
+outlier_detection:
+  consecutive_5xx: 5
+  interval: 10s
+)EOF"));
+    resources.Add()->PackFrom(cluster);
+  }
+
+  Envoy::Api::ApiPtr api = Envoy::Api::createApiForTest();
+  Envoy::Config::ParallelDecoder decoder(api->threadFactory(), concurrency);
+  testing::NiceMock<Envoy::ProtobufMessage::MockValidationVisitor> validation_visitor;
+  for (auto _ : state) {
+    const auto decoded = decoder.decode<envoy::config::cluster::v3::Cluster>(resources);
+    for (const auto& cluster : decoded) {
+      benchmark::DoNotOptimize(cluster.validate(validation_visitor).name());
+    }
+  }
+}
+BENCHMARK(decodeClusters)
+    ->Args({1, 1000})
+    ->Args({4, 1000})
+    ->Args({1, 20000})
+    ->Args({4, 20000})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,161 @@
+#include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/config/cluster/v3/cluster.pb.validate.h"
+
+#include "common/config/parallel_decoder.h"
+
+#include "test/mocks/protobuf/mocks.h"
+#include "test/test_common/test_runtime.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Config {
+namespace {
+
+class ParallelDecoderTest : public testing::TestWithParam<uint32_t> {
+public:
+  ParallelDecoderTest() : decoder_(api_->threadFactory(), GetParam()) {}
+
+  Api::ApiPtr api_{Api::createApiForTest()};
+  ParallelDecoder decoder_;
+  NiceMock<ProtobufMessage::MockValidationVisitor> validation_visitor_;
+};
+
+INSTANTIATE_TEST_SUITE_P(Concurrency, ParallelDecoderTest, testing::Values(1, 4));
+
+// Results are returned in the order of the resources, whether or not threads are used.
+TEST_P(ParallelDecoderTest, DecodeInOrder) {
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources;
+  for (int i = 0; i < 1000; ++i) {
+    envoy::config::cluster::v3::Cluster cluster;
+    cluster.set_name(absl::StrCat("cluster_", i));
+    resources.Add()->PackFrom(cluster);
+  }
+
+  const auto decoded = decoder_.decode<envoy::config::cluster::v3::Cluster>(resources);
+  ASSERT_EQ(1000, decoded.size());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(absl::StrCat("cluster_", i), decoded[i].validate(validation_visitor_).name());
+  }
+}
+
+TEST_P(ParallelDecoderTest, DecodeDeltaResources) {
+  Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource> resources;
+  for (int i = 0; i < 200; ++i) {
+    envoy::config::cluster::v3::Cluster cluster;
+    cluster.set_name(absl::StrCat("cluster_", i));
+    resources.Add()->mutable_resource()->PackFrom(cluster);
+  }
+
+  const auto decoded = decoder_.decode<envoy::config::cluster::v3::Cluster>(resources);
+  ASSERT_EQ(200, decoded.size());
+  EXPECT_EQ("cluster_199", decoded[199].message().name());
+}
+
+// Unpack and validation failures are reported when the resource is used.
+TEST_P(ParallelDecoderTest, Errors) {
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources;
+  for (int i = 0; i < 200; ++i) {
+    envoy::config::cluster::v3::Cluster cluster;
+    cluster.set_name(absl::StrCat("cluster_", i));
+    resources.Add()->PackFrom(cluster);
+  }
+  resources[10].set_type_url("type.googleapis.com/envoy.config.listener.v3.Listener");
+  resources[20].PackFrom(envoy::config::cluster::v3::Cluster());
+
+  const auto decoded = decoder_.decode<envoy::config::cluster::v3::Cluster>(resources);
+  EXPECT_THROW_WITH_REGEX(decoded[10].message(), EnvoyException, "Unable to unpack as");
+  EXPECT_THROW_WITH_REGEX(decoded[10].validate(validation_visitor_), EnvoyException,
+                          "Unable to unpack as");
+  EXPECT_EQ("", decoded[20].message().name());
+  EXPECT_THROW_WITH_REGEX(decoded[20].validate(validation_visitor_), ProtoValidationException,
+                          "ClusterValidationError.Name");
+  EXPECT_EQ("cluster_30", decoded[30].validate(validation_visitor_).name());
+}
+
+// Unknown fields are reported to the validation visitor on the calling thread.
+TEST_P(ParallelDecoderTest, UnknownFields) {
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources;
+  envoy::config::cluster::v3::Cluster cluster;
+  cluster.set_name("cluster");
+  cluster.GetReflection()->MutableUnknownFields(&cluster)->AddVarint(1000, 1);
+  resources.Add()->PackFrom(cluster);
+
+  const auto decoded = decoder_.decode<envoy::config::cluster::v3::Cluster>(resources);
+  EXPECT_CALL(validation_visitor_, onUnknownField(_));
+  decoded[0].validate(validation_visitor_);
+}
+
+TEST_P(ParallelDecoderTest, RuntimeDisabled) {
+  TestScopedRuntime scoped_runtime;
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.parallel_xds_decoding", "false"}});
+
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources;
+  for (int i = 0; i < 1000; ++i) {
+    envoy::config::cluster::v3::Cluster cluster;
+    cluster.set_name(absl::StrCat("cluster_", i));
+    resources.Add()->PackFrom(cluster);
+  }
+
+  const auto decoded = decoder_.decode<envoy::config::cluster::v3::Cluster>(resources);
+  ASSERT_EQ(1000, decoded.size());
+  EXPECT_EQ("cluster_999", decoded[999].validate(validation_visitor_).name());
+}
+
+// Counts the threads created through it.
+class CountingThreadFactory : public Thread::ThreadFactory {
+public:
+  explicit CountingThreadFactory(Thread::ThreadFactory& factory) : factory_(factory) {}
+
+  Thread::ThreadPtr createThread(std::function<void()> thread_routine,
+                                 Thread::OptionsOptConstRef options) override {
+    threads_created_++;
+    return factory_.createThread(std::move(thread_routine), options);
+  }
+  Thread::ThreadId currentThreadId() override { return factory_.currentThreadId(); }
+
+  Thread::ThreadFactory& factory_;
+  uint32_t threads_created_{};
+};
+
+// The helper threads are only started by an update large enough to use them, and are reused by the
+// following updates.
+TEST(ParallelDecoderPoolTest, HelpersStartedOnceAndReused) {
+  Api::ApiPtr api = Api::createApiForTest();
+  CountingThreadFactory thread_factory(api->threadFactory());
+  ParallelDecoder decoder(thread_factory, 4);
+
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources;
+  for (int i = 0; i < 10; ++i) {
+    envoy::config::cluster::v3::Cluster cluster;
+    cluster.set_name(absl::StrCat("cluster_", i));
+    resources.Add()->PackFrom(cluster);
+  }
+  EXPECT_EQ("cluster_9",
+            decoder.decode<envoy::config::cluster::v3::Cluster>(resources)[9].message().name());
+  EXPECT_EQ(0U, thread_factory.threads_created_);
+
+  for (int i = 10; i < 1000; ++i) {
+    envoy::config::cluster::v3::Cluster cluster;
+    cluster.set_name(absl::StrCat("cluster_", i));
+    resources.Add()->PackFrom(cluster);
+  }
+  for (int update = 0; update < 5; ++update) {
+    const auto decoded = decoder.decode<envoy::config::cluster::v3::Cluster>(resources);
+    ASSERT_EQ(1000, decoded.size());
+    for (int i = 0; i < 1000; ++i) {
+      EXPECT_EQ(absl::StrCat("cluster_", i), decoded[i].message().name());
+    }
+  }
+  EXPECT_EQ(3U, thread_factory.threads_created_);
+}
+
+} // namespace
+} // namespace Config
+} // namespace Envoy
@@ -15,6 +15,7 @@
 
 #include "common/access_log/access_log_impl.h"
 #include "common/buffer/buffer_impl.h"
+#include "common/buffer/memory_account_impl.h"
 #include "common/common/empty_string.h"
 #include "common/common/macros.h"
 #include "common/formatter/substitution_formatter.h"
@@ -4755,6 +4756,47 @@ TEST_F(HttpConnectionManagerImplTest, HitRequestBufferLimitsIntermediateFilter)
   conn_manager_->onData(fake_input, false);
 }
 
+// Request data buffered by the filters is charged to the memory account of the stream, within the
+// account of the downstream connection, until the stream is destroyed.
+TEST_F(HttpConnectionManagerImplTest, BufferedRequestDataChargesConnectionAccount) {
+  setup(false, "");
+  Buffer::BufferMemoryTrackerImpl tracker;
+  const Buffer::BufferMemoryAccountSharedPtr account = tracker.createAccount("connection", []() {});
+  ON_CALL(filter_callbacks_.connection_, bufferMemoryAccount()).WillByDefault(Return(account));
+
+  EXPECT_CALL(*codec_, dispatch(_)).WillOnce(Invoke([&](Buffer::Instance&) -> Http::Status {
+    RequestDecoder* decoder = &conn_manager_->newStream(response_encoder_);
+    RequestHeaderMapPtr headers{
+        new TestRequestHeaderMapImpl{{":authority", "host"}, {":path", "/"}, {":method", "POST"}}};
+    decoder->decodeHeaders(std::move(headers), false);
+
+    Buffer::OwnedImpl fake_data("hello");
+    decoder->decodeData(fake_data, false);
+    return Http::okStatus();
+  }));
+
+  setupFilterChain(1, 0);
+  EXPECT_CALL(*decoder_filters_[0], decodeHeaders(_, false))
+      .WillOnce(Return(FilterHeadersStatus::StopIteration));
+  EXPECT_CALL(*decoder_filters_[0], decodeData(_, false))
+      .WillOnce(Return(FilterDataStatus::StopIterationAndBuffer));
+
+  Buffer::OwnedImpl fake_input("1234");
+  conn_manager_->onData(fake_input, false);
+  EXPECT_EQ(5, decoder_filters_[0]->callbacks_->decodingBuffer()->length());
+  EXPECT_EQ(5, account->balance());
+  const std::vector<Buffer::BufferMemoryAccountBalance> largest = tracker.largestAccounts(1);
+  ASSERT_EQ(1, largest.size());
+  ASSERT_EQ(1, largest[0].children_.size());
+  EXPECT_THAT(largest[0].children_[0].description_, testing::StartsWith("stream "));
+  EXPECT_EQ(5, largest[0].children_[0].balance_);
+
+  EXPECT_CALL(*decoder_filters_[0], onDestroy());
+  conn_manager_->onEvent(Network::ConnectionEvent::RemoteClose);
+  filter_callbacks_.connection_.dispatcher_.clearDeferredDeleteList();
+  EXPECT_EQ(0, account->balance());
+}
+
 TEST_F(HttpConnectionManagerImplTest, HitResponseBufferLimitsBeforeHeaders) {
   initial_buffer_limit_ = 10;
   setup(false, "");
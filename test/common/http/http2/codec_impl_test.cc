@@ -4,6 +4,7 @@
 #include "envoy/http/codec.h"
 #include "envoy/stats/scope.h"
 
+#include "common/buffer/memory_account_impl.h"
 #include "common/http/exception.h"
 #include "common/http/header_map_impl.h"
 #include "common/http/http2/codec_impl.h"
@@ -262,6 +263,50 @@ protected:
     }
   }
 
+  // Send a request body to the server and verify that it is received intact, and whether the
+  // received data shares the memory of the buffer dispatched to the server.
+  void testReceivedData(bool expect_shared) {
+    // Buffer client data so that it is dispatched to the server at once.
+    ON_CALL(client_connection_, write(_, _))
+        .WillByDefault(
+            Invoke([&](Buffer::Instance& data, bool) -> void { server_wrapper_.buffer_.add(data); }));
+
+    TestRequestHeaderMapImpl request_headers;
+    HttpTestUtility::addDefaultHeaders(request_headers, "POST");
+    request_encoder_->encodeHeaders(request_headers, false);
+    std::string body;
+    for (uint32_t i = 0; i < 32 * 1024; ++i) {
+      body.push_back('a' + i % 26);
+    }
+    Buffer::OwnedImpl request_body(body);
+    request_encoder_->encodeData(request_body, true);
+
+    std::vector<std::pair<const uint8_t*, const uint8_t*>> dispatched;
+    for (const Buffer::RawSlice& slice : server_wrapper_.buffer_.getRawSlices()) {
+      const uint8_t* start = static_cast<const uint8_t*>(slice.mem_);
+      dispatched.emplace_back(start, start + slice.len_);
+    }
+    std::string received;
+    bool shared = false;
+    EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+    EXPECT_CALL(request_decoder_, decodeData(_, _))
+        .Times(AtLeast(1))
+        .WillRepeatedly(Invoke([&](Buffer::Instance& data, bool) -> void {
+          for (const Buffer::RawSlice& slice : data.getRawSlices()) {
+            for (const auto& range : dispatched) {
+              shared |= slice.mem_ >= range.first && slice.mem_ < range.second;
+            }
+          }
+          received.append(data.toString());
+        }));
+
+    setupDefaultConnectionMocks();
+    auto status = server_wrapper_.dispatch(Buffer::OwnedImpl(), *server_);
+    EXPECT_TRUE(status.ok());
+    EXPECT_EQ(body, received);
+    EXPECT_EQ(expect_shared, shared);
+  }
+
   void windowUpdateFlood() {
     initialize();
 
@@ -614,6 +659,39 @@ TEST_P(Http2CodecImplTest, TrailingHeadersLargeBody) {
   response_encoder_->encodeTrailers(TestResponseTrailerMapImpl{{"trailing", "header"}});
 }
 
+// Verify that received header strings from the HPACK static table are referenced, not copied.
+TEST_P(Http2CodecImplTest, StaticTableHeadersReferenced) {
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  request_headers.addCopy("user-agent", "test");
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true))
+      .WillOnce(Invoke([](RequestHeaderMapPtr& headers, bool) -> void {
+        // ":method: GET" is fully in the static table.
+        EXPECT_EQ("GET", headers->Method()->value().getStringView());
+        EXPECT_TRUE(headers->Method()->value().isReference());
+        // "user-agent" is a static table name but the value is a literal.
+        EXPECT_EQ("test", headers->UserAgent()->value().getStringView());
+        EXPECT_FALSE(headers->UserAgent()->value().isReference());
+      }));
+  request_encoder_->encodeHeaders(request_headers, true);
+}
+
+// Verify that received DATA payloads are moved out of the dispatched buffer rather than copied.
+TEST_P(Http2CodecImplTest, ReceivedDataSharesDispatchedBuffer) {
+  initialize();
+  testReceivedData(true);
+}
+
+TEST_P(Http2CodecImplTest, ReceivedDataCopiedWithRuntimeDisabled) {
+  TestScopedRuntime scoped_runtime;
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.http2_dispatch_without_copy", "false"}});
+  initialize();
+  testReceivedData(false);
+}
+
 TEST_P(Http2CodecImplTest, SmallMetadataVecTest) {
   allow_metadata_ = true;
   initialize();
@@ -903,6 +981,35 @@ TEST_P(Http2CodecImplFlowControlTest, TestFlowControlInPendingSendData) {
             nghttp2_session_get_stream_remote_window_size(client_->session(), 1));
 }
 
+// Data backed up in the send buffer of a stream is charged to the memory account of its connection.
+TEST_P(Http2CodecImplFlowControlTest, PendingSendDataChargesConnectionAccount) {
+  Buffer::BufferMemoryTrackerImpl tracker;
+  const Buffer::BufferMemoryAccountSharedPtr account = tracker.createAccount("test", []() {});
+  ON_CALL(client_connection_, bufferMemoryAccount()).WillByDefault(Return(account));
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  request_encoder_->encodeHeaders(request_headers, false);
+  server_->getStream(1)->readDisable(true);
+
+  // Fill the flow control window, so that the following data backs up in the send buffer.
+  const uint32_t initial_stream_window =
+      nghttp2_session_get_stream_effective_local_window_size(client_->session(), 1);
+  EXPECT_CALL(request_decoder_, decodeData(_, false)).Times(AnyNumber());
+  Buffer::OwnedImpl long_data(std::string(initial_stream_window, 'a'));
+  request_encoder_->encodeData(long_data, false);
+  Buffer::OwnedImpl more_data(std::string(1024, 'a'));
+  request_encoder_->encodeData(more_data, false);
+  EXPECT_EQ(1024, client_->getStream(1)->pending_send_data_.length());
+  EXPECT_EQ(1024, account->balance());
+
+  server_->getStream(1)->readDisable(false);
+  EXPECT_EQ(0, client_->getStream(1)->pending_send_data_.length());
+  EXPECT_EQ(0, account->balance());
+}
+
 // Set up the same asTestFlowControlInPendingSendData, but tears the stream down with an early reset
 // once the flow control window is full up.
 TEST_P(Http2CodecImplFlowControlTest, EarlyResetRestoresWindow) {
@@ -1620,6 +1727,52 @@ TEST_P(Http2CodecImplTest, PingFloodCounterReset) {
   EXPECT_THROW(client_->sendPendingFrames(), ServerCodecError);
 }
 
+// Verify that with coalesced writes the frames emitted at once are written together, and are
+// released from the outbound queue once all of them have been written.
+TEST_P(Http2CodecImplTest, PingFloodCounterResetCoalescedWrites) {
+  TestScopedRuntime scoped_runtime;
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.http2_coalesce_writes", "true"}});
+  static const int kMaxOutboundControlFrames = 100;
+  max_outbound_control_frames_ = kMaxOutboundControlFrames;
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  request_encoder_->encodeHeaders(request_headers, false);
+
+  for (int i = 0; i < kMaxOutboundControlFrames; ++i) {
+    EXPECT_EQ(0, nghttp2_submit_ping(client_->session(), NGHTTP2_FLAG_NONE, nullptr));
+  }
+
+  int write_count = 0;
+  Buffer::OwnedImpl buffer;
+  ON_CALL(server_connection_, write(_, _))
+      .WillByDefault(Invoke([&buffer, &write_count](Buffer::Instance& frame, bool) {
+        ++write_count;
+        buffer.move(frame);
+      }));
+
+  // All the PING ACKs are written at once.
+  EXPECT_NO_THROW(client_->sendPendingFrames());
+  EXPECT_EQ(1, write_count);
+
+  // Writing all of them releases all of them.
+  buffer.drain(buffer.length());
+  for (int i = 0; i < kMaxOutboundControlFrames; ++i) {
+    EXPECT_EQ(0, nghttp2_submit_ping(client_->session(), NGHTTP2_FLAG_NONE, nullptr));
+  }
+  EXPECT_NO_THROW(client_->sendPendingFrames());
+  EXPECT_EQ(2, write_count);
+
+  // Writing only some of them releases none of them, so 1 more ping frame overflows the outbound
+  // frame limit.
+  buffer.drain(buffer.length() / 2);
+  EXPECT_EQ(0, nghttp2_submit_ping(client_->session(), NGHTTP2_FLAG_NONE, nullptr));
+  EXPECT_THROW(client_->sendPendingFrames(), ServerCodecError);
+}
+
 // Verify that codec detects flood of outbound HEADER frames
 TEST_P(Http2CodecImplTest, ResponseHeadersFlood) {
   initialize();
@@ -0,0 +1,182 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "envoy/config/core/v3/protocol.pb.h"
+
+#include "common/buffer/buffer_impl.h"
+#include "common/http/http2/codec_impl.h"
+#include "common/http/utility.h"
+#include "common/stats/isolated_store_impl.h"
+
+#include "test/common/http/http2/codec_impl_test_util.h"
+#include "test/mocks/http/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/test_common/test_runtime.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Http {
+namespace Http2 {
+
+// A client and a server codec connected back to back: whatever one of them writes is dispatched to
+// the other.
+class Http2CodecSpeedTest {
+public:
+  Http2CodecSpeedTest()
+      : http2_options_(::Envoy::Http2::Utility::initializeAndValidateOptions(
+            envoy::config::core::v3::Http2ProtocolOptions())),
+        client_(client_connection_, client_callbacks_, stats_store_, http2_options_,
+                DEFAULT_MAX_REQUEST_HEADERS_KB, DEFAULT_MAX_HEADERS_COUNT,
+                ProdNghttp2SessionFactory::get()),
+        server_(server_connection_, server_callbacks_, stats_store_, http2_options_,
+                DEFAULT_MAX_REQUEST_HEADERS_KB, DEFAULT_MAX_HEADERS_COUNT,
+                envoy::config::core::v3::HttpProtocolOptions::ALLOW) {
+    ON_CALL(client_connection_, write(_, _))
+        .WillByDefault(Invoke([this](Buffer::Instance& data, bool) -> void {
+          ++writes_;
+          server_wrapper_.dispatch(data, server_);
+        }));
+    ON_CALL(server_connection_, write(_, _))
+        .WillByDefault(Invoke([this](Buffer::Instance& data, bool) -> void {
+          ++writes_;
+          client_wrapper_.dispatch(data, client_);
+        }));
+    EXPECT_CALL(client_connection_.dispatcher_, deferredDelete_(_)).Times(AnyNumber());
+    EXPECT_CALL(server_connection_.dispatcher_, deferredDelete_(_)).Times(AnyNumber());
+    ON_CALL(server_callbacks_, newStream(_, _))
+        .WillByDefault(Invoke([this](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+          response_encoder_ = &encoder;
+          return request_decoder_;
+        }));
+  }
+
+  // Send a request and its response, both header only, on a new stream.
+  void exchangeHeaders(const RequestHeaderMap& request_headers,
+                       const ResponseHeaderMap& response_headers) {
+    RequestEncoder& request_encoder = client_.newStream(response_decoder_);
+    request_encoder.encodeHeaders(request_headers, true);
+    response_encoder_->encodeHeaders(response_headers, true);
+    // Release the closed streams.
+    client_connection_.dispatcher_.to_delete_.clear();
+    server_connection_.dispatcher_.to_delete_.clear();
+  }
+
+  // Send a request with a body of the given number of chunks on a new stream, and a header only
+  // response.
+  void exchangeBody(const RequestHeaderMap& request_headers, const std::string& chunk,
+                    uint64_t chunks, const ResponseHeaderMap& response_headers) {
+    RequestEncoder& request_encoder = client_.newStream(response_decoder_);
+    request_encoder.encodeHeaders(request_headers, false);
+    for (uint64_t i = 0; i < chunks; ++i) {
+      Buffer::OwnedImpl data(chunk);
+      request_encoder.encodeData(data, i + 1 == chunks);
+    }
+    response_encoder_->encodeHeaders(response_headers, true);
+    client_connection_.dispatcher_.to_delete_.clear();
+    server_connection_.dispatcher_.to_delete_.clear();
+  }
+
+  // The number of writes made by both codecs to their connections.
+  uint64_t writes() const { return writes_; }
+
+private:
+  // Defers data written to a codec while it is dispatching until the dispatch is done.
+  struct ConnectionWrapper {
+    void dispatch(Buffer::Instance& data, ConnectionImpl& connection) {
+      buffer_.move(data);
+      if (!dispatching_) {
+        dispatching_ = true;
+        while (buffer_.length() > 0) {
+          RELEASE_ASSERT(connection.dispatch(buffer_).ok(), "");
+        }
+        dispatching_ = false;
+      }
+    }
+
+    bool dispatching_{};
+    Buffer::OwnedImpl buffer_;
+  };
+
+  Stats::IsolatedStoreImpl stats_store_;
+  const envoy::config::core::v3::Http2ProtocolOptions http2_options_;
+  NiceMock<Network::MockConnection> client_connection_;
+  NiceMock<MockConnectionCallbacks> client_callbacks_;
+  NiceMock<Network::MockConnection> server_connection_;
+  NiceMock<MockServerConnectionCallbacks> server_callbacks_;
+  TestClientConnectionImpl client_;
+  TestServerConnectionImpl server_;
+  ConnectionWrapper client_wrapper_;
+  ConnectionWrapper server_wrapper_;
+  NiceMock<MockResponseDecoder> response_decoder_;
+  NiceMock<MockRequestDecoder> request_decoder_;
+  ResponseEncoder* response_encoder_{};
+  uint64_t writes_{};
+};
+
+} // namespace Http2
+} // namespace Http
+} // namespace Envoy
+
+// Encode and decode the headers of gRPC calls with the given number of metadata headers. After the
+// first call all names and most values are in the HPACK dynamic tables.
+static void http2CodecGrpcHeaders(benchmark::State& state) {
+  Envoy::Http::TestRequestHeaderMapImpl request_headers{{":method", "POST"},
+                                                        {":scheme", "http"},
+                                                        {":authority", "service.example.com"},
+                                                        {":path", "/package.Service/Method"},
+                                                        {"content-type", "application/grpc"},
+                                                        {"te", "trailers"},
+                                                        {"grpc-timeout", "1000m"},
+                                                        {"user-agent", "grpc-c++/1.29.0"}};
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    request_headers.addCopy(absl::StrCat("x-metadata-", i), absl::StrCat("value-", i));
+  }
+  const Envoy::Http::TestResponseHeaderMapImpl response_headers{
+      {":status", "200"}, {"content-type", "application/grpc"}, {"grpc-status", "0"}};
+
+  Envoy::Http::Http2::Http2CodecSpeedTest speed_test;
+  const uint64_t writes = speed_test.writes();
+  for (auto _ : state) {
+    speed_test.exchangeHeaders(request_headers, response_headers);
+  }
+  state.counters["writes_per_stream"] =
+      benchmark::Counter(speed_test.writes() - writes, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(http2CodecGrpcHeaders)->Arg(0)->Arg(10)->Arg(50);
+
+// Send request bodies in chunks of the given size, with received DATA payloads moved out of the
+// dispatched buffer (1) or copied (0). Chunks larger than the 16 KiB frames split the slices
+// received by the server.
+static void http2CodecRequestBody(benchmark::State& state) {
+  Envoy::TestScopedRuntime scoped_runtime;
+  Envoy::Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.http2_dispatch_without_copy",
+        state.range(0) != 0 ? "true" : "false"}});
+  const Envoy::Http::TestRequestHeaderMapImpl request_headers{{":method", "POST"},
+                                                              {":scheme", "http"},
+                                                              {":authority", "example.com"},
+                                                              {":path", "/upload"}};
+  const Envoy::Http::TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  const std::string chunk(state.range(1), 'a');
+  constexpr uint64_t Chunks = 16;
+
+  Envoy::Http::Http2::Http2CodecSpeedTest speed_test;
+  for (auto _ : state) {
+    speed_test.exchangeBody(request_headers, chunk, Chunks, response_headers);
+  }
+  state.SetBytesProcessed(state.iterations() * Chunks * chunk.size());
+}
+BENCHMARK(http2CodecRequestBody)
+    ->Args({0, 4096})
+    ->Args({1, 4096})
+    ->Args({0, 65536})
+    ->Args({1, 65536})
+    ->Args({0, 262144})
+    ->Args({1, 262144});
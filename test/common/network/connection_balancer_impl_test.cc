@@ -0,0 +1,170 @@
+#include "common/network/connection_balancer_impl.h"
+
+#include "test/mocks/runtime/mocks.h"
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "absl/synchronization/notification.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class TestBalancedConnectionHandler : public BalancedConnectionHandler {
+public:
+  TestBalancedConnectionHandler(uint64_t num_connections) : num_connections_(num_connections) {}
+
+  // Network::BalancedConnectionHandler
+  uint64_t numConnections() const override { return num_connections_; }
+  void incNumConnections() override { ++num_connections_; }
+  void post(Network::ConnectionSocketPtr&&) override {}
+  void setBalancerIndex(uint32_t index) override { balancer_index_ = index; }
+  uint32_t balancerIndex() const override { return balancer_index_; }
+
+  uint64_t num_connections_;
+  uint32_t balancer_index_{};
+};
+
+TEST(ExactConnectionBalancerImplTest, PicksLeastLoaded) {
+  ExactConnectionBalancerImpl balancer;
+  TestBalancedConnectionHandler handler1(3);
+  TestBalancedConnectionHandler handler2(1);
+  balancer.registerHandler(handler1);
+  balancer.registerHandler(handler2);
+
+  EXPECT_EQ(&handler2, &balancer.pickTargetHandler(handler1));
+  EXPECT_EQ(2UL, handler2.num_connections_);
+  EXPECT_EQ(&handler2, &balancer.pickTargetHandler(handler1));
+  EXPECT_EQ(3UL, handler2.num_connections_);
+
+  balancer.unregisterHandler(handler2);
+  EXPECT_EQ(&handler1, &balancer.pickTargetHandler(handler1));
+  EXPECT_EQ(4UL, handler1.num_connections_);
+}
+
+TEST(TwoChoiceConnectionBalancerImplTest, SingleHandler) {
+  NiceMock<Runtime::MockRandomGenerator> random;
+  TwoChoiceConnectionBalancerImpl balancer(random, 3);
+  TestBalancedConnectionHandler handler(5);
+  balancer.registerHandler(handler);
+
+  EXPECT_CALL(random, random()).Times(0);
+  EXPECT_EQ(&handler, &balancer.pickTargetHandler(handler));
+  EXPECT_EQ(6UL, handler.num_connections_);
+}
+
+TEST(TwoChoiceConnectionBalancerImplTest, MovesToLessLoadedHandler) {
+  NiceMock<Runtime::MockRandomGenerator> random;
+  TwoChoiceConnectionBalancerImpl balancer(random, 3);
+  TestBalancedConnectionHandler handler1(4);
+  TestBalancedConnectionHandler handler2(2);
+  TestBalancedConnectionHandler handler3(7);
+  balancer.registerHandler(handler1);
+  balancer.registerHandler(handler2);
+  balancer.registerHandler(handler3);
+
+  // The randomly sampled handler has fewer connections, so the connection moves.
+  EXPECT_CALL(random, random()).WillOnce(Return(1));
+  EXPECT_EQ(&handler2, &balancer.pickTargetHandler(handler1));
+  EXPECT_EQ(3UL, handler2.num_connections_);
+  EXPECT_EQ(4UL, handler1.num_connections_);
+
+  // The randomly sampled handler has more connections, so the connection stays.
+  EXPECT_CALL(random, random()).WillOnce(Return(5));
+  EXPECT_EQ(&handler1, &balancer.pickTargetHandler(handler1));
+  EXPECT_EQ(5UL, handler1.num_connections_);
+  EXPECT_EQ(7UL, handler3.num_connections_);
+
+  // Ties keep the connection on the current handler.
+  EXPECT_CALL(random, random()).WillOnce(Return(0));
+  EXPECT_EQ(&handler1, &balancer.pickTargetHandler(handler1));
+  EXPECT_EQ(6UL, handler1.num_connections_);
+}
+
+TEST(TwoChoiceConnectionBalancerImplTest, UnregisterHandler) {
+  NiceMock<Runtime::MockRandomGenerator> random;
+  TwoChoiceConnectionBalancerImpl balancer(random, 3);
+  TestBalancedConnectionHandler handler1(4);
+  TestBalancedConnectionHandler handler2(0);
+  balancer.registerHandler(handler1);
+  balancer.registerHandler(handler2);
+  balancer.unregisterHandler(handler2);
+
+  EXPECT_CALL(random, random()).Times(0);
+  EXPECT_EQ(&handler1, &balancer.pickTargetHandler(handler1));
+  EXPECT_EQ(5UL, handler1.num_connections_);
+}
+
+TEST(TwoChoiceConnectionBalancerImplTest, UnregisterWithoutHandlers) {
+  NiceMock<Runtime::MockRandomGenerator> random;
+  TwoChoiceConnectionBalancerImpl balancer(random, 1);
+  TestBalancedConnectionHandler handler(0);
+  balancer.unregisterHandler(handler);
+}
+
+// Each handler gets an index of its own, and the index of an unregistered handler is reused.
+TEST(TwoChoiceConnectionBalancerImplTest, ReusesIndexOfUnregisteredHandler) {
+  NiceMock<Runtime::MockRandomGenerator> random;
+  TwoChoiceConnectionBalancerImpl balancer(random, 2);
+  TestBalancedConnectionHandler handler1(4);
+  TestBalancedConnectionHandler handler2(2);
+  TestBalancedConnectionHandler handler3(1);
+  balancer.registerHandler(handler1);
+  balancer.registerHandler(handler2);
+  EXPECT_EQ(0U, handler1.balancer_index_);
+  EXPECT_EQ(1U, handler2.balancer_index_);
+
+  balancer.unregisterHandler(handler1);
+  balancer.registerHandler(handler3);
+  EXPECT_EQ(0U, handler3.balancer_index_);
+
+  EXPECT_CALL(random, random()).WillOnce(Return(1));
+  EXPECT_EQ(&handler3, &balancer.pickTargetHandler(handler2));
+  EXPECT_EQ(2UL, handler3.num_connections_);
+  EXPECT_EQ(4UL, handler1.num_connections_);
+}
+
+// Unregistering a handler waits for the picks which may still see it to complete.
+TEST(TwoChoiceConnectionBalancerImplTest, UnregisterWaitsForPick) {
+  NiceMock<Runtime::MockRandomGenerator> random;
+  TwoChoiceConnectionBalancerImpl balancer(random, 3);
+  TestBalancedConnectionHandler handler1(4);
+  TestBalancedConnectionHandler handler2(0);
+  TestBalancedConnectionHandler handler3(0);
+  balancer.registerHandler(handler1);
+  balancer.registerHandler(handler2);
+  balancer.registerHandler(handler3);
+
+  absl::Notification picking;
+  absl::Notification resume_pick;
+  EXPECT_CALL(random, random()).WillOnce(Invoke([&]() -> uint64_t {
+    picking.Notify();
+    resume_pick.WaitForNotification();
+    return 1;
+  }));
+  Thread::ThreadPtr pick_thread = Thread::threadFactoryForTest().createThread(
+      [&]() { EXPECT_EQ(&handler2, &balancer.pickTargetHandler(handler1)); });
+  picking.WaitForNotification();
+
+  absl::Notification unregistered;
+  Thread::ThreadPtr unregister_thread = Thread::threadFactoryForTest().createThread([&]() {
+    balancer.unregisterHandler(handler2);
+    unregistered.Notify();
+  });
+  EXPECT_FALSE(unregistered.WaitForNotificationWithTimeout(absl::Milliseconds(100)));
+
+  resume_pick.Notify();
+  pick_thread->join();
+  unregister_thread->join();
+  EXPECT_TRUE(unregistered.HasBeenNotified());
+  EXPECT_EQ(1UL, handler2.num_connections_);
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,73 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <array>
+#include <atomic>
+
+#include "common/common/macros.h"
+#include "common/network/connection_balancer_impl.h"
+#include "common/runtime/runtime_impl.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+constexpr uint32_t NumWorkers = 32;
+
+class TestBalancedConnectionHandler : public BalancedConnectionHandler {
+public:
+  // Network::BalancedConnectionHandler
+  uint64_t numConnections() const override { return num_connections_; }
+  void incNumConnections() override { ++num_connections_; }
+  void post(Network::ConnectionSocketPtr&&) override {}
+  void setBalancerIndex(uint32_t index) override { balancer_index_ = index; }
+  uint32_t balancerIndex() const override { return balancer_index_; }
+
+  std::atomic<uint64_t> num_connections_{};
+  uint32_t balancer_index_{};
+};
+
+struct AcceptStormContext {
+  AcceptStormContext() : two_choice_balancer_(random_, NumWorkers) {
+    for (auto& handler : handlers_) {
+      exact_balancer_.registerHandler(handler);
+      two_choice_balancer_.registerHandler(handler);
+    }
+  }
+
+  Runtime::RandomGeneratorImpl random_;
+  std::array<TestBalancedConnectionHandler, NumWorkers> handlers_;
+  ExactConnectionBalancerImpl exact_balancer_;
+  TwoChoiceConnectionBalancerImpl two_choice_balancer_;
+};
+
+AcceptStormContext& context() { MUTABLE_CONSTRUCT_ON_FIRST_USE(AcceptStormContext); }
+
+// Every benchmark thread plays the part of a worker accepting short lived connections on the same
+// listener, so this measures how the balancer's accept path scales with contention.
+void acceptStorm(benchmark::State& state, ConnectionBalancer& balancer) {
+  TestBalancedConnectionHandler& current_handler = context().handlers_[state.thread_index];
+  for (auto _ : state) {
+    auto& target_handler =
+        static_cast<TestBalancedConnectionHandler&>(balancer.pickTargetHandler(current_handler));
+    // Close the connection right away.
+    --target_handler.num_connections_;
+  }
+}
+
+} // namespace
+
+static void ExactBalancerAcceptStorm(benchmark::State& state) {
+  acceptStorm(state, context().exact_balancer_);
+}
+BENCHMARK(ExactBalancerAcceptStorm)->Threads(NumWorkers);
+
+static void TwoChoiceBalancerAcceptStorm(benchmark::State& state) {
+  acceptStorm(state, context().two_choice_balancer_);
+}
+BENCHMARK(TwoChoiceBalancerAcceptStorm)->Threads(NumWorkers);
+
+} // namespace Network
+} // namespace Envoy
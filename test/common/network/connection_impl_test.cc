@@ -1177,6 +1177,29 @@ TEST_P(ConnectionImplTest, ReadOnCloseTest) {
   dispatcher_->run(Event::Dispatcher::RunType::Block);
 }
 
+// Data buffered by a connection is charged to its dispatcher's memory tracker, and resetting the
+// connection's account closes the connection.
+TEST_P(ConnectionImplTest, ResetHighMemoryConnection) {
+  setUpBasicConnection();
+  connect();
+
+  Buffer::OwnedImpl data(std::string(32, 'a'));
+  client_connection_->write(data, false);
+  Buffer::BufferMemoryTracker& tracker = dispatcher_->bufferMemoryTracker();
+  EXPECT_EQ(32, tracker.balance());
+  EXPECT_EQ(std::vector<uint64_t>{32}, tracker.largestBalances(2));
+
+  EXPECT_CALL(client_callbacks_, onEvent(ConnectionEvent::LocalClose));
+  EXPECT_EQ(1, tracker.resetLargestAccounts(1));
+  EXPECT_EQ(Connection::State::Closed, client_connection_->state());
+  EXPECT_EQ(0, tracker.balance());
+
+  EXPECT_CALL(server_callbacks_, onEvent(ConnectionEvent::RemoteClose))
+      .WillOnce(Invoke([&](Network::ConnectionEvent) -> void { dispatcher_->exit(); }));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(0, tracker.balance());
+}
+
 // EmptyReadOnCloseTest verifies that the read filter's onData function is not invoked on empty
 // read events due to connection closure.
 TEST_P(ConnectionImplTest, EmptyReadOnCloseTest) {
@@ -325,6 +325,21 @@ TEST_F(LcTrieTest, ExclusiveNestedPrefixesWithCatchAll) {
   expectIPAndTags(test_case);
 }
 
+TEST_F(LcTrieTest, GetFirstData) {
+  std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"0.0.0.0/0"},       // tag_0
+      {"203.0.113.0/24"},  // tag_1
+      {"203.0.113.128/25"} // tag_2
+  };
+  setup(cidr_range_strings, true);
+
+  EXPECT_EQ("tag_0", *trie_->getFirstData(Utility::parseInternetAddress("198.51.100.1")));
+  EXPECT_EQ("tag_1", *trie_->getFirstData(Utility::parseInternetAddress("203.0.113.1")));
+  EXPECT_EQ("tag_2", *trie_->getFirstData(Utility::parseInternetAddress("203.0.113.192")));
+  // There is no IPv6 data.
+  EXPECT_EQ(nullptr, trie_->getFirstData(Utility::parseInternetAddress("2001:db8::1")));
+}
+
 // Ensure the trie will reject inputs that would cause it to exceed the maximum 2^20 nodes
 // when using the default fill factor.
 TEST_F(LcTrieTest, MaximumEntriesExceptionDefault) {
@@ -0,0 +1,167 @@
+#include "common/buffer/buffer_impl.h"
+#include "common/network/io_socket_error_impl.h"
+#include "common/network/raw_buffer_socket.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/network/io_handle.h"
+#include "test/mocks/network/mocks.h"
+#include "test/test_common/test_runtime.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::ByMove;
+using testing::InSequence;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class RawBufferSocketTest : public testing::Test {
+public:
+  RawBufferSocketTest() {
+    ON_CALL(callbacks_, ioHandle()).WillByDefault(ReturnRef(io_handle_));
+    ON_CALL(callbacks_, connection()).WillByDefault(ReturnRef(callbacks_.connection_));
+  }
+
+  void initialize() {
+    socket_ = std::make_unique<RawBufferSocket>();
+    socket_->setTransportSocketCallbacks(callbacks_);
+  }
+
+  static Api::IoCallUint64Result ioResult(uint64_t rc) {
+    return Api::IoCallUint64Result(rc, Api::IoErrorPtr(nullptr, [](Api::IoError*) {}));
+  }
+
+  static Api::IoCallUint64Result eagainResult() {
+    return Api::IoCallUint64Result(0, Api::IoErrorPtr(IoSocketError::getIoSocketEagainInstance(),
+                                                      IoSocketError::deleteIoError));
+  }
+
+  TestScopedRuntime scoped_runtime_;
+  NiceMock<MockIoHandle> io_handle_;
+  NiceMock<MockTransportSocketCallbacks> callbacks_;
+  std::unique_ptr<RawBufferSocket> socket_;
+};
+
+// Reads grow while they fill the space they were given. The short read ending a busy read event
+// doesn't shrink them again.
+TEST_F(RawBufferSocketTest, ReadSizeGrowsWhileReadsFill) {
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.raw_buffer_adaptive_read_size", "true"}});
+  initialize();
+  Buffer::OwnedImpl buffer;
+
+  InSequence s;
+  EXPECT_CALL(io_handle_, readv(16384, _, _)).WillOnce(Return(ByMove(ioResult(16384))));
+  EXPECT_CALL(io_handle_, readv(32768, _, _)).WillOnce(Return(ByMove(ioResult(32768))));
+  EXPECT_CALL(io_handle_, readv(65536, _, _)).WillOnce(Return(ByMove(ioResult(100))));
+  EXPECT_CALL(io_handle_, readv(65536, _, _)).WillOnce(Return(ByMove(eagainResult())));
+  IoResult result = socket_->doRead(buffer);
+  EXPECT_EQ(PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(16384UL + 32768UL + 100UL, result.bytes_processed_);
+  EXPECT_EQ(16384UL + 32768UL + 100UL, buffer.length());
+
+  // Steady load, where each read event ends with a short read.
+  for (int i = 0; i < 3; i++) {
+    EXPECT_CALL(io_handle_, readv(65536, _, _)).WillOnce(Return(ByMove(ioResult(60000))));
+    EXPECT_CALL(io_handle_, readv(65536, _, _)).WillOnce(Return(ByMove(eagainResult())));
+    socket_->doRead(buffer);
+  }
+}
+
+// Read events bringing little data halve the read size, down to the minimum.
+TEST_F(RawBufferSocketTest, ReadSizeShrinksToMinimum) {
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.raw_buffer_adaptive_read_size", "true"}});
+  initialize();
+  Buffer::OwnedImpl buffer;
+
+  InSequence s;
+  for (const uint64_t read_size : {16384, 8192, 4096, 4096}) {
+    EXPECT_CALL(io_handle_, readv(read_size, _, _)).WillOnce(Return(ByMove(ioResult(10))));
+    EXPECT_CALL(io_handle_, readv(read_size, _, _)).WillOnce(Return(ByMove(eagainResult())));
+    IoResult result = socket_->doRead(buffer);
+    EXPECT_EQ(PostIoAction::KeepOpen, result.action_);
+    EXPECT_EQ(10UL, result.bytes_processed_);
+  }
+}
+
+// A grown read size doesn't read past the buffer limit by more than a default sized read, and reads
+// cut short by the limit don't grow the read size.
+TEST_F(RawBufferSocketTest, ReadSizeBoundedByBufferLimit) {
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.raw_buffer_adaptive_read_size", "true"}});
+  initialize();
+  Buffer::OwnedImpl buffer;
+  ON_CALL(callbacks_.connection_, bufferLimit()).WillByDefault(Return(32768));
+
+  InSequence s;
+  EXPECT_CALL(io_handle_, readv(16384, _, _)).WillOnce(Return(ByMove(ioResult(16384))));
+  EXPECT_CALL(callbacks_, shouldDrainReadBuffer()).WillOnce(Return(false));
+  EXPECT_CALL(io_handle_, readv(16384, _, _)).WillOnce(Return(ByMove(ioResult(16384))));
+  EXPECT_CALL(callbacks_, shouldDrainReadBuffer()).WillOnce(Return(true));
+  EXPECT_CALL(callbacks_, setReadBufferReady());
+  IoResult result = socket_->doRead(buffer);
+  EXPECT_EQ(32768UL, result.bytes_processed_);
+
+  // Once the buffer has been drained the grown read size can be used in full. The second read was
+  // capped at 16384 bytes, so the read size only grew once.
+  buffer.drain(buffer.length());
+  ON_CALL(callbacks_.connection_, bufferLimit()).WillByDefault(Return(0));
+  EXPECT_CALL(io_handle_, readv(32768, _, _)).WillOnce(Return(ByMove(eagainResult())));
+  socket_->doRead(buffer);
+}
+
+// Reads are always of the default size unless the adaptive read size is enabled.
+TEST_F(RawBufferSocketTest, AdaptiveReadSizeDisabledByDefault) {
+  initialize();
+  Buffer::OwnedImpl buffer;
+
+  EXPECT_CALL(io_handle_, readv(16384, _, _))
+      .WillOnce(Return(ByMove(ioResult(16384))))
+      .WillOnce(Return(ByMove(ioResult(10))))
+      .WillOnce(Return(ByMove(eagainResult())));
+  IoResult result = socket_->doRead(buffer);
+  EXPECT_EQ(16394UL, result.bytes_processed_);
+}
+
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+// Data sent without copying stays in the write buffer until the kernel releases it, which doesn't
+// hold back the FIN.
+TEST_F(RawBufferSocketTest, ZeroCopySendKeepsDataInFlight) {
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.raw_buffer_zero_copy_send", "true"}});
+  NiceMock<Api::MockOsSysCalls> os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  ON_CALL(io_handle_, fd()).WillByDefault(Return(5));
+  initialize();
+  Buffer::OwnedImpl buffer;
+  buffer.appendSliceForTest(std::string(20000, 'a'));
+
+  EXPECT_CALL(os_sys_calls, sendmsg(5, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{20000, 0}));
+  EXPECT_CALL(os_sys_calls, shutdown(5, ENVOY_SHUT_WR));
+  IoResult result = socket_->doWrite(buffer, true);
+  EXPECT_EQ(PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(20000UL, result.bytes_processed_);
+  EXPECT_EQ(20000UL, buffer.length());
+
+  // Without a completion the data stays in flight, and there's nothing else to send.
+  EXPECT_CALL(os_sys_calls, recvmsg(5, _, MSG_ERRQUEUE))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EAGAIN}));
+  EXPECT_CALL(os_sys_calls, sendmsg(_, _, _)).Times(0);
+  result = socket_->doWrite(buffer, true);
+  EXPECT_EQ(0UL, result.bytes_processed_);
+  EXPECT_EQ(20000UL, buffer.length());
+}
+#endif
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
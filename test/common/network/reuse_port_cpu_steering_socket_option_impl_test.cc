@@ -0,0 +1,82 @@
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
+#include "envoy/config/core/v3/base.pb.h"
+
+#include "common/network/reuse_port_cpu_steering_socket_option_impl.h"
+
+#include "test/common/network/socket_option_test.h"
+
+using testing::Return;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class ReusePortCpuSteeringSocketOptionImplTest : public SocketOptionTest {};
+
+// The program is only attached once the socket is bound and has joined the SO_REUSEPORT group.
+TEST_F(ReusePortCpuSteeringSocketOptionImplTest, NoOpBeforeBind) {
+  ReusePortCpuSteeringSocketOptionImpl socket_option{4};
+  EXPECT_CALL(socket_, setSocketOption(_, _, _, _)).Times(0);
+  EXPECT_TRUE(
+      socket_option.setOption(socket_, envoy::config::core::v3::SocketOption::STATE_PREBIND));
+  EXPECT_TRUE(
+      socket_option.setOption(socket_, envoy::config::core::v3::SocketOption::STATE_LISTENING));
+  EXPECT_FALSE(socket_option
+                   .getOptionDetails(socket_, envoy::config::core::v3::SocketOption::STATE_PREBIND)
+                   .has_value());
+}
+
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+// The attached program returns (cpu % socket_count).
+TEST_F(ReusePortCpuSteeringSocketOptionImplTest, SetOptionSuccess) {
+  ReusePortCpuSteeringSocketOptionImpl socket_option{4};
+  EXPECT_TRUE(ReusePortCpuSteeringSocketOptionImpl::isSupported());
+  EXPECT_CALL(socket_, setSocketOption(ENVOY_ATTACH_REUSEPORT_CBPF.level(),
+                                       ENVOY_ATTACH_REUSEPORT_CBPF.option(), _, sizeof(sock_fprog)))
+      .WillOnce(Invoke([](int, int, const void* optval, socklen_t) -> Api::SysCallIntResult {
+        const auto* prog = static_cast<const sock_fprog*>(optval);
+        EXPECT_EQ(3, prog->len);
+        EXPECT_EQ(BPF_LD | BPF_W | BPF_ABS, prog->filter[0].code);
+        EXPECT_EQ(static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU), prog->filter[0].k);
+        EXPECT_EQ(BPF_ALU | BPF_MOD | BPF_K, prog->filter[1].code);
+        EXPECT_EQ(4U, prog->filter[1].k);
+        EXPECT_EQ(BPF_RET | BPF_A, prog->filter[2].code);
+        return {0, 0};
+      }));
+  EXPECT_TRUE(socket_option.setOption(socket_, envoy::config::core::v3::SocketOption::STATE_BOUND));
+
+  auto details =
+      socket_option.getOptionDetails(socket_, envoy::config::core::v3::SocketOption::STATE_BOUND);
+  ASSERT_TRUE(details.has_value());
+  EXPECT_EQ(ENVOY_ATTACH_REUSEPORT_CBPF, details->name_);
+  EXPECT_EQ("4", details->value_);
+}
+
+// We fail to set the option when the underlying setsockopt syscall fails.
+TEST_F(ReusePortCpuSteeringSocketOptionImplTest, SetOptionFailure) {
+  ReusePortCpuSteeringSocketOptionImpl socket_option{4};
+  EXPECT_CALL(socket_, setSocketOption(ENVOY_ATTACH_REUSEPORT_CBPF.level(),
+                                       ENVOY_ATTACH_REUSEPORT_CBPF.option(), _, sizeof(sock_fprog)))
+      .WillOnce(Return(Api::SysCallIntResult{-1, EINVAL}));
+  EXPECT_LOG_CONTAINS(
+      "warning", "Attaching reuse port CPU steering program on socket failed",
+      EXPECT_FALSE(
+          socket_option.setOption(socket_, envoy::config::core::v3::SocketOption::STATE_BOUND)));
+}
+#else
+TEST_F(ReusePortCpuSteeringSocketOptionImplTest, SetOptionUnsupported) {
+  ReusePortCpuSteeringSocketOptionImpl socket_option{4};
+  EXPECT_FALSE(ReusePortCpuSteeringSocketOptionImpl::isSupported());
+  EXPECT_LOG_CONTAINS(
+      "warning", "Failed to set unsupported reuse port CPU steering option on socket",
+      EXPECT_FALSE(
+          socket_option.setOption(socket_, envoy::config::core::v3::SocketOption::STATE_BOUND)));
+}
+#endif
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,159 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "envoy/config/core/v3/base.pb.h"
+
+#include "common/common/assert.h"
+#include "common/network/address_impl.h"
+#include "common/network/listen_socket_impl.h"
+#include "common/network/reuse_port_cpu_steering_socket_option_impl.h"
+#include "common/network/socket_option_factory.h"
+#include "common/network/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+#if defined(__linux__)
+// The per worker sockets of one SO_REUSEPORT group, created in worker order.
+class ReusePortGroup {
+public:
+  ReusePortGroup(uint32_t num_sockets, bool steering) {
+    auto options = std::make_shared<Socket::Options>();
+    Socket::appendOptions(options, SocketOptionFactory::buildReusePortOptions());
+    if (steering) {
+      Socket::appendOptions(options,
+                            SocketOptionFactory::buildReusePortCpuSteeringOptions(num_sockets));
+    }
+    Address::InstanceConstSharedPtr address = Utility::parseInternetAddress("127.0.0.1", 0);
+    for (uint32_t i = 0; i < num_sockets; i++) {
+      sockets_.push_back(std::make_unique<TcpListenSocket>(address, options, true));
+      RELEASE_ASSERT(Socket::applyOptions(options, *sockets_.back(),
+                                          envoy::config::core::v3::SocketOption::STATE_BOUND),
+                     "");
+      RELEASE_ASSERT(::listen(sockets_.back()->ioHandle().fd(), 128) == 0, "");
+      // Accepting polls every socket of the group.
+      RELEASE_ASSERT(sockets_.back()->setBlockingForTest(false).rc_ == 0, "");
+      // The following sockets must join the group on the port picked for the first one.
+      address = sockets_.back()->localAddress();
+    }
+    address_ = address;
+  }
+
+  // Connects to the group and accepts the connection on whichever socket it landed on.
+  // @return the index of the socket that accepted the connection.
+  uint32_t connectAndAccept() {
+    const int client = ::socket(AF_INET, SOCK_STREAM, 0);
+    RELEASE_ASSERT(client >= 0, "");
+    RELEASE_ASSERT(::connect(client, address_->sockAddr(), address_->sockAddrLen()) == 0, "");
+    // Reset rather than close the connection so that the client ports are not used up by
+    // connections in TIME_WAIT.
+    const linger reset{1, 0};
+    RELEASE_ASSERT(::setsockopt(client, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset)) == 0, "");
+    for (;;) {
+      for (uint32_t i = 0; i < sockets_.size(); i++) {
+        const int accepted = ::accept4(sockets_[i]->ioHandle().fd(), nullptr, nullptr, 0);
+        if (accepted >= 0) {
+          ::close(accepted);
+          ::close(client);
+          return i;
+        }
+      }
+    }
+  }
+
+private:
+  std::vector<std::unique_ptr<TcpListenSocket>> sockets_;
+  Address::InstanceConstSharedPtr address_;
+};
+
+// @return the CPUs the benchmark may run on.
+std::vector<uint32_t> allowedCpus() {
+  cpu_set_t cpu_set;
+  RELEASE_ASSERT(sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0, "");
+  std::vector<uint32_t> cpus;
+  for (uint32_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &cpu_set)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+void pinToCpu(uint32_t cpu) {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+  RELEASE_ASSERT(sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0, "");
+}
+
+void restoreAffinity(const std::vector<uint32_t>& cpus) {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const uint32_t cpu : cpus) {
+    CPU_SET(cpu, &cpu_set);
+  }
+  RELEASE_ASSERT(sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0, "");
+}
+#endif
+
+} // namespace
+
+// Connects from every CPU in turn and measures the time between connect() and accept(). The
+// counters report how evenly the connections spread over the sockets (max / mean connections per
+// socket) and the fraction accepted on the socket matching the CPU the connection came from, which
+// should be 1 with steering.
+static void reusePortAccept(benchmark::State& state) {
+#if defined(__linux__)
+  const bool steering = state.range(0) != 0;
+  const std::vector<uint32_t> cpus = allowedCpus();
+  const uint32_t num_sockets = cpus.size();
+  if (num_sockets < 2) {
+    state.SkipWithError("needs at least 2 CPUs");
+    return;
+  }
+  if (steering && !ReusePortCpuSteeringSocketOptionImpl::isSupported()) {
+    state.SkipWithError("CPU steering is not supported");
+    return;
+  }
+  ReusePortGroup group(num_sockets, steering);
+  std::vector<uint64_t> accepted(num_sockets);
+  uint64_t matched = 0;
+  uint64_t connections = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    const uint32_t cpu = cpus[connections % num_sockets];
+    pinToCpu(cpu);
+    state.ResumeTiming();
+    const auto start = std::chrono::steady_clock::now();
+    const uint32_t index = group.connectAndAccept();
+    state.SetIterationTime(
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    accepted[index]++;
+    matched += index == cpu % num_sockets;
+    connections++;
+  }
+  restoreAffinity(cpus);
+  const double mean = static_cast<double>(connections) / num_sockets;
+  state.counters["imbalance"] = *std::max_element(accepted.begin(), accepted.end()) / mean;
+  state.counters["steered"] = static_cast<double>(matched) / connections;
+#else
+  state.SkipWithError("SO_REUSEPORT steering is only supported on Linux");
+#endif
+}
+BENCHMARK(reusePortAccept)->Arg(0)->Arg(1)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+} // namespace Network
+} // namespace Envoy
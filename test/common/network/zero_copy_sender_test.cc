@@ -0,0 +1,208 @@
+#include <string>
+
+#include "envoy/common/platform.h"
+
+#include "common/buffer/buffer_impl.h"
+#include "common/network/zero_copy_sender.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/network/io_handle.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+#include <linux/errqueue.h>
+
+using testing::_;
+using testing::ByMove;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+constexpr os_fd_t Fd = 5;
+
+class ZeroCopySenderTest : public testing::Test {
+public:
+  ZeroCopySenderTest() { ON_CALL(io_handle_, fd()).WillByDefault(Return(Fd)); }
+
+  static Api::IoCallUint64Result ioResult(uint64_t rc) {
+    return Api::IoCallUint64Result(rc, Api::IoErrorPtr(nullptr, [](Api::IoError*) {}));
+  }
+
+  // Queues the completion of the zero copy sends numbered first_id to last_id.
+  void expectCompletion(uint32_t first_id, uint32_t last_id, bool copied = false) {
+    EXPECT_CALL(os_sys_calls_, recvmsg(Fd, _, MSG_ERRQUEUE))
+        .WillOnce(Invoke([=](os_fd_t, msghdr* message, int) {
+          cmsghdr* cmsg = CMSG_FIRSTHDR(message);
+          cmsg->cmsg_level = SOL_IP;
+          cmsg->cmsg_type = IP_RECVERR;
+          cmsg->cmsg_len = CMSG_LEN(sizeof(sock_extended_err));
+          sock_extended_err error{};
+          error.ee_origin = SO_EE_ORIGIN_ZEROCOPY;
+          error.ee_info = first_id;
+          error.ee_data = last_id;
+          error.ee_code = copied ? SO_EE_CODE_ZEROCOPY_COPIED : 0;
+          memcpy(CMSG_DATA(cmsg), &error, sizeof(error));
+          message->msg_controllen = CMSG_SPACE(sizeof(sock_extended_err));
+          return Api::SysCallSizeResult{0, 0};
+        }));
+  }
+
+  NiceMock<Api::MockOsSysCalls> os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_{&os_sys_calls_};
+  NiceMock<MockIoHandle> io_handle_;
+  ZeroCopySender sender_{16384};
+  Buffer::OwnedImpl buffer_;
+};
+
+// Large slices stay in the buffer until the kernel releases them.
+TEST_F(ZeroCopySenderTest, LargeSlicesReleasedOnCompletion) {
+  buffer_.appendSliceForTest(std::string(20000, 'a'));
+  buffer_.appendSliceForTest(std::string(30000, 'b'));
+  const uint64_t total_bytes = ZeroCopySender::totalBytes();
+
+  EXPECT_CALL(os_sys_calls_, setsockopt_(Fd, SOL_SOCKET, SO_ZEROCOPY, _, _)).WillOnce(Return(0));
+  EXPECT_CALL(os_sys_calls_, sendmsg(Fd, _, MSG_ZEROCOPY))
+      .WillOnce(Invoke([](os_fd_t, const msghdr* message, int) {
+        EXPECT_EQ(2U, message->msg_iovlen);
+        return Api::SysCallSizeResult{50000, 0};
+      }));
+  EXPECT_CALL(io_handle_, writev(_, _)).Times(0);
+  EXPECT_EQ(50000U, sender_.write(io_handle_, buffer_).rc_);
+  EXPECT_EQ(50000U, buffer_.length());
+  EXPECT_EQ(50000U, sender_.bytesInFlight());
+  EXPECT_EQ(total_bytes + 50000U, ZeroCopySender::totalBytes());
+
+  // Nothing left to send.
+  EXPECT_EQ(0U, sender_.write(io_handle_, buffer_).rc_);
+
+  expectCompletion(0, 0);
+  sender_.releaseCompleted(io_handle_, buffer_);
+  EXPECT_EQ(0U, buffer_.length());
+  EXPECT_EQ(0U, sender_.bytesInFlight());
+}
+
+// A partial send continues from where the kernel stopped, and completions coalesced into one range
+// release every send in it.
+TEST_F(ZeroCopySenderTest, PartialSendsAndCoalescedCompletions) {
+  buffer_.appendSliceForTest(std::string(20000, 'a'));
+  const void* data = buffer_.getRawSlices()[0].mem_;
+
+  EXPECT_CALL(os_sys_calls_, sendmsg(Fd, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{2000, 0}))
+      .WillOnce(Invoke([data](os_fd_t, const msghdr* message, int) {
+        EXPECT_EQ(1U, message->msg_iovlen);
+        EXPECT_EQ(static_cast<const uint8_t*>(data) + 2000, message->msg_iov[0].iov_base);
+        EXPECT_EQ(18000U, message->msg_iov[0].iov_len);
+        return Api::SysCallSizeResult{18000, 0};
+      }));
+  EXPECT_EQ(2000U, sender_.write(io_handle_, buffer_).rc_);
+  EXPECT_EQ(18000U, sender_.write(io_handle_, buffer_).rc_);
+  EXPECT_EQ(20000U, sender_.bytesInFlight());
+
+  expectCompletion(0, 1);
+  sender_.releaseCompleted(io_handle_, buffer_);
+  EXPECT_EQ(0U, buffer_.length());
+}
+
+// Small slices are copied, but stay in the buffer while data ahead of them is in flight.
+TEST_F(ZeroCopySenderTest, SmallSlicesCopiedInOrder) {
+  buffer_.appendSliceForTest(std::string(20000, 'a'));
+  buffer_.appendSliceForTest(std::string(100, 'b'));
+
+  EXPECT_CALL(os_sys_calls_, sendmsg(Fd, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{20000, 0}));
+  EXPECT_EQ(20000U, sender_.write(io_handle_, buffer_).rc_);
+
+  EXPECT_CALL(io_handle_, writev(_, 1)).WillOnce(Return(ByMove(ioResult(100))));
+  EXPECT_EQ(100U, sender_.write(io_handle_, buffer_).rc_);
+  EXPECT_EQ(20100U, buffer_.length());
+  EXPECT_EQ(20100U, sender_.bytesInFlight());
+
+  expectCompletion(0, 0);
+  sender_.releaseCompleted(io_handle_, buffer_);
+  EXPECT_EQ(0U, buffer_.length());
+
+  // With nothing in flight, copied data is drained right away.
+  buffer_.appendSliceForTest(std::string(100, 'c'));
+  EXPECT_CALL(io_handle_, writev(_, 1)).WillOnce(Return(ByMove(ioResult(100))));
+  EXPECT_EQ(100U, sender_.write(io_handle_, buffer_).rc_);
+  EXPECT_EQ(0U, buffer_.length());
+}
+
+// Once the kernel reports having copied the data anyway, the socket stops sending without copying.
+TEST_F(ZeroCopySenderTest, CopiedCompletionDisablesZeroCopy) {
+  buffer_.appendSliceForTest(std::string(20000, 'a'));
+  const uint64_t copied_bytes = ZeroCopySender::totalCopiedBytes();
+
+  EXPECT_CALL(os_sys_calls_, sendmsg(Fd, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{20000, 0}));
+  sender_.write(io_handle_, buffer_);
+  expectCompletion(0, 0, true);
+  sender_.releaseCompleted(io_handle_, buffer_);
+  EXPECT_EQ(copied_bytes + 20000U, ZeroCopySender::totalCopiedBytes());
+
+  buffer_.appendSliceForTest(std::string(20000, 'b'));
+  EXPECT_CALL(io_handle_, writev(_, 1)).WillOnce(Return(ByMove(ioResult(20000))));
+  EXPECT_EQ(20000U, sender_.write(io_handle_, buffer_).rc_);
+  EXPECT_EQ(0U, buffer_.length());
+}
+
+// Sends the kernel can't pin memory for are copied instead.
+TEST_F(ZeroCopySenderTest, NoBufferSpaceFallsBackToCopy) {
+  buffer_.appendSliceForTest(std::string(20000, 'a'));
+  const uint64_t fallbacks = ZeroCopySender::totalFallbacks();
+
+  EXPECT_CALL(os_sys_calls_, sendmsg(Fd, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, ENOBUFS}));
+  EXPECT_CALL(io_handle_, writev(_, 1)).WillOnce(Return(ByMove(ioResult(20000))));
+  EXPECT_EQ(20000U, sender_.write(io_handle_, buffer_).rc_);
+  EXPECT_EQ(0U, buffer_.length());
+  EXPECT_EQ(0U, sender_.bytesInFlight());
+  EXPECT_EQ(fallbacks + 1, ZeroCopySender::totalFallbacks());
+}
+
+// A socket refusing SO_ZEROCOPY is only asked once.
+TEST_F(ZeroCopySenderTest, SocketWithoutZeroCopySupport) {
+  const uint64_t fallbacks = ZeroCopySender::totalFallbacks();
+
+  EXPECT_CALL(os_sys_calls_, setsockopt_(Fd, SOL_SOCKET, SO_ZEROCOPY, _, _)).WillOnce(Return(-1));
+  EXPECT_CALL(os_sys_calls_, sendmsg(_, _, _)).Times(0);
+  EXPECT_CALL(io_handle_, writev(_, 1)).Times(2).WillRepeatedly(Invoke([](auto, auto) {
+    return ioResult(20000);
+  }));
+  buffer_.appendSliceForTest(std::string(20000, 'a'));
+  sender_.write(io_handle_, buffer_);
+  buffer_.appendSliceForTest(std::string(20000, 'b'));
+  sender_.write(io_handle_, buffer_);
+  EXPECT_EQ(0U, buffer_.length());
+  EXPECT_EQ(fallbacks + 1, ZeroCopySender::totalFallbacks());
+}
+
+// Other send errors are reported to the connection.
+TEST_F(ZeroCopySenderTest, SendError) {
+  buffer_.appendSliceForTest(std::string(20000, 'a'));
+
+  EXPECT_CALL(os_sys_calls_, sendmsg(Fd, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EAGAIN}))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, ECONNRESET}));
+  Api::IoCallUint64Result result = sender_.write(io_handle_, buffer_);
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again, result.err_->getErrorCode());
+  result = sender_.write(io_handle_, buffer_);
+  EXPECT_FALSE(result.ok());
+  EXPECT_NE(Api::IoError::IoErrorCode::Again, result.err_->getErrorCode());
+  EXPECT_EQ(20000U, buffer_.length());
+  EXPECT_EQ(0U, sender_.bytesInFlight());
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
+
+#endif
@@ -10,6 +10,7 @@
 #include "common/config/runtime_utility.h"
 #include "common/runtime/runtime_features.h"
 #include "common/runtime/runtime_impl.h"
+#include "common/runtime/runtime_keys.h"
 
 #include "test/common/stats/stat_test_utility.h"
 #include "test/mocks/event/mocks.h"
@@ -734,6 +735,56 @@ TEST_F(StaticLoaderImplTest, ProtoParsing) {
   EXPECT_EQ(2, store_.gauge("runtime.num_layers", Stats::Gauge::ImportMode::NeverImport).value());
 }
 
+// Lookups through a KeyHandle agree with lookups by name, whether or not the key was registered
+// before the snapshot was created.
+TEST_F(StaticLoaderImplTest, KeyHandles) {
+  base_ = TestUtility::parseYaml<ProtobufWkt::Struct>(R"EOF(
+    handles.integer: 2
+    handles.double: 23.2
+    handles.boolean: true
+    handles.fractional:
+      numerator: 52
+      denominator: HUNDRED
+    handles.late: 7
+  )EOF");
+  const KeyHandle integer = KeyRegistry::get().registerKey("handles.integer");
+  const KeyHandle dbl = KeyRegistry::get().registerKey("handles.double");
+  const KeyHandle boolean = KeyRegistry::get().registerKey("handles.boolean");
+  const KeyHandle fractional = KeyRegistry::get().registerKey("handles.fractional");
+  const KeyHandle missing = KeyRegistry::get().registerKey("handles.missing");
+  // Registering a key again gives the same handle.
+  EXPECT_EQ(integer.index(), KeyRegistry::get().registerKey("handles.integer").index());
+  setup();
+  const KeyHandle late = KeyRegistry::get().registerKey("handles.late");
+
+  const Snapshot& snapshot = loader_->snapshot();
+  EXPECT_EQ(2UL, snapshot.getInteger(integer, 1));
+  EXPECT_EQ(1UL, snapshot.getInteger(missing, 1));
+  EXPECT_EQ(7UL, snapshot.getInteger(late, 1));
+  EXPECT_EQ(23.2, snapshot.getDouble(dbl, 1.1));
+  EXPECT_EQ(1.1, snapshot.getDouble(missing, 1.1));
+  EXPECT_TRUE(snapshot.getBoolean(boolean, false));
+  EXPECT_FALSE(snapshot.getBoolean(missing, false));
+
+  envoy::type::v3::FractionalPercent fractional_percent;
+  fractional_percent.set_numerator(5);
+  fractional_percent.set_denominator(envoy::type::v3::FractionalPercent::TEN_THOUSAND);
+  EXPECT_TRUE(snapshot.featureEnabled(fractional, fractional_percent, 51));
+  EXPECT_FALSE(snapshot.featureEnabled(fractional, fractional_percent, 53));
+  EXPECT_TRUE(snapshot.featureEnabled(missing, fractional_percent, 4));
+  EXPECT_FALSE(snapshot.featureEnabled(missing, fractional_percent, 6));
+  EXPECT_CALL(generator_, random()).WillOnce(Return(51));
+  EXPECT_TRUE(snapshot.featureEnabled(fractional, fractional_percent));
+
+  // Overrides are seen through the handles, including the handles of keys registered after the
+  // previous snapshot was created.
+  loader_->mergeValues({{"handles.integer", "3"}, {"handles.late", "8"}});
+  EXPECT_EQ(3UL, loader_->snapshot().getInteger(integer, 1));
+  EXPECT_EQ(8UL, loader_->snapshot().getInteger(late, 1));
+  EXPECT_EQ(loader_->snapshot().getInteger("handles.late", 1),
+            loader_->snapshot().getInteger(late, 1));
+}
+
 TEST_F(StaticLoaderImplTest, RuntimeFromNonWorkerThreads) {
   // Force the thread to be considered a non-worker thread.
   tls_.registered_ = false;
@@ -0,0 +1,88 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "envoy/type/v3/percent.pb.h"
+
+#include "common/runtime/runtime_impl.h"
+#include "common/runtime/runtime_keys.h"
+#include "common/stats/isolated_store_impl.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Runtime {
+
+// A snapshot with the given number of keys, such as a runtime with many overrides has.
+class SnapshotFixture {
+public:
+  explicit SnapshotFixture(int num_keys)
+      : stats_{ALL_RUNTIME_STATS(POOL_COUNTER_PREFIX(store_, "runtime."),
+                                 POOL_GAUGE_PREFIX(store_, "runtime."))} {
+    std::unordered_map<std::string, std::string> values;
+    for (int i = 0; i < num_keys; ++i) {
+      values[key(i)] = absl::StrCat(i);
+    }
+    // Register the looked up key before the snapshot is created, as filters do at configuration.
+    handle_ = std::make_unique<KeyHandle>(KeyRegistry::get().registerKey(key(num_keys / 2)));
+    auto layer = std::make_unique<AdminLayer>("admin", stats_);
+    layer->mergeValues(values);
+    std::vector<OverrideLayerConstPtr> layers;
+    layers.push_back(std::move(layer));
+    snapshot_ = std::make_unique<SnapshotImpl>(generator_, stats_, std::move(layers));
+  }
+
+  static std::string key(int i) {
+    return absl::StrCat("envoy.filters.http.fault.cluster_", i, ".delay.fixed_percent");
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  RuntimeStats stats_;
+  RandomGeneratorImpl generator_;
+  std::unique_ptr<KeyHandle> handle_;
+  std::unique_ptr<SnapshotImpl> snapshot_;
+};
+
+static void getIntegerByName(benchmark::State& state) {
+  SnapshotFixture fixture(state.range(0));
+  const std::string key = SnapshotFixture::key(state.range(0) / 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fixture.snapshot_->getInteger(key, 0));
+  }
+}
+BENCHMARK(getIntegerByName)->Arg(10)->Arg(1000)->Arg(100000);
+
+static void getIntegerByHandle(benchmark::State& state) {
+  SnapshotFixture fixture(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fixture.snapshot_->getInteger(*fixture.handle_, 0));
+  }
+}
+BENCHMARK(getIntegerByHandle)->Arg(10)->Arg(1000)->Arg(100000);
+
+static void featureEnabledByName(benchmark::State& state) {
+  SnapshotFixture fixture(state.range(0));
+  const std::string key = SnapshotFixture::key(state.range(0) / 2);
+  envoy::type::v3::FractionalPercent percent;
+  percent.set_numerator(50);
+  uint64_t random_value = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fixture.snapshot_->featureEnabled(key, percent, ++random_value));
+  }
+}
+BENCHMARK(featureEnabledByName)->Arg(10)->Arg(1000)->Arg(100000);
+
+static void featureEnabledByHandle(benchmark::State& state) {
+  SnapshotFixture fixture(state.range(0));
+  envoy::type::v3::FractionalPercent percent;
+  percent.set_numerator(50);
+  uint64_t random_value = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        fixture.snapshot_->featureEnabled(*fixture.handle_, percent, ++random_value));
+  }
+}
+BENCHMARK(featureEnabledByHandle)->Arg(10)->Arg(1000)->Arg(100000);
+
+} // namespace Runtime
+} // namespace Envoy
@@ -31,6 +31,7 @@
 #include "test/mocks/tcp/mocks.h"
 #include "test/mocks/upstream/host.h"
 #include "test/mocks/upstream/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -1516,6 +1517,89 @@ TEST_F(TcpProxyTest, DEPRECATED_FEATURE_TEST(IdleTimeoutWithOutstandingDataFlush
   idle_timer->invokeCallback();
 }
 
+// Tests that with the lazy idle timer, activity does not re-arm the timer, and the timer is
+// pushed out by the remaining idle time when it fires.
+TEST_F(TcpProxyTest, DEPRECATED_FEATURE_TEST(LazyIdleTimeout)) {
+  TestScopedRuntime scoped_runtime;
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.tcp_proxy_lazy_idle_timer", "true"}});
+  MonotonicTime now;
+  ON_CALL(filter_callbacks_.connection_.dispatcher_, approximateMonotonicTime())
+      .WillByDefault(ReturnPointee(&now));
+
+  envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy config = defaultConfig();
+  config.mutable_idle_timeout()->set_seconds(1);
+  setup(1, config);
+
+  Event::MockTimer* idle_timer = new Event::MockTimer(&filter_callbacks_.connection_.dispatcher_);
+  EXPECT_CALL(*idle_timer, enableTimer(std::chrono::milliseconds(1000), _));
+  raiseEventUpstreamConnected(0);
+
+  now += std::chrono::milliseconds(600);
+  EXPECT_CALL(*idle_timer, enableTimer(_, _)).Times(0);
+  Buffer::OwnedImpl buffer("hello");
+  filter_->onData(buffer, false);
+  buffer.add("hello2");
+  upstream_callbacks_->onUpstreamData(buffer, false);
+  filter_callbacks_.connection_.raiseBytesSentCallbacks(1);
+  upstream_connections_.at(0)->raiseBytesSentCallbacks(2);
+  testing::Mock::VerifyAndClearExpectations(idle_timer);
+
+  // The original deadline passes; the connection has only been idle for 400ms.
+  now += std::chrono::milliseconds(400);
+  EXPECT_CALL(*idle_timer, enableTimer(std::chrono::milliseconds(600), _));
+  idle_timer->invokeCallback();
+  EXPECT_EQ(0U, config_->stats().idle_timeout_.value());
+
+  now += std::chrono::milliseconds(600);
+  EXPECT_CALL(*upstream_connections_.at(0), close(Network::ConnectionCloseType::NoFlush));
+  EXPECT_CALL(filter_callbacks_.connection_, close(Network::ConnectionCloseType::NoFlush));
+  EXPECT_CALL(*idle_timer, disableTimer());
+  idle_timer->invokeCallback();
+  EXPECT_EQ(1U, config_->stats().idle_timeout_.value());
+}
+
+// Tests that with the lazy idle timer, the timer handed to the upstream drainer is armed for the
+// idle time remaining since the last activity.
+TEST_F(TcpProxyTest, DEPRECATED_FEATURE_TEST(LazyIdleTimerUpstreamFlush)) {
+  TestScopedRuntime scoped_runtime;
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.tcp_proxy_lazy_idle_timer", "true"}});
+  MonotonicTime now;
+  ON_CALL(filter_callbacks_.connection_.dispatcher_, approximateMonotonicTime())
+      .WillByDefault(ReturnPointee(&now));
+
+  envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy config = defaultConfig();
+  config.mutable_idle_timeout()->set_seconds(1);
+  setup(1, config);
+
+  NiceMock<Event::MockTimer>* idle_timer =
+      new NiceMock<Event::MockTimer>(&filter_callbacks_.connection_.dispatcher_);
+  EXPECT_CALL(*idle_timer, enableTimer(std::chrono::milliseconds(1000), _));
+  raiseEventUpstreamConnected(0);
+
+  now += std::chrono::milliseconds(300);
+  Buffer::OwnedImpl buffer("hello");
+  filter_->onData(buffer, false);
+
+  now += std::chrono::milliseconds(500);
+  EXPECT_CALL(*upstream_connections_.at(0),
+              close(Network::ConnectionCloseType::FlushWrite))
+      .WillOnce(Return()); // Cancel default action of raising LocalClose
+  EXPECT_CALL(*upstream_connections_.at(0), state())
+      .WillOnce(Return(Network::Connection::State::Closing));
+  EXPECT_CALL(*idle_timer, enableTimer(std::chrono::milliseconds(500), _));
+  filter_callbacks_.connection_.raiseEvent(Network::ConnectionEvent::RemoteClose);
+
+  filter_.reset();
+  EXPECT_EQ(1U, config_->stats().upstream_flush_active_.value());
+
+  EXPECT_CALL(*upstream_connections_.at(0), close(Network::ConnectionCloseType::NoFlush));
+  idle_timer->invokeCallback();
+  EXPECT_EQ(0U, config_->stats().upstream_flush_active_.value());
+  EXPECT_EQ(1U, config_->stats().idle_timeout_.value());
+}
+
 // Test that access log fields %UPSTREAM_HOST% and %UPSTREAM_CLUSTER% are correctly logged.
 TEST_F(TcpProxyTest, DEPRECATED_FEATURE_TEST(AccessLogUpstreamHost)) {
   setup(1, accessLogConfig("%UPSTREAM_HOST% %UPSTREAM_CLUSTER%"));
@@ -15,8 +15,10 @@
 #include "test/mocks/protobuf/mocks.h"
 #include "test/mocks/upstream/mocks.h"
 #include "test/test_common/printers.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -36,7 +38,7 @@ class CdsApiImplTest : public testing::Test {
 protected:
   void setup() {
     envoy::config::core::v3::ConfigSource cds_config;
-    cds_ = CdsApiImpl::create(cds_config, cm_, store_, validation_visitor_);
+    cds_ = CdsApiImpl::create(cds_config, cm_, store_, validation_visitor_, *api_);
     cds_->setInitializedCb([this]() -> void { initialized_.ready(); });
 
     EXPECT_CALL(*cm_.subscription_factory_.subscription_, start(_));
@@ -69,6 +71,7 @@ protected:
   Config::SubscriptionCallbacks* cds_callbacks_{};
   ReadyWatcher initialized_;
   NiceMock<ProtobufMessage::MockValidationVisitor> validation_visitor_;
+  Api::ApiPtr api_{Api::createApiForTest()};
 };
 
 // Negative test for protoc-gen-validate constraints.
@@ -260,6 +263,34 @@ TEST_F(CdsApiImplTest, ConfigUpdateAddsSecondClusterEvenIfFirstThrows) {
       "Error adding/updating cluster(s) cluster_1: An exception, cluster_3: Another exception");
 }
 
+// Large updates are decoded over several threads but still applied in order.
+TEST_F(CdsApiImplTest, LargeConfigUpdateAppliedInOrder) {
+  {
+    InSequence s;
+    setup();
+  }
+
+  EXPECT_CALL(cm_, clusters()).WillOnce(Return(ClusterManager::ClusterInfoMap{}));
+  EXPECT_CALL(initialized_, ready());
+
+  InSequence s;
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> clusters;
+  const int invalid_cluster = 300;
+  for (int i = 0; i < 1000; ++i) {
+    envoy::config::cluster::v3::Cluster cluster;
+    if (i != invalid_cluster) {
+      cluster.set_name(absl::StrCat("cluster_", i));
+      expectAdd(cluster.name(), "1");
+    }
+    clusters.Add()->PackFrom(cluster);
+  }
+
+  EXPECT_THROW_WITH_REGEX(cds_callbacks_->onConfigUpdate(clusters, "1"), EnvoyException,
+                          "Error adding/updating cluster\\(s\\) : Proto constraint validation "
+                          "failed \\(ClusterValidationError.Name");
+  EXPECT_EQ("1", cds_->versionInfo());
+}
+
 TEST_F(CdsApiImplTest, Basic) {
   InSequence s;
 
@@ -312,7 +343,7 @@ resources:
       TestUtility::parseYaml<envoy::service::discovery::v3::DiscoveryResponse>(response2_yaml);
 
   EXPECT_CALL(cm_, clusters()).WillOnce(Return(makeClusterMap({"cluster1", "cluster2"})));
-  expectAdd("cluster1", "1");
+  // cluster1 is unchanged, so it is not applied again.
   expectAdd("cluster3", "1");
   EXPECT_CALL(cm_, removeCluster("cluster2"));
   cds_callbacks_->onConfigUpdate(response2.resources(), response2.version_info());
@@ -320,6 +351,116 @@ resources:
   EXPECT_EQ("1", cds_->versionInfo());
 }
 
+// Clusters sent again unchanged are only applied again if the cluster manager lost them or the
+// feature is disabled.
+TEST_F(CdsApiImplTest, UnchangedClusters) {
+  {
+    InSequence s;
+    setup();
+  }
+  EXPECT_CALL(initialized_, ready());
+
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> clusters;
+  for (const std::string name : {"cluster_1", "cluster_2"}) {
+    envoy::config::cluster::v3::Cluster cluster;
+    cluster.set_name(name);
+    clusters.Add()->PackFrom(cluster);
+  }
+
+  {
+    InSequence s;
+    EXPECT_CALL(cm_, clusters()).WillOnce(Return(ClusterManager::ClusterInfoMap{}));
+    expectAdd("cluster_1", "1");
+    expectAdd("cluster_2", "1");
+    cds_callbacks_->onConfigUpdate(clusters, "1");
+  }
+
+  // Sent again, e.g. after reconnecting to the management server.
+  {
+    InSequence s;
+    EXPECT_CALL(cm_, clusters()).WillOnce(Return(makeClusterMap({"cluster_1", "cluster_2"})));
+    EXPECT_CALL(cm_, addOrUpdateCluster(_, _)).Times(0);
+    EXPECT_CALL(cm_, removeCluster(_)).Times(0);
+    cds_callbacks_->onConfigUpdate(clusters, "2");
+  }
+  EXPECT_EQ("1", cds_->versionInfo());
+
+  // A cluster the cluster manager does not have is applied again.
+  {
+    InSequence s;
+    EXPECT_CALL(cm_, clusters()).WillOnce(Return(makeClusterMap({"cluster_1"})));
+    expectAdd("cluster_2", "3");
+    cds_callbacks_->onConfigUpdate(clusters, "3");
+  }
+
+  // A duplicate of a skipped cluster is still rejected.
+  {
+    InSequence s;
+    Protobuf::RepeatedPtrField<ProtobufWkt::Any> duplicated = clusters;
+    envoy::config::cluster::v3::Cluster cluster;
+    cluster.set_name("cluster_1");
+    cluster.mutable_connect_timeout()->set_seconds(1);
+    duplicated.Add()->PackFrom(cluster);
+    EXPECT_CALL(cm_, clusters()).WillOnce(Return(makeClusterMap({"cluster_1", "cluster_2"})));
+    EXPECT_THROW_WITH_MESSAGE(cds_callbacks_->onConfigUpdate(duplicated, "4"), EnvoyException,
+                              "Error adding/updating cluster(s) cluster_1: duplicate cluster "
+                              "cluster_1 found");
+  }
+
+  TestScopedRuntime scoped_runtime;
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.cds_skip_unchanged_clusters", "false"}});
+  {
+    InSequence s;
+    EXPECT_CALL(cm_, clusters()).WillOnce(Return(makeClusterMap({"cluster_1", "cluster_2"})));
+    expectAdd("cluster_1", "5");
+    expectAdd("cluster_2", "5");
+    cds_callbacks_->onConfigUpdate(clusters, "5");
+  }
+}
+
+// Delta updates skip the clusters sent again unchanged.
+TEST_F(CdsApiImplTest, DeltaUnchangedClusters) {
+  {
+    InSequence s;
+    setup();
+  }
+  EXPECT_CALL(initialized_, ready());
+
+  const auto make_resources = [](uint64_t cluster_2_timeout, const std::string& version) {
+    Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource> resources;
+    for (const std::string name : {"cluster_1", "cluster_2"}) {
+      envoy::config::cluster::v3::Cluster cluster;
+      cluster.set_name(name);
+      if (name == "cluster_2") {
+        cluster.mutable_connect_timeout()->set_seconds(cluster_2_timeout);
+      }
+      auto* resource = resources.Add();
+      resource->mutable_resource()->PackFrom(cluster);
+      resource->set_name(name);
+      resource->set_version(version);
+    }
+    return resources;
+  };
+
+  expectAdd("cluster_1", "v1");
+  expectAdd("cluster_2", "v1");
+  cds_callbacks_->onConfigUpdate(make_resources(1, "v1"), {}, "v1");
+
+  EXPECT_CALL(cm_, clusters()).WillOnce(Return(makeClusterMap({"cluster_1", "cluster_2"})));
+  expectAdd("cluster_2", "v2");
+  cds_callbacks_->onConfigUpdate(make_resources(2, "v2"), {}, "v2");
+
+  // A removed cluster is applied again when it comes back.
+  Protobuf::RepeatedPtrField<std::string> removed;
+  *removed.Add() = "cluster_1";
+  EXPECT_CALL(cm_, removeCluster(StrEq("cluster_1"))).WillOnce(Return(true));
+  cds_callbacks_->onConfigUpdate({}, removed, "v3");
+  EXPECT_CALL(cm_, clusters()).WillOnce(Return(makeClusterMap({"cluster_2"})));
+  expectAdd("cluster_1", "v4");
+  cds_callbacks_->onConfigUpdate(make_resources(2, "v4"), {}, "v4");
+}
+
 // Validate behavior when the config is delivered but it fails PGV validation.
 TEST_F(CdsApiImplTest, FailureInvalidConfig) {
   InSequence s;
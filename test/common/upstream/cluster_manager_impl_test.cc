@@ -5,6 +5,7 @@
 #include "envoy/config/core/v3/base.pb.h"
 
 #include "test/common/upstream/test_cluster_manager.h"
+#include "test/test_common/test_runtime.h"
 
 using testing::_;
 using testing::Eq;
@@ -744,6 +745,79 @@ TEST_F(ClusterManagerImplThreadAwareLbTest, MaglevLoadBalancerThreadAwareUpdate)
   doTest(LoadBalancerType::Maglev);
 }
 
+class CountingLoadBalancerFactory : public LoadBalancerFactory {
+public:
+  // Upstream::LoadBalancerFactory
+  LoadBalancerPtr create() override {
+    ++created_;
+    return std::make_unique<NiceMock<MockLoadBalancer>>();
+  }
+
+  uint32_t created_{};
+};
+
+class ClusterManagerImplLazyLbTest : public ClusterManagerImplTest {
+public:
+  void createCluster() {
+    const std::string json = fmt::sprintf("{\"static_resources\":{%s}}",
+                                          clustersJson({defaultStaticClusterJson("cluster_0")}));
+
+    cluster1_ = std::make_shared<NiceMock<MockClusterMockPrioritySet>>();
+    cluster1_->info_->name_ = "cluster_0";
+    cluster1_->info_->lb_type_ = LoadBalancerType::ClusterProvided;
+    auto* thread_aware_lb = new NiceMock<MockThreadAwareLoadBalancer>();
+    ON_CALL(*thread_aware_lb, factory()).WillByDefault(Return(lb_factory_));
+    EXPECT_CALL(factory_, clusterFromProto_(_, _, _, _))
+        .WillOnce(Return(std::make_pair(cluster1_, thread_aware_lb)));
+    ON_CALL(*cluster1_, initializePhase()).WillByDefault(Return(Cluster::InitializePhase::Primary));
+    create(parseBootstrapFromV2Json(json));
+  }
+
+  void updateHosts() {
+    cluster1_->prioritySet().getMockHostSet(0)->hosts_ = {
+        makeTestHost(cluster1_->info_, "tcp://127.0.0.1:80")};
+    cluster1_->prioritySet().getMockHostSet(0)->runCallbacks(
+        cluster1_->prioritySet().getMockHostSet(0)->hosts_, {});
+  }
+
+  std::shared_ptr<MockClusterMockPrioritySet> cluster1_;
+  std::shared_ptr<CountingLoadBalancerFactory> lb_factory_{
+      std::make_shared<CountingLoadBalancerFactory>()};
+};
+
+// Test that the worker local LB is only created once the worker uses it, and is only re-created
+// on membership updates from then on.
+TEST_F(ClusterManagerImplLazyLbTest, CreatedOnFirstUse) {
+  TestScopedRuntime scoped_runtime;
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.lazy_thread_local_load_balancers", "true"}});
+
+  createCluster();
+  updateHosts();
+  cluster1_->initialize_callback_();
+  EXPECT_EQ(0, lb_factory_->created_);
+
+  cluster_manager_->get("cluster_0")->loadBalancer();
+  cluster_manager_->get("cluster_0")->loadBalancer();
+  EXPECT_EQ(1, lb_factory_->created_);
+
+  updateHosts();
+  EXPECT_EQ(2, lb_factory_->created_);
+}
+
+// By default, the worker local LB is created with the cluster and re-created on every membership
+// update.
+TEST_F(ClusterManagerImplLazyLbTest, CreatedEagerlyByDefault) {
+  createCluster();
+  EXPECT_EQ(1, lb_factory_->created_);
+  updateHosts();
+  cluster1_->initialize_callback_();
+  EXPECT_EQ(2, lb_factory_->created_);
+
+  cluster_manager_->get("cluster_0")->loadBalancer();
+  EXPECT_EQ(2, lb_factory_->created_);
+}
+
 TEST_F(ClusterManagerImplTest, TcpHealthChecker) {
   const std::string yaml = R"EOF(
  static_resources:
@@ -2179,6 +2253,54 @@ TEST_F(ClusterManagerImplTest, UseTcpWithCustomDnsResolver) {
 // ClusterManagerImpl::ThreadLocalClusterManagerImpl::drainConnPools(), where a removal at one
 // priority from the ConnPoolsContainer would delete the ConnPoolsContainer mid-iteration over the
 // pool.
+// Unused HTTP connection pools are freed once they go a whole connection_pool_idle_timeout
+// interval without being handed out.
+TEST_F(ClusterManagerImplTest, ConnectionPoolIdleTimeout) {
+  const std::string yaml = R"EOF(
+  static_resources:
+    clusters:
+    - name: cluster_1
+      connect_timeout: 0.250s
+      connection_pool_idle_timeout: 10s
+      type: STATIC
+      lb_policy: ROUND_ROBIN
+      load_assignment:
+        cluster_name: cluster_1
+        endpoints:
+          - lb_endpoints:
+            - endpoint:
+                address:
+                  socket_address:
+                    address: 127.0.0.1
+                    port_value: 11001
+  )EOF";
+
+  Event::MockTimer* idle_pool_timer = new NiceMock<Event::MockTimer>(&factory_.dispatcher_);
+  EXPECT_CALL(*idle_pool_timer, enableTimer(std::chrono::milliseconds(10000), _));
+  create(parseBootstrapFromV2Yaml(yaml));
+
+  EXPECT_CALL(factory_, allocateConnPool_(_, _, _))
+      .Times(2)
+      .WillRepeatedly(ReturnNew<NiceMock<Http::ConnectionPool::MockInstance>>());
+  Http::ConnectionPool::Instance* cp = cluster_manager_->httpConnPoolForCluster(
+      "cluster_1", ResourcePriority::Default, Http::Protocol::Http11, nullptr);
+  EXPECT_NE(nullptr, cp);
+
+  // The pool was used during the first interval so it is kept.
+  EXPECT_CALL(*idle_pool_timer, enableTimer(std::chrono::milliseconds(10000), _)).Times(3);
+  idle_pool_timer->invokeCallback();
+  EXPECT_EQ(cp, cluster_manager_->httpConnPoolForCluster("cluster_1", ResourcePriority::Default,
+                                                         Http::Protocol::Http11, nullptr));
+
+  // Unused for a whole interval, so the next request gets a new pool.
+  idle_pool_timer->invokeCallback();
+  idle_pool_timer->invokeCallback();
+  Http::ConnectionPool::Instance* cp2 = cluster_manager_->httpConnPoolForCluster(
+      "cluster_1", ResourcePriority::Default, Http::Protocol::Http11, nullptr);
+  EXPECT_NE(nullptr, cp2);
+  EXPECT_NE(cp, cp2);
+}
+
 TEST_F(ClusterManagerImplTest, DynamicHostRemoveDefaultPriority) {
   const std::string yaml = R"EOF(
   static_resources:
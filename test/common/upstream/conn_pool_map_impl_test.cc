@@ -213,6 +213,62 @@ TEST_F(ConnPoolMapImplTest, ClearDefersDelete) {
   EXPECT_EQ(dispatcher_.to_delete_.size(), 2);
 }
 
+// A pool is only freed once it has gone a whole interval without being handed out.
+TEST_F(ConnPoolMapImplTest, FreeIdlePoolsSkipsRecentlyUsedPools) {
+  TestMapPtr test_map = makeTestMap();
+
+  test_map->getPool(1, getBasicFactory());
+  test_map->getPool(2, getBasicFactory());
+  EXPECT_EQ(test_map->freeIdlePools(), 0);
+  EXPECT_EQ(test_map->size(), 2);
+
+  test_map->getPool(1, getNeverCalledFactory());
+  EXPECT_EQ(test_map->freeIdlePools(), 1);
+  EXPECT_EQ(test_map->size(), 1);
+  EXPECT_EQ(dispatcher_.to_delete_.size(), 1);
+
+  EXPECT_EQ(test_map->freeIdlePools(), 1);
+  EXPECT_EQ(test_map->size(), 0);
+  EXPECT_EQ(dispatcher_.to_delete_.size(), 2);
+}
+
+TEST_F(ConnPoolMapImplTest, FreeIdlePoolsSkipsActivePools) {
+  TestMapPtr test_map = makeTestMap();
+
+  test_map->getPool(1, getActivePoolFactory());
+  test_map->getPool(2, getBasicFactory());
+  test_map->freeIdlePools();
+
+  EXPECT_EQ(test_map->freeIdlePools(), 1);
+  EXPECT_EQ(test_map->size(), 1);
+  auto opt_pool = test_map->getPool(1, getNeverCalledFactory());
+  EXPECT_EQ(&(opt_pool.value().get()), mock_pools_[0]);
+}
+
+// Pools are left alone while the map is draining so that every drained callback still fires.
+TEST_F(ConnPoolMapImplTest, FreeIdlePoolsNoOpWhileDraining) {
+  TestMapPtr test_map = makeTestMap();
+
+  test_map->getPool(1, getBasicFactory());
+  test_map->addDrainedCallback([] {});
+  test_map->freeIdlePools();
+
+  EXPECT_EQ(test_map->freeIdlePools(), 0);
+  EXPECT_EQ(test_map->size(), 1);
+}
+
+TEST_F(ConnPoolMapImplTest, CircuitBreakerClearedOnFreeIdlePools) {
+  TestMapPtr test_map = makeTestMapWithLimit(2);
+
+  test_map->getPool(1, getBasicFactory());
+  test_map->getPool(2, getBasicFactory());
+  EXPECT_EQ(host_->cluster_.circuit_breakers_stats_.cx_pool_open_.value(), 1);
+
+  test_map->freeIdlePools();
+  test_map->freeIdlePools();
+  EXPECT_EQ(host_->cluster_.circuit_breakers_stats_.cx_pool_open_.value(), 0);
+}
+
 TEST_F(ConnPoolMapImplTest, GetPoolHittingLimitFails) {
   TestMapPtr test_map = makeTestMapWithLimit(1);
 
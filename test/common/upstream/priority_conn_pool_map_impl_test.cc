@@ -137,6 +137,17 @@ TEST_F(PriorityConnPoolMapImplTest, TestDrainConnectionsProxiedThrough) {
   test_map->drainConnections();
 }
 
+TEST_F(PriorityConnPoolMapImplTest, TestFreeIdlePoolsProxiedThrough) {
+  TestMapPtr test_map = makeTestMap();
+
+  test_map->getPool(ResourcePriority::High, 0, getBasicFactory());
+  test_map->getPool(ResourcePriority::Default, 0, getBasicFactory());
+
+  EXPECT_EQ(test_map->freeIdlePools(), 0);
+  EXPECT_EQ(test_map->freeIdlePools(), 2);
+  EXPECT_EQ(test_map->size(), 0);
+}
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
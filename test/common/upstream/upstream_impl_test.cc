@@ -33,6 +33,7 @@
 #include "test/mocks/ssl/mocks.h"
 #include "test/mocks/upstream/mocks.h"
 #include "test/test_common/registry.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -1732,6 +1733,74 @@ TEST_F(StaticClusterImplTest, HealthyStat) {
   EXPECT_EQ(0UL, cluster.info()->stats().membership_degraded_.value());
 }
 
+// Verify that health check transitions which happen in the same event loop iteration are
+// coalesced into a single host set rebuild when batching is enabled.
+TEST_F(StaticClusterImplTest, BatchedHealthCheckUpdates) {
+  TestScopedRuntime scoped_runtime;
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.batch_health_check_updates", "true"}});
+
+  const std::string yaml = R"EOF(
+    name: addressportconfig
+    connect_timeout: 0.25s
+    type: static
+    lb_policy: random
+    hosts:
+    - { socket_address: { address: 10.0.0.1, port_value: 11001 }}
+    - { socket_address: { address: 10.0.0.1, port_value: 11002 }}
+  )EOF";
+
+  envoy::config::cluster::v3::Cluster cluster_config = parseClusterFromV2Yaml(yaml);
+  Envoy::Stats::ScopePtr scope = stats_.createScope(fmt::format(
+      "cluster.{}.", cluster_config.alt_stat_name().empty() ? cluster_config.name()
+                                                            : cluster_config.alt_stat_name()));
+  Envoy::Server::Configuration::TransportSocketFactoryContextImpl factory_context(
+      admin_, ssl_context_manager_, *scope, cm_, local_info_, dispatcher_, random_, stats_,
+      singleton_manager_, tls_, validation_visitor_, *api_);
+  StaticClusterImpl cluster(cluster_config, runtime_, factory_context, std::move(scope), false);
+
+  std::shared_ptr<MockHealthChecker> health_checker(new NiceMock<MockHealthChecker>());
+  cluster.setHealthChecker(health_checker);
+
+  ReadyWatcher initialized;
+  cluster.initialize([&initialized] { initialized.ready(); });
+
+  const auto& hosts = cluster.prioritySet().hostSetsPerPriority()[0]->hosts();
+  EXPECT_EQ(2UL, hosts.size());
+  EXPECT_EQ(0UL, cluster.prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
+
+  // Transitions seen while initializing are covered by the initial host set build.
+  Event::MockTimer* batch_timer = new Event::MockTimer(&dispatcher_);
+  EXPECT_CALL(*batch_timer, enableTimer(std::chrono::milliseconds(0), _));
+  hosts[0]->healthFlagClear(Host::HealthFlag::FAILED_ACTIVE_HC);
+  health_checker->runCallbacks(hosts[0], HealthTransition::Changed);
+  hosts[1]->healthFlagClear(Host::HealthFlag::FAILED_ACTIVE_HC);
+  EXPECT_CALL(initialized, ready());
+  health_checker->runCallbacks(hosts[1], HealthTransition::Changed);
+  EXPECT_EQ(2UL, cluster.prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
+  batch_timer->invokeCallback();
+
+  uint32_t membership_updates = 0;
+  cluster.prioritySet().addPriorityUpdateCb(
+      [&membership_updates](uint32_t, const HostVector&, const HostVector&) {
+        membership_updates++;
+      });
+
+  // Two transitions in the same iteration result in a single rebuild once the timer fires.
+  EXPECT_CALL(*batch_timer, enableTimer(std::chrono::milliseconds(0), _));
+  hosts[0]->healthFlagSet(Host::HealthFlag::FAILED_ACTIVE_HC);
+  health_checker->runCallbacks(hosts[0], HealthTransition::Changed);
+  hosts[1]->healthFlagSet(Host::HealthFlag::FAILED_ACTIVE_HC);
+  health_checker->runCallbacks(hosts[1], HealthTransition::Changed);
+  EXPECT_EQ(2UL, cluster.prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
+  EXPECT_EQ(0UL, membership_updates);
+
+  batch_timer->invokeCallback();
+  EXPECT_EQ(0UL, cluster.prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
+  EXPECT_EQ(0UL, cluster.info()->stats().membership_healthy_.value());
+  EXPECT_EQ(1UL, membership_updates);
+}
+
 TEST_F(StaticClusterImplTest, UrlConfig) {
   const std::string yaml = R"EOF(
     name: addressportconfig
@@ -2113,7 +2182,7 @@ TEST_F(ClusterInfoImplTest, Metadata) {
                                    baz: {name: meh } } }
     common_lb_config:
       healthy_panic_threshold:
-        value: 0.3
+        value: 30
   )EOF";
 
   BazFactory baz_factory;
@@ -2141,7 +2210,7 @@ TEST_F(ClusterInfoImplTest, EdsServiceNamePopulation) {
     hosts: [{ socket_address: { address: foo.bar.com, port_value: 443 }}]
     common_lb_config:
       healthy_panic_threshold:
-        value: 0.3
+        value: 30
   )EOF";
   auto cluster = makeCluster(yaml);
   EXPECT_EQ(cluster->info()->eds_service_name(), "service_foo");
@@ -2156,7 +2225,7 @@ TEST_F(ClusterInfoImplTest, EdsServiceNamePopulation) {
     hosts: [{ socket_address: { address: foo.bar.com, port_value: 443 }}]
     common_lb_config:
       healthy_panic_threshold:
-        value: 0.3
+        value: 30
   )EOF";
   EXPECT_THROW_WITH_MESSAGE(makeCluster(unexpected_eds_config_yaml), EnvoyException,
                             "eds_cluster_config set in a non-EDS cluster");
@@ -2174,7 +2243,7 @@ TEST_F(ClusterInfoImplTest, BrokenTypedMetadata) {
                                    baz: {boom: meh} } }
     common_lb_config:
       healthy_panic_threshold:
-        value: 0.3
+        value: 30
   )EOF";
 
   BazFactory baz_factory;
@@ -2293,7 +2362,7 @@ TEST_F(ClusterInfoImplTest, Timeouts) {
                                    baz: {name: meh } } }
     common_lb_config:
       healthy_panic_threshold:
-        value: 0.3
+        value: 30
   )EOF";
 
   BazFactory baz_factory;
@@ -2376,6 +2445,42 @@ TEST_F(ClusterInfoImplTest, Http2ProtocolOptions) {
   EXPECT_EQ(cluster->info()->http2Options().custom_settings_parameters()[1].value().value(), 12);
 }
 
+// Clusters with the same options and metadata share one copy of them.
+TEST_F(ClusterInfoImplTest, SharedOptions) {
+  const std::string yaml = R"EOF(
+    name: {}
+    connect_timeout: 0.25s
+    type: STRICT_DNS
+    lb_policy: ROUND_ROBIN
+    http2_protocol_options:
+      hpack_table_size: {}
+    common_http_protocol_options:
+      idle_timeout: 1s
+    common_lb_config:
+      healthy_panic_threshold:
+        value: 30
+    metadata: {{ filter_metadata: {{ com.bar.foo: {{ baz: test_value }} }} }}
+  )EOF";
+
+  auto cluster1 = makeCluster(fmt::format(yaml, "name1", 2048));
+  auto cluster2 = makeCluster(fmt::format(yaml, "name2", 2048));
+  auto cluster3 = makeCluster(fmt::format(yaml, "name3", 4096));
+
+  EXPECT_EQ(&cluster1->info()->http2Options(), &cluster2->info()->http2Options());
+  EXPECT_NE(&cluster1->info()->http2Options(), &cluster3->info()->http2Options());
+  EXPECT_EQ(4096, cluster3->info()->http2Options().hpack_table_size().value());
+  EXPECT_EQ(&cluster1->info()->commonHttpProtocolOptions(),
+            &cluster3->info()->commonHttpProtocolOptions());
+  EXPECT_EQ(&cluster1->info()->lbConfig(), &cluster3->info()->lbConfig());
+  EXPECT_EQ(30, cluster3->info()->lbConfig().healthy_panic_threshold().value());
+  EXPECT_EQ(&cluster1->info()->metadata(), &cluster3->info()->metadata());
+
+  // The load report stats of each cluster are its own.
+  cluster1->info()->loadReportStats().upstream_rq_dropped_.inc();
+  EXPECT_EQ(1, cluster1->info()->loadReportStats().upstream_rq_dropped_.value());
+  EXPECT_EQ(0, cluster2->info()->loadReportStats().upstream_rq_dropped_.value());
+}
+
 class TestFilterConfigFactoryBase {
 public:
   TestFilterConfigFactoryBase(
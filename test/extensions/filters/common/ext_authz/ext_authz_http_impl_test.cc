@@ -196,6 +196,46 @@ TEST_F(ExtAuthzHttpClientTest, TestDefaultAllowedHeaders) {
       config_->upstreamHeaderMatchers()->matches(Http::Headers::get().ContentLength.get()));
 }
 
+// Test allowed headers with several regex patterns, which are matched as a set.
+TEST_F(ExtAuthzHttpClientTest, AllowedHeadersRegexSet) {
+  const std::string yaml = R"EOF(
+  http_service:
+    server_uri:
+      uri: "ext_authz:9000"
+      cluster: "ext_authz"
+      timeout: 0.25s
+    authorization_request:
+      allowed_headers:
+        patterns:
+        - exact: baz
+        - safe_regex:
+            google_re2: {}
+            regex: x-foo-[0-9]+
+        - safe_regex:
+            google_re2: {}
+            regex: x-bar-.*
+    authorization_response:
+      allowed_upstream_headers:
+        patterns:
+        - safe_regex:
+            google_re2: {}
+            regex: x-foo-[0-9]+
+  )EOF";
+
+  initialize(yaml);
+
+  EXPECT_TRUE(config_->requestHeaderMatchers()->matches("baz"));
+  EXPECT_TRUE(config_->requestHeaderMatchers()->matches("x-foo-42"));
+  EXPECT_TRUE(config_->requestHeaderMatchers()->matches("x-bar-"));
+  EXPECT_TRUE(config_->requestHeaderMatchers()->matches(Http::Headers::get().Host.get()));
+  // The patterns must match the whole key.
+  EXPECT_FALSE(config_->requestHeaderMatchers()->matches("x-foo-42a"));
+  EXPECT_FALSE(config_->requestHeaderMatchers()->matches("y-bar-"));
+
+  EXPECT_TRUE(config_->upstreamHeaderMatchers()->matches("x-foo-42"));
+  EXPECT_FALSE(config_->upstreamHeaderMatchers()->matches("x-bar-"));
+}
+
 // Verify client response when the authorization server returns a 200 OK and path_prefix is
 // configured.
 TEST_F(ExtAuthzHttpClientTest, AuthorizationOkWithPathRewrite) {
@@ -205,6 +205,32 @@ TEST_F(SimpleHttpCacheTest, StreamingPut) {
   EXPECT_EQ("Hello, World!", getBody(*name_lookup_context, 0, 13));
 }
 
+// Tests that hits reference the cached body rather than copying it, and that a body handed out
+// stays valid after its entry is replaced.
+TEST_F(SimpleHttpCacheTest, BodyIsSharedWithLookups) {
+  Http::TestResponseHeaderMapImpl response_headers{{"date", formatter_.fromTime(current_time_)},
+                                                   {"cache-control", "public,max-age=3600"}};
+  insert("request_path", response_headers, "Hello, World!");
+
+  Buffer::InstancePtr first;
+  lookup("request_path")->getBody(AdjustedByteRange(0, 13), [&first](Buffer::InstancePtr&& data) {
+    first = std::move(data);
+  });
+  Buffer::InstancePtr second;
+  lookup("request_path")->getBody(AdjustedByteRange(7, 13), [&second](Buffer::InstancePtr&& data) {
+    second = std::move(data);
+  });
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  const char* first_data = static_cast<const char*>(first->getRawSlices()[0].mem_);
+  EXPECT_EQ(static_cast<const void*>(first_data + 7), second->getRawSlices()[0].mem_);
+
+  insert("request_path", response_headers, "Goodbye");
+  EXPECT_TRUE(expectLookupSuccessWithBody(lookup("request_path").get(), "Goodbye"));
+  EXPECT_EQ("Hello, World!", first->toString());
+  EXPECT_EQ("World!", second->toString());
+}
+
 TEST(Registration, GetFactory) {
   HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
       "envoy.source.extensions.filters.http.cache.SimpleHttpCacheConfig");
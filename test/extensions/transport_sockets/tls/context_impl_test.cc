@@ -455,6 +455,79 @@ TEST_F(SslContextImplTest, MustHaveSubjectOrSAN) {
                           EnvoyException, "has neither subject CN nor SAN names");
 }
 
+// Contexts with the same trusted CA and CRL share a trust store, which is released with the last
+// context using it.
+TEST_F(SslContextImplTest, SharedCertStore) {
+  const std::string yaml = R"EOF(
+  common_tls_context:
+    validation_context:
+      trusted_ca:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/ca_cert.pem"
+)EOF";
+  envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext tls_context;
+  TestUtility::loadFromYaml(TestEnvironment::substitute(yaml), tls_context);
+  ClientContextConfigImpl client_config(tls_context, factory_context_);
+  Envoy::Ssl::ClientContextSharedPtr client_context1(
+      manager_.createSslClientContext(store_, client_config));
+  tls_context.set_sni("lyft.com");
+  ClientContextConfigImpl sni_client_config(tls_context, factory_context_);
+  Envoy::Ssl::ClientContextSharedPtr client_context2(
+      manager_.createSslClientContext(store_, sni_client_config));
+  EXPECT_EQ(1, manager_.certStoreCache().size());
+  EXPECT_EQ(client_context1->getCaCertInformation()->serial_number(),
+            client_context2->getCaCertInformation()->serial_number());
+
+  // The expiration handling is part of the trust store.
+  tls_context.mutable_common_tls_context()
+      ->mutable_validation_context()
+      ->set_allow_expired_certificate(true);
+  ClientContextConfigImpl allow_expired_client_config(tls_context, factory_context_);
+  Envoy::Ssl::ClientContextSharedPtr client_context3(
+      manager_.createSslClientContext(store_, allow_expired_client_config));
+  EXPECT_EQ(2, manager_.certStoreCache().size());
+
+  // A server context with the same validation context shares the store of the client contexts.
+  const std::string server_yaml = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/san_dns_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/san_dns_key.pem"
+    validation_context:
+      trusted_ca:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/ca_cert.pem"
+)EOF";
+  envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext server_tls_context;
+  TestUtility::loadFromYaml(TestEnvironment::substitute(server_yaml), server_tls_context);
+  ServerContextConfigImpl server_config(server_tls_context, factory_context_);
+  Envoy::Ssl::ServerContextSharedPtr server_context(
+      manager_.createSslServerContext(store_, server_config, {}));
+  EXPECT_EQ(2, manager_.certStoreCache().size());
+
+  // A different trusted CA, e.g. one delivered by SDS, gets a new trust store.
+  server_tls_context.mutable_common_tls_context()
+      ->mutable_validation_context()
+      ->mutable_trusted_ca()
+      ->set_filename(TestEnvironment::substitute(
+          "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/fake_ca_cert.pem"));
+  ServerContextConfigImpl updated_server_config(server_tls_context, factory_context_);
+  Envoy::Ssl::ServerContextSharedPtr updated_server_context(
+      manager_.createSslServerContext(store_, updated_server_config, {}));
+  EXPECT_EQ(3, manager_.certStoreCache().size());
+  EXPECT_NE(server_context->getCaCertInformation()->serial_number(),
+            updated_server_context->getCaCertInformation()->serial_number());
+
+  client_context1.reset();
+  server_context.reset();
+  EXPECT_EQ(3, manager_.certStoreCache().size());
+  client_context2.reset();
+  EXPECT_EQ(2, manager_.certStoreCache().size());
+  client_context3.reset();
+  updated_server_context.reset();
+  EXPECT_EQ(0, manager_.certStoreCache().size());
+}
+
 class SslServerContextImplTicketTest : public SslContextImplTest {
 public:
   void loadConfig(ServerContextConfigImpl& cfg) {
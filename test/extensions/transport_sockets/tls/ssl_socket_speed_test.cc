@@ -0,0 +1,165 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/transport_sockets/tls/v3/cert.pb.h"
+
+#include "common/buffer/buffer_impl.h"
+#include "common/network/listen_socket_impl.h"
+#include "common/stats/isolated_store_impl.h"
+#include "common/stream_info/stream_info_impl.h"
+
+#include "extensions/transport_sockets/tls/context_config_impl.h"
+#include "extensions/transport_sockets/tls/context_manager_impl.h"
+#include "extensions/transport_sockets/tls/ssl_socket.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/server/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/network_utility.h"
+#include "test/test_common/test_runtime.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+// A TLS client connection to a TLS server connection over loopback. Whatever the client writes is
+// read and discarded by the server.
+class SslSocketSpeedTest {
+public:
+  SslSocketSpeedTest()
+      : api_(Api::createApiForTest(store_)), dispatcher_(api_->allocateDispatcher("test_thread")),
+        stream_info_(api_->timeSource()), manager_(api_->timeSource()),
+        read_filter_(std::make_shared<NiceMock<Network::MockReadFilter>>()) {
+    ON_CALL(factory_context_, api()).WillByDefault(ReturnRef(*api_));
+
+    envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext server_tls_context;
+    TestUtility::loadFromYaml(TestEnvironment::substitute(R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/san_dns_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/san_dns_key.pem"
+)EOF"),
+                              server_tls_context);
+    server_factory_ = std::make_unique<ServerSslSocketFactory>(
+        std::make_unique<ServerContextConfigImpl>(server_tls_context, factory_context_), manager_,
+        store_, std::vector<std::string>{});
+    envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext client_tls_context;
+    client_factory_ = std::make_unique<ClientSslSocketFactory>(
+        std::make_unique<ClientContextConfigImpl>(client_tls_context, factory_context_), manager_,
+        store_);
+
+    socket_ = std::make_shared<Network::TcpListenSocket>(
+        Network::Test::getCanonicalLoopbackAddress(Network::Address::IpVersion::v4), nullptr,
+        true);
+    listener_ = dispatcher_->createListener(socket_, listener_callbacks_, true);
+    ON_CALL(listener_callbacks_, onAccept_(_))
+        .WillByDefault(Invoke([this](Network::ConnectionSocketPtr& socket) -> void {
+          server_connection_ = dispatcher_->createServerConnection(
+              std::move(socket), server_factory_->createTransportSocket(nullptr), stream_info_);
+          server_connection_->addReadFilter(read_filter_);
+        }));
+    ON_CALL(*read_filter_, onData(_, _))
+        .WillByDefault(Invoke([this](Buffer::Instance& data, bool) -> Network::FilterStatus {
+          bytes_received_ += data.length();
+          data.drain(data.length());
+          if (bytes_received_ == bytes_expected_) {
+            dispatcher_->exit();
+          }
+          return Network::FilterStatus::StopIteration;
+        }));
+
+    client_connection_ = dispatcher_->createClientConnection(
+        socket_->localAddress(), nullptr, client_factory_->createTransportSocket(nullptr), nullptr);
+    client_connection_->addConnectionCallbacks(client_callbacks_);
+    ON_CALL(client_callbacks_, onEvent(Network::ConnectionEvent::Connected))
+        .WillByDefault(Invoke([this](Network::ConnectionEvent) -> void { dispatcher_->exit(); }));
+    client_connection_->connect();
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+  }
+
+  ~SslSocketSpeedTest() {
+    client_connection_->close(Network::ConnectionCloseType::NoFlush);
+    if (server_connection_ != nullptr) {
+      server_connection_->close(Network::ConnectionCloseType::NoFlush);
+    }
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+
+  // Writes the data from the client and waits for the server to read all of it.
+  void transfer(Buffer::Instance& data) {
+    bytes_expected_ = bytes_received_ + data.length();
+    client_connection_->write(data, false);
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+  }
+
+private:
+  Stats::IsolatedStoreImpl store_;
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  StreamInfo::StreamInfoImpl stream_info_;
+  NiceMock<Server::Configuration::MockTransportSocketFactoryContext> factory_context_;
+  ContextManagerImpl manager_;
+  Network::TransportSocketFactoryPtr server_factory_;
+  Network::TransportSocketFactoryPtr client_factory_;
+  std::shared_ptr<Network::TcpListenSocket> socket_;
+  NiceMock<Network::MockListenerCallbacks> listener_callbacks_;
+  Network::ListenerPtr listener_;
+  std::shared_ptr<NiceMock<Network::MockReadFilter>> read_filter_;
+  NiceMock<Network::MockConnectionCallbacks> client_callbacks_;
+  Network::ClientConnectionPtr client_connection_;
+  Network::ConnectionPtr server_connection_;
+  uint64_t bytes_expected_{};
+  uint64_t bytes_received_{};
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
+
+// Send write buffers made of slices of the given size over TLS, with records encrypted straight out
+// of the first slice (1) or linearized (0). Slices that don't line up with the 16 KiB records make
+// linearize() copy most of the data, while writing out of the first slice sends more, shorter
+// records.
+static void sslSocketWriteSlices(benchmark::State& state) {
+  Envoy::TestScopedRuntime scoped_runtime;
+  Envoy::Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.tls_write_from_front_slice",
+        state.range(0) != 0 ? "true" : "false"}});
+  const std::string slice(state.range(1), 'a');
+  constexpr uint64_t Slices = 64;
+
+  Envoy::Extensions::TransportSockets::Tls::SslSocketSpeedTest speed_test;
+  for (auto _ : state) {
+    Envoy::Buffer::OwnedImpl data;
+    for (uint64_t i = 0; i < Slices; ++i) {
+      data.appendSliceForTest(slice);
+    }
+    speed_test.transfer(data);
+  }
+  state.SetBytesProcessed(state.iterations() * Slices * slice.size());
+}
+BENCHMARK(sslSocketWriteSlices)
+    ->Args({0, 1000})
+    ->Args({1, 1000})
+    ->Args({0, 5000})
+    ->Args({1, 5000})
+    ->Args({0, 20000})
+    ->Args({1, 20000})
+    ->Args({0, 16384})
+    ->Args({1, 16384})
+    ->Unit(benchmark::kMicrosecond);
@@ -40,6 +40,7 @@
 #include "test/test_common/environment.h"
 #include "test/test_common/network_utility.h"
 #include "test/test_common/registry.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "absl/strings/str_replace.h"
@@ -4419,6 +4420,74 @@ protected:
     disconnect();
   }
 
+  // Writes a buffer made of slices of the given sizes at once. Each SSL_write() of the client is
+  // drained from its write buffer, so the sizes of the drains are the sizes of the TLS records.
+  // @return std::vector<uint64_t> the amount of data the client wrote in each TLS record.
+  std::vector<uint64_t> recordSizesTest(const std::vector<uint64_t>& slice_sizes) {
+    MockWatermarkBuffer* client_write_buffer = nullptr;
+    MockBufferFactory* factory = new StrictMock<MockBufferFactory>;
+    dispatcher_ = api_->allocateDispatcher("test_thread", Buffer::WatermarkFactoryPtr{factory});
+
+    EXPECT_CALL(*factory, create_(_, _, _))
+        .Times(2)
+        .WillOnce(Invoke([&](std::function<void()> below_low, std::function<void()> above_high,
+                             std::function<void()> above_overflow) -> Buffer::Instance* {
+          client_write_buffer = new MockWatermarkBuffer(below_low, above_high, above_overflow);
+          return client_write_buffer;
+        }))
+        .WillRepeatedly(Invoke([](std::function<void()> below_low, std::function<void()> above_high,
+                                  std::function<void()> above_overflow) -> Buffer::Instance* {
+          return new Buffer::WatermarkBuffer(below_low, above_high, above_overflow);
+        }));
+
+    initialize();
+
+    EXPECT_CALL(client_callbacks_, onEvent(Network::ConnectionEvent::Connected))
+        .WillOnce(Invoke([&](Network::ConnectionEvent) -> void { dispatcher_->exit(); }));
+
+    EXPECT_CALL(listener_callbacks_, onAccept_(_))
+        .WillOnce(Invoke([&](Network::ConnectionSocketPtr& socket) -> void {
+          server_connection_ = dispatcher_->createServerConnection(
+              std::move(socket), server_ssl_socket_factory_->createTransportSocket(nullptr),
+              stream_info_);
+          server_connection_->addConnectionCallbacks(server_callbacks_);
+          server_connection_->addReadFilter(read_filter_);
+        }));
+
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+    EXPECT_CALL(*read_filter_, onNewConnection());
+    EXPECT_CALL(*read_filter_, onData(_, _)).Times(testing::AnyNumber());
+
+    Buffer::OwnedImpl buffer_to_write;
+    for (const uint64_t slice_size : slice_sizes) {
+      buffer_to_write.appendSliceForTest(std::string(slice_size, 'a'));
+    }
+    EXPECT_EQ(slice_sizes.size(), buffer_to_write.getRawSlices().size());
+    const uint64_t bytes_to_write = buffer_to_write.length();
+    // Shared with the mock, which may still drain the buffer when the connection is destroyed.
+    auto record_sizes = std::make_shared<std::vector<uint64_t>>();
+    auto bytes_written = std::make_shared<uint64_t>(0);
+    EXPECT_CALL(*client_write_buffer, drain(_))
+        .WillRepeatedly(Invoke([this, client_write_buffer, record_sizes, bytes_written,
+                                bytes_to_write](uint64_t size) -> void {
+          client_write_buffer->baseDrain(size);
+          if (size == 0 || *bytes_written == bytes_to_write) {
+            return;
+          }
+          record_sizes->push_back(size);
+          *bytes_written += size;
+          if (*bytes_written == bytes_to_write) {
+            dispatcher_->exit();
+          }
+        }));
+    client_connection_->write(buffer_to_write, false);
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+    disconnect();
+    return *record_sizes;
+  }
+
   void disconnect() {
     EXPECT_CALL(client_callbacks_, onEvent(Network::ConnectionEvent::LocalClose));
     EXPECT_CALL(server_callbacks_, onEvent(Network::ConnectionEvent::RemoteClose))
@@ -4484,6 +4553,40 @@ TEST_P(SslReadBufferLimitTest, NoLimitSmallWrites) {
   readBufferLimitTest(0, 256 * 1024, 1, 256 * 1024, false);
 }
 
+// Writes that don't line up with the TLS record size, so that records are written both straight
+// out of the first buffer slice and from linearized slices.
+TEST_P(SslReadBufferLimitTest, NoLimitUnalignedWrites) {
+  TestScopedRuntime scoped_runtime;
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.tls_write_from_front_slice", "true"}});
+  readBufferLimitTest(0, 256 * 1024, 20000, 13, false);
+}
+
+TEST_P(SslReadBufferLimitTest, NoLimitUnalignedWritesLinearized) {
+  readBufferLimitTest(0, 256 * 1024, 20000, 13, false);
+}
+
+// A front slice shorter than a record but large enough is written as a record of its own, rather
+// than being linearized with the start of the next slice.
+TEST_P(SslReadBufferLimitTest, ShortFrontSliceWrittenAsRecord) {
+  TestScopedRuntime scoped_runtime;
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.tls_write_from_front_slice", "true"}});
+  EXPECT_EQ((std::vector<uint64_t>{5000, 16384, 3616}), recordSizesTest({5000, 20000}));
+}
+
+TEST_P(SslReadBufferLimitTest, ShortFrontSliceLinearizedByDefault) {
+  EXPECT_EQ((std::vector<uint64_t>{16384, 8616}), recordSizesTest({5000, 20000}));
+}
+
+// Fragments too small for a record of their own are still linearized into a full record.
+TEST_P(SslReadBufferLimitTest, SmallFrontSliceLinearized) {
+  TestScopedRuntime scoped_runtime;
+  Runtime::LoaderSingleton::getExisting()->mergeValues(
+      {{"envoy.reloadable_features.tls_write_from_front_slice", "true"}});
+  EXPECT_EQ((std::vector<uint64_t>{16384, 4616}), recordSizesTest({1000, 20000}));
+}
+
 TEST_P(SslReadBufferLimitTest, SomeLimit) {
   readBufferLimitTest(32 * 1024, 32 * 1024, 256 * 1024, 1, false);
 }
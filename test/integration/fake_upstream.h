@@ -649,8 +649,11 @@ private:
       return socket_->localAddress();
     }
 
-    Network::SocketSharedPtr getListenSocket() override { return socket_; }
+    Network::SocketSharedPtr getListenSocket(absl::optional<uint32_t>) override {
+      return socket_;
+    }
     Network::SocketOptRef sharedSocket() const override { return *socket_; }
+    Network::SocketSharedPtr workerSocket(uint32_t) const override { return nullptr; }
 
   private:
     Network::SocketSharedPtr socket_;
@@ -17,6 +17,7 @@
 #include "envoy/network/transport_socket.h"
 #include "envoy/ssl/context.h"
 
+#include "common/buffer/memory_account_impl.h"
 #include "common/common/scope_tracker.h"
 
 #include "test/mocks/buffer/mocks.h"
@@ -117,6 +118,7 @@ public:
   MOCK_METHOD(const ScopeTrackedObject*, setTrackedObject, (const ScopeTrackedObject* object));
   MOCK_METHOD(bool, isThreadSafe, (), (const));
   Buffer::WatermarkFactory& getWatermarkFactory() override { return buffer_factory_; }
+  Buffer::BufferMemoryTracker& bufferMemoryTracker() override { return buffer_memory_tracker_; }
   MOCK_METHOD(Thread::ThreadId, getCurrentThreadId, ());
   MOCK_METHOD(MonotonicTime, approximateMonotonicTime, (), (const));
   MOCK_METHOD(void, updateApproximateMonotonicTime, ());
@@ -124,6 +126,7 @@ public:
   GlobalTimeSystem time_system_;
   std::list<DeferredDeletablePtr> to_delete_;
   MockBufferFactory buffer_factory_;
+  Buffer::BufferMemoryTrackerImpl buffer_memory_tracker_;
 
 private:
   const std::string name_;
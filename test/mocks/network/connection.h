@@ -80,6 +80,7 @@ public:
   MOCK_METHOD(uint32_t, bufferLimit, (), (const));
   MOCK_METHOD(bool, localAddressRestored, (), (const));
   MOCK_METHOD(bool, aboveHighWatermark, (), (const));
+  MOCK_METHOD(Buffer::BufferMemoryAccountSharedPtr, bufferMemoryAccount, (), (const));
   MOCK_METHOD(const Network::ConnectionSocket::OptionsSharedPtr&, socketOptions, (), (const));
   MOCK_METHOD(StreamInfo::StreamInfo&, streamInfo, ());
   MOCK_METHOD(const StreamInfo::StreamInfo&, streamInfo, (), (const));
@@ -126,6 +127,7 @@ public:
   MOCK_METHOD(uint32_t, bufferLimit, (), (const));
   MOCK_METHOD(bool, localAddressRestored, (), (const));
   MOCK_METHOD(bool, aboveHighWatermark, (), (const));
+  MOCK_METHOD(Buffer::BufferMemoryAccountSharedPtr, bufferMemoryAccount, (), (const));
   MOCK_METHOD(const Network::ConnectionSocket::OptionsSharedPtr&, socketOptions, (), (const));
   MOCK_METHOD(StreamInfo::StreamInfo&, streamInfo, ());
   MOCK_METHOD(const StreamInfo::StreamInfo&, streamInfo, (), (const));
@@ -175,6 +177,7 @@ public:
   MOCK_METHOD(uint32_t, bufferLimit, (), (const));
   MOCK_METHOD(bool, localAddressRestored, (), (const));
   MOCK_METHOD(bool, aboveHighWatermark, (), (const));
+  MOCK_METHOD(Buffer::BufferMemoryAccountSharedPtr, bufferMemoryAccount, (), (const));
   MOCK_METHOD(const Network::ConnectionSocket::OptionsSharedPtr&, socketOptions, (), (const));
   MOCK_METHOD(StreamInfo::StreamInfo&, streamInfo, ());
   MOCK_METHOD(const StreamInfo::StreamInfo&, streamInfo, (), (const));
@@ -318,8 +318,9 @@ public:
 
   MOCK_METHOD(Network::Socket::Type, socketType, (), (const));
   MOCK_METHOD(const Network::Address::InstanceConstSharedPtr&, localAddress, (), (const));
-  MOCK_METHOD(Network::SocketSharedPtr, getListenSocket, ());
+  MOCK_METHOD(Network::SocketSharedPtr, getListenSocket, (absl::optional<uint32_t>));
   MOCK_METHOD(SocketOptRef, sharedSocket, (), (const));
+  MOCK_METHOD(Network::SocketSharedPtr, workerSocket, (uint32_t), (const));
 };
 
 class MockListenerConfig : public ListenerConfig {
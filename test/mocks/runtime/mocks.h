@@ -41,6 +41,12 @@ public:
     }
   }
 
+  // The lookups of registered keys forward to the mocked lookups by name.
+  using Snapshot::featureEnabled;
+  using Snapshot::getBoolean;
+  using Snapshot::getDouble;
+  using Snapshot::getInteger;
+
   MOCK_METHOD(void, countDeprecatedFeatureUse, (), (const));
   MOCK_METHOD(bool, deprecatedFeatureEnabled, (absl::string_view key, bool default_enabled),
               (const));
@@ -229,7 +229,8 @@ public:
 
   // Server::HotRestart
   MOCK_METHOD(void, drainParentListeners, ());
-  MOCK_METHOD(int, duplicateParentListenSocket, (const std::string& address));
+  MOCK_METHOD(int, duplicateParentListenSocket,
+              (const std::string& address, absl::optional<uint32_t> worker_index));
   MOCK_METHOD(std::unique_ptr<envoy::HotRestartMessage>, getParentStats, ());
   MOCK_METHOD(void, initialize, (Event::Dispatcher & dispatcher, Server::Instance& server));
   MOCK_METHOD(void, sendParentAdminShutdownRequest, (time_t & original_start_time));
@@ -294,6 +295,8 @@ public:
   MOCK_METHOD(void, createLdsApi, (const envoy::config::core::v3::ConfigSource& lds_config));
   MOCK_METHOD(std::vector<std::reference_wrapper<Network::ListenerConfig>>, listeners, ());
   MOCK_METHOD(uint64_t, numConnections, (), (const));
+  MOCK_METHOD(std::vector<std::vector<Buffer::BufferMemoryAccountBalance>>,
+              largestBufferMemoryAccounts, (), (const));
   MOCK_METHOD(bool, removeListener, (const std::string& listener_name));
   MOCK_METHOD(void, startWorkers, (GuardDog & guard_dog));
   MOCK_METHOD(void, stopListeners, (StopListenersType listeners_type));
@@ -319,7 +322,7 @@ public:
   ~MockWorkerFactory() override;
 
   // Server::WorkerFactory
-  WorkerPtr createWorker(OverloadManager&, const std::string&) override {
+  WorkerPtr createWorker(uint32_t, OverloadManager&, const std::string&) override {
     return WorkerPtr{createWorker_()};
   }
 
@@ -354,6 +357,8 @@ public:
               (absl::optional<uint64_t> overridden_listener, Network::ListenerConfig& listener,
                AddListenerCompletion completion));
   MOCK_METHOD(uint64_t, numConnections, (), (const));
+  MOCK_METHOD(std::vector<Buffer::BufferMemoryAccountBalance>, largestBufferMemoryAccounts, (),
+              (const));
   MOCK_METHOD(void, removeListener,
               (Network::ListenerConfig & listener, std::function<void()> completion));
   MOCK_METHOD(void, start, (GuardDog & guard_dog));
@@ -1,5 +1,7 @@
 #include "envoy/admin/v3/memory.pb.h"
 
+#include "common/common/regex.h"
+
 #include "extensions/transport_sockets/tls/context_config_impl.h"
 
 #include "test/server/admin/admin_instance.h"
@@ -46,6 +48,62 @@ TEST_P(AdminInstanceTest, ContextThatReturnsNullCertDetails) {
   EXPECT_EQ(expected_empty_json, response.toString());
 }
 
+TEST_P(AdminInstanceTest, Regexes) {
+  envoy::type::matcher::v3::RegexMatcher matcher;
+  matcher.mutable_google_re2();
+  matcher.set_regex("/admin_instance_test/[0-9]+");
+  const auto compiled_matcher1 = Regex::Utility::parseRegex(matcher);
+  const auto compiled_matcher2 = Regex::Utility::parseRegex(matcher);
+
+  Http::TestResponseHeaderMapImpl header_map;
+  Buffer::OwnedImpl response;
+  EXPECT_EQ(Http::Code::OK, getCallback("/regexes", header_map, response));
+  EXPECT_EQ("application/json", header_map.getContentTypeValue());
+
+  ProtobufWkt::Struct output;
+  TestUtility::loadFromJson(response.toString(), output);
+  bool found = false;
+  for (const auto& regex : output.fields().at("regexes").list_value().values()) {
+    const auto& fields = regex.struct_value().fields();
+    if (fields.at("regex").string_value() == "/admin_instance_test/[0-9]+") {
+      found = true;
+      EXPECT_GT(fields.at("program_size").number_value(), 0);
+      EXPECT_EQ(2, fields.at("references").number_value());
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
+TEST_P(AdminInstanceTest, BufferMemory) {
+  std::vector<std::vector<Buffer::BufferMemoryAccountBalance>> accounts(2);
+  accounts[1].push_back({"connection 1", 300, {{"stream 2", 200, {}}}});
+  EXPECT_CALL(server_.listener_manager_, largestBufferMemoryAccounts()).WillOnce(Return(accounts));
+
+  Http::TestResponseHeaderMapImpl header_map;
+  Buffer::OwnedImpl response;
+  EXPECT_EQ(Http::Code::OK, getCallback("/buffer_memory", header_map, response));
+  EXPECT_EQ("application/json", header_map.getContentTypeValue());
+
+  ProtobufWkt::Struct output;
+  TestUtility::loadFromJson(response.toString(), output);
+  const auto& workers = output.fields().at("workers").list_value().values();
+  ASSERT_EQ(2, workers.size());
+  EXPECT_EQ("worker_0", workers[0].struct_value().fields().at("worker").string_value());
+  EXPECT_EQ(0, workers[0].struct_value().fields().at("accounts").list_value().values_size());
+  EXPECT_EQ("worker_1", workers[1].struct_value().fields().at("worker").string_value());
+  const auto& worker_accounts = workers[1].struct_value().fields().at("accounts").list_value();
+  ASSERT_EQ(1, worker_accounts.values_size());
+  const auto& connection = worker_accounts.values(0).struct_value().fields();
+  EXPECT_EQ("connection 1", connection.at("description").string_value());
+  EXPECT_EQ(300, connection.at("buffered_bytes").number_value());
+  const auto& children = connection.at("children").list_value();
+  ASSERT_EQ(1, children.values_size());
+  const auto& stream = children.values(0).struct_value().fields();
+  EXPECT_EQ("stream 2", stream.at("description").string_value());
+  EXPECT_EQ(200, stream.at("buffered_bytes").number_value());
+  EXPECT_EQ(0, stream.count("children"));
+}
+
 TEST_P(AdminInstanceTest, Memory) {
   Http::TestResponseHeaderMapImpl header_map;
   Buffer::OwnedImpl response;
@@ -39,7 +39,7 @@ class ConnectionHandlerTest : public testing::Test, protected Logger::Loggable<L
 public:
   ConnectionHandlerTest()
       : socket_factory_(std::make_shared<Network::MockListenSocketFactory>()),
-        handler_(new ConnectionHandlerImpl(dispatcher_)),
+        handler_(new ConnectionHandlerImpl(dispatcher_, 0)),
         filter_chain_(Network::Test::createEmptyFilterChainWithRawBufferSockets()),
         listener_filter_matcher_(std::make_shared<NiceMock<Network::MockListenerFilterMatcher>>()) {
     ON_CALL(*listener_filter_matcher_, matches(_)).WillByDefault(Return(false));
@@ -140,7 +140,7 @@ public:
       // If so, dispatcher would not create new network listener.
       return listeners_.back().get();
     }
-    EXPECT_CALL(*socket_factory_, getListenSocket()).WillOnce(Return(listeners_.back()->socket_));
+    EXPECT_CALL(*socket_factory_, getListenSocket(_)).WillOnce(Return(listeners_.back()->socket_));
     if (socket_type == Network::Socket::Type::Stream) {
       EXPECT_CALL(dispatcher_, createListener_(_, _, _))
           .WillOnce(Invoke([listener, listener_callbacks](Network::SocketSharedPtr&&,
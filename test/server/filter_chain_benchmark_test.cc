@@ -229,6 +229,82 @@ BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainFindTest)
     }
   }
 }
+// Update the filter chains of a listener by adding one filter chain, as the in place filter chain
+// update of a listener does. The existing filter chains are reused rather than built again.
+BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainManagerUpdateTest)
+(::benchmark::State& state) {
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  const auto address = std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234);
+  FilterChainManagerImpl origin_filter_chain_manager{address, factory_context, init_manager_};
+  origin_filter_chain_manager.addFilterChain(filter_chains_, dummy_builder_,
+                                             origin_filter_chain_manager);
+
+  envoy::config::listener::v3::Listener updated_listener_config = listener_config_;
+  auto* added_filter_chain = updated_listener_config.add_filter_chains();
+  *added_filter_chain = listener_config_.filter_chains(listener_config_.filter_chains_size() - 1);
+  added_filter_chain->mutable_filter_chain_match()->mutable_destination_port()->set_value(9999);
+  absl::Span<const envoy::config::listener::v3::FilterChain* const> updated_filter_chains =
+      updated_listener_config.filter_chains();
+  for (auto _ : state) {
+    FilterChainManagerImpl filter_chain_manager{address, factory_context, init_manager_,
+                                                origin_filter_chain_manager};
+    filter_chain_manager.addFilterChain(updated_filter_chains, dummy_builder_,
+                                        filter_chain_manager);
+  }
+}
+
+// Find the filter chains of a listener with one filter chain per tenant, matching the exact and
+// the wildcard server names of the tenant, as with SNI-based virtual hosting. A third of the
+// connections are for an exact server name, a third for a wildcard one, and a third fall through
+// to the catch-all filter chain.
+static void FilterChainFindServerNameTest(::benchmark::State& state) {
+  const int64_t num_tenants = state.range(0);
+  envoy::config::listener::v3::Listener listener_config;
+  for (int64_t i = 0; i < num_tenants; i++) {
+    auto* filter_chain_match = listener_config.add_filter_chains()->mutable_filter_chain_match();
+    filter_chain_match->add_server_names(absl::StrCat("tenant", i, ".example.com"));
+    filter_chain_match->add_server_names(absl::StrCat("*.tenant", i, ".example.com"));
+    filter_chain_match->set_transport_protocol("tls");
+  }
+  listener_config.add_filter_chains();
+  absl::Span<const envoy::config::listener::v3::FilterChain* const> filter_chains =
+      listener_config.filter_chains();
+
+  std::vector<MockConnectionSocket> sockets;
+  const int num_sockets = 1024;
+  sockets.reserve(num_sockets);
+  for (int i = 0; i < num_sockets; i++) {
+    const int64_t tenant = (i * 7919) % num_tenants;
+    std::string server_name;
+    switch (i % 3) {
+    case 0:
+      server_name = absl::StrCat("tenant", tenant, ".example.com");
+      break;
+    case 1:
+      server_name = absl::StrCat("www.api.tenant", tenant, ".example.com");
+      break;
+    default:
+      server_name = absl::StrCat("tenant", tenant, ".example.org");
+      break;
+    }
+    sockets.push_back(std::move(*MockConnectionSocket::createMockConnectionSocket(
+        1234, "127.0.0.1", server_name, "tls", {"h2", "http/1.1"}, "8.8.8.8", 111)));
+  }
+
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  Init::ManagerImpl init_manager{"fcm_benchmark"};
+  MockFilterChainFactoryBuilder dummy_builder;
+  FilterChainManagerImpl filter_chain_manager{
+      std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234), factory_context,
+      init_manager};
+  filter_chain_manager.addFilterChain(filter_chains, dummy_builder, filter_chain_manager);
+  for (auto _ : state) {
+    for (const auto& socket : sockets) {
+      benchmark::DoNotOptimize(filter_chain_manager.findFilterChain(socket));
+    }
+  }
+}
+
 BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainManagerBuildTest)
     ->Ranges({
         // scale of the chains
@@ -239,6 +315,12 @@ BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainFindTest)
         // scale of the chains
         {1, 4096},
     });
+BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainManagerUpdateTest)
+    ->Ranges({
+        // scale of the chains
+        {1, 4096},
+    });
+BENCHMARK(FilterChainFindServerNameTest)->Arg(1)->Arg(100)->Arg(10000);
 
 /*
 clang-format off
@@ -3,6 +3,7 @@
 #include "server/hot_restarting_child.h"
 #include "server/hot_restarting_parent.h"
 
+#include "test/mocks/network/io_handle.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/server/mocks.h"
 
@@ -61,6 +62,41 @@ TEST_F(HotRestartingParentTest, GetListenSocketsForChildNotBindPort) {
   EXPECT_EQ(-1, message.reply().pass_listen_socket().fd());
 }
 
+// The socket of a worker of a steered SO_REUSEPORT group is passed by worker index.
+TEST_F(HotRestartingParentTest, GetListenSocketsForChildWorkerSocket) {
+  MockListenerManager listener_manager;
+  Network::MockListenerConfig listener_config;
+  std::vector<std::reference_wrapper<Network::ListenerConfig>> listeners;
+  listeners.push_back(std::ref(*static_cast<Network::ListenerConfig*>(&listener_config)));
+  EXPECT_CALL(server_, listenerManager()).WillRepeatedly(ReturnRef(listener_manager));
+  EXPECT_CALL(listener_manager, listeners()).WillRepeatedly(Return(listeners));
+  EXPECT_CALL(listener_config, bindToPort()).WillRepeatedly(Return(true));
+
+  auto worker_socket = std::make_shared<NiceMock<Network::MockListenSocket>>();
+  NiceMock<Network::MockIoHandle> io_handle;
+  ON_CALL(*worker_socket, ioHandle()).WillByDefault(ReturnRef(io_handle));
+  ON_CALL(io_handle, fd()).WillByDefault(Return(42));
+  EXPECT_CALL(listener_config.socket_factory_, workerSocket(1)).WillOnce(Return(worker_socket));
+  EXPECT_CALL(listener_config.socket_factory_, workerSocket(3)).WillOnce(Return(nullptr));
+  EXPECT_CALL(listener_config.socket_factory_, sharedSocket()).Times(0);
+
+  HotRestartMessage::Request request;
+  request.mutable_pass_listen_socket()->set_address("tcp://0.0.0.0:80");
+  request.mutable_pass_listen_socket()->set_worker_socket(true);
+  request.mutable_pass_listen_socket()->set_worker_index(1);
+  EXPECT_EQ(42, hot_restarting_parent_.getListenSocketsForChild(request)
+                    .reply()
+                    .pass_listen_socket()
+                    .fd());
+
+  // The parent has fewer workers.
+  request.mutable_pass_listen_socket()->set_worker_index(3);
+  EXPECT_EQ(-1, hot_restarting_parent_.getListenSocketsForChild(request)
+                    .reply()
+                    .pass_listen_socket()
+                    .fd());
+}
+
 TEST_F(HotRestartingParentTest, ExportStatsToChild) {
   Stats::TestUtil::TestStore store;
   MockListenerManager listener_manager;
@@ -74,7 +74,7 @@ udp_listener_config:
   manager_->addOrUpdateListener(listener_proto, "", true);
   EXPECT_EQ(1u, manager_->listeners().size());
   EXPECT_FALSE(manager_->listeners()[0].get().udpListenerFactory()->isTransportConnectionless());
-  manager_->listeners().front().get().listenSocketFactory().getListenSocket();
+  manager_->listeners().front().get().listenSocketFactory().getListenSocket(0);
 
   // No filter chain found with non-matching transport protocol.
   EXPECT_EQ(nullptr, findFilterChain(1234, "127.0.0.1", "", "tls", {}, "8.8.8.8", 111));
@@ -3712,6 +3712,84 @@ TEST_F(ListenerManagerImplWithRealFiltersTest, ReusePortListenerEnabledForTcp) {
                    /* expected_creation_params */ {true, false});
 }
 
+// Validate that CPU reuse port steering adds the BPF program option when there is more than one
+// worker sharing the SO_REUSEPORT group, and that the sockets are created up front in worker order
+// so that the index of each socket in the group is the index of its worker.
+TEST_F(ListenerManagerImplWithRealFiltersTest, ReusePortCpuSteering) {
+  auto listener = createIPv4Listener("ReusePortListener");
+  listener.set_reuse_port(true);
+  listener.set_reuse_port_steering(envoy::config::listener::v3::Listener::CPU);
+  listener.mutable_address()->mutable_socket_address()->set_port_value(0);
+  server_.options_.concurrency_ = 3;
+
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  std::vector<std::shared_ptr<NiceMock<Network::MockListenSocket>>> sockets;
+  EXPECT_CALL(listener_factory_, createListenSocket(_, _, _, _))
+      .Times(4)
+      .WillRepeatedly(Invoke([&sockets](const Network::Address::InstanceConstSharedPtr&,
+                                        Network::Socket::Type,
+                                        const Network::Socket::OptionsSharedPtr& options,
+                                        const ListenSocketCreationParams& params) {
+        // SO_REUSEPORT and the steering program.
+        EXPECT_EQ(2U, options->size());
+        EXPECT_TRUE(params.bind_to_port);
+        EXPECT_FALSE(params.duplicate_parent_socket);
+        // Worker sockets are duplicated from the hot restart parent's socket of the same worker.
+        if (sockets.size() < 3) {
+          EXPECT_EQ(absl::make_optional<uint32_t>(sockets.size()), params.worker_index);
+        } else {
+          EXPECT_EQ(absl::nullopt, params.worker_index);
+        }
+        sockets.push_back(std::make_shared<NiceMock<Network::MockListenSocket>>());
+        return sockets.back();
+      }));
+  manager_->addOrUpdateListener(listener, "", true);
+  EXPECT_EQ(1U, manager_->listeners().size());
+  ASSERT_EQ(3U, sockets.size());
+
+  // Each worker gets the socket created at its own index, whatever order the workers ask in.
+  Network::ListenSocketFactory& factory = manager_->listeners().front().get().listenSocketFactory();
+  EXPECT_EQ(sockets[2], factory.workerSocket(2));
+  EXPECT_EQ(sockets[2], factory.getListenSocket(2));
+  EXPECT_EQ(sockets[0], factory.getListenSocket(0));
+  EXPECT_EQ(sockets[1], factory.getListenSocket(1));
+
+  // A worker asking again, e.g. after a listener update, shares the socket it is still using.
+  EXPECT_EQ(sockets[1], factory.getListenSocket(1));
+  // Taken sockets can still be passed to a hot restarted process.
+  EXPECT_EQ(sockets[0], factory.workerSocket(0));
+  EXPECT_EQ(nullptr, factory.workerSocket(3));
+
+  // A listener not owned by a worker gets a socket of its own.
+  const Network::SocketSharedPtr socket = factory.getListenSocket(absl::nullopt);
+  ASSERT_EQ(4U, sockets.size());
+  EXPECT_EQ(sockets[3], socket);
+#else
+  EXPECT_THROW_WITH_MESSAGE(
+      manager_->addOrUpdateListener(listener, "", true), EnvoyException,
+      "error adding listener '127.0.0.1:0': CPU reuse port steering is not supported on this "
+      "platform");
+#endif
+}
+
+// Steering is not needed with a single worker.
+TEST_F(ListenerManagerImplWithRealFiltersTest, ReusePortCpuSteeringSingleWorker) {
+  auto listener = createIPv4Listener("ReusePortListener");
+  listener.set_reuse_port(true);
+  listener.set_reuse_port_steering(envoy::config::listener::v3::Listener::CPU);
+  listener.mutable_address()->mutable_socket_address()->set_port_value(0);
+  server_.options_.concurrency_ = 1;
+
+  expectCreateListenSocket(envoy::config::core::v3::SocketOption::STATE_PREBIND,
+                           /* expected_num_options */ 1,
+                           /* expected_creation_params */ {true, false});
+  expectSetsockopt(/* expected_sockopt_level */ ENVOY_SOCKET_SO_REUSEPORT.level(),
+                   /* expected_sockopt_name */ ENVOY_SOCKET_SO_REUSEPORT.option(),
+                   /* expected_value */ 1);
+  manager_->addOrUpdateListener(listener, "", true);
+  EXPECT_EQ(1U, manager_->listeners().size());
+}
+
 TEST_F(ListenerManagerImplWithRealFiltersTest, ReusePortListenerDisabled) {
 
   auto listener = createIPv4Listener("UdpListener");
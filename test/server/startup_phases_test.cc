@@ -0,0 +1,67 @@
+#include "server/startup_phases.h"
+
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Server {
+namespace {
+
+class StartupPhasesTest : public testing::Test, public Event::TestUsingSimulatedTime {
+public:
+  StartupPhases phases_{simTime()};
+};
+
+TEST_F(StartupPhasesTest, OverlappingPhases) {
+  simTime().advanceTimeAsync(std::chrono::milliseconds(5));
+  phases_.begin("outer");
+  simTime().advanceTimeAsync(std::chrono::milliseconds(10));
+  phases_.begin("inner");
+  simTime().advanceTimeAsync(std::chrono::milliseconds(20));
+  phases_.complete("outer");
+  simTime().advanceTimeAsync(std::chrono::milliseconds(40));
+  phases_.complete("inner");
+
+  ASSERT_EQ(2, phases_.phases().size());
+  EXPECT_EQ("outer", phases_.phases()[0].name_);
+  EXPECT_EQ(std::chrono::milliseconds(5), phases_.phases()[0].start_);
+  EXPECT_EQ(std::chrono::milliseconds(30), phases_.phases()[0].duration_);
+  EXPECT_EQ("inner", phases_.phases()[1].name_);
+  EXPECT_EQ(std::chrono::milliseconds(15), phases_.phases()[1].start_);
+  EXPECT_EQ(std::chrono::milliseconds(60), phases_.phases()[1].duration_);
+}
+
+// Phases are neither restarted nor completed twice, and unknown phases are ignored.
+TEST_F(StartupPhasesTest, RepeatedCalls) {
+  phases_.begin("phase");
+  simTime().advanceTimeAsync(std::chrono::milliseconds(10));
+  phases_.begin("phase");
+  phases_.complete("phase");
+  simTime().advanceTimeAsync(std::chrono::milliseconds(10));
+  phases_.complete("phase");
+  phases_.complete("unknown");
+
+  ASSERT_EQ(1, phases_.phases().size());
+  EXPECT_EQ(std::chrono::milliseconds(0), phases_.phases()[0].start_);
+  EXPECT_EQ(std::chrono::milliseconds(10), phases_.phases()[0].duration_);
+}
+
+TEST_F(StartupPhasesTest, Json) {
+  phases_.begin("done");
+  simTime().advanceTimeAsync(std::chrono::milliseconds(7));
+  phases_.complete("done");
+  phases_.begin("in_progress");
+
+  EXPECT_TRUE(TestUtility::jsonStringEqual(phases_.toJson(), R"EOF({
+    "phases": [
+      {"name": "done", "start_ms": 0, "duration_ms": 7},
+      {"name": "in_progress", "start_ms": 7}
+    ]
+  })EOF"));
+}
+
+} // namespace
+} // namespace Server
+} // namespace Envoy
@@ -1,5 +1,6 @@
 #include "common/api/api_impl.h"
 #include "common/event/dispatcher_impl.h"
+#include "common/stats/isolated_store_impl.h"
 
 #include "server/worker_impl.h"
 
@@ -156,6 +157,28 @@ TEST_F(WorkerImplTest, ListenerException) {
   worker_.stop();
 }
 
+// The memory held by the buffers of a worker is published with its dispatcher stats.
+TEST_F(WorkerImplTest, BufferMemoryStats) {
+  Stats::IsolatedStoreImpl store;
+  worker_.start(guard_dog_);
+  worker_.initializeStats(store);
+
+  // This is posted after the stats are initialized on the worker thread.
+  ConditionalInitializer ci;
+  NiceMock<Network::MockListenerConfig> listener;
+  EXPECT_CALL(*handler_, stopListeners(_));
+  worker_.stopListener(listener, [&ci]() -> void { ci.setReady(); });
+  ci.waitReady();
+
+  EXPECT_EQ(0, TestUtility::findGauge(store, "worker_test.buffer_memory.buffered_bytes")->value());
+  EXPECT_EQ(
+      0,
+      TestUtility::findGauge(store, "worker_test.buffer_memory.largest_account_buffered_bytes")
+          ->value());
+  EXPECT_TRUE(worker_.largestBufferMemoryAccounts().empty());
+  worker_.stop();
+}
+
 } // namespace
 } // namespace Server
 } // namespace Envoy